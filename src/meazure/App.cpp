@@ -29,6 +29,7 @@
 #include "ui/ScreenMgr.h"
 #include "CommandLineInfo.h"
 #include "Hooks/Hooks.h"
+#include "utilities/Timer.h"
 #include <cstddef>
 
 
@@ -145,6 +146,12 @@ BOOL App::InitInstance() {
     return TRUE;
 }
 
+int App::ExitInstance() {
+    MeaTimer::Shutdown();
+
+    return CWinApp::ExitInstance();
+}
+
 void App::OnMouseHook(WPARAM wParam, LPARAM lParam) {
     static_cast<AppFrame*>(m_pMainWnd)->GetView()->OnMouseHook(wParam, lParam);
 }
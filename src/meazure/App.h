@@ -60,6 +60,13 @@ public:
     /// 
     virtual BOOL InitInstance() override;
 
+    /// Performs cleanup when the application exits. Stops the high
+    /// priority timer service before the application's static objects
+    /// are destroyed.
+    /// @return Application exit code.
+    /// 
+    virtual int ExitInstance() override;
+
     /// Displays the application About dialog.
     /// 
     afx_msg void OnAppAbout();
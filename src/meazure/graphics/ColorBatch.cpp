@@ -0,0 +1,391 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "ColorBatch.h"
+#include "Colors.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+ /// SSE2 instructions are available for the batch conversions.
+#define MEA_COLORBATCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Remove Windows defines so std versions can be used.
+#undef min
+#undef max
+
+
+namespace {
+
+    /// Coefficients of a linear conversion of the red, green and blue components into a three component color
+    /// model. Component n is rgb[n][0] * red + rgb[n][1] * green + rgb[n][2] * blue + offset[n].
+    ///
+    struct LinearModel {
+        float rgb[3][3];
+        float offset[3];
+    };
+
+    /// ITU-R BT.601 coefficients used by MeaColors::RGBtoYCbCr.
+    constexpr LinearModel kYCbCr {
+        { {  0.257f,  0.504f,  0.098f },
+          { -0.148f, -0.291f,  0.439f },
+          {  0.439f, -0.368f, -0.071f } },
+        { 16.0f, 128.0f, 128.0f }
+    };
+
+    /// NTSC 1953 coefficients used by MeaColors::RGBtoYIQ.
+    constexpr LinearModel kYIQ {
+        { { 0.299f,  0.587f,  0.114f },
+          { 0.596f, -0.275f, -0.321f },
+          { 0.212f, -0.523f,  0.311f } },
+        { 0.0f, 0.0f, 0.0f }
+    };
+
+    /// sRGB to XYZ coefficients used by MeaColors::RGBtoXYZ. Applied to the linearized components.
+    constexpr LinearModel kXYZ {
+        { { 0.4124564f, 0.3575761f, 0.1804375f },
+          { 0.2126729f, 0.7151522f, 0.0721750f },
+          { 0.0193339f, 0.1191920f, 0.9503041f } },
+        { 0.0f, 0.0f, 0.0f }
+    };
+
+    /// MeaColors::kLinearComponents in single precision.
+    ///
+    struct LinearComponents {
+        float values[256];
+
+        constexpr LinearComponents() : values() {
+            for (int i = 0; i < 256; i++) {
+                values[i] = static_cast<float>(MeaColors::kLinearComponents.values[i]);
+            }
+        }
+    };
+
+    constexpr LinearComponents kLinear;
+
+    // 1931 D65 2 degree illuminant reference and the L*a*b* function constants used by MeaColors::XYZtoLab.
+    constexpr float kXRef = 95.047f;
+    constexpr float kYRef = 100.000f;
+    constexpr float kZRef = 108.883f;
+    constexpr float kLabThreshold = 0.008856f;
+    constexpr float kLabSlope = 903.3f / 116.0f;
+    constexpr float kLabOffset = 16.0f / 116.0f;
+
+    float Red(uint32_t pixel) { return static_cast<float>((pixel >> 16) & 0xFF); }
+    float Green(uint32_t pixel) { return static_cast<float>((pixel >> 8) & 0xFF); }
+    float Blue(uint32_t pixel) { return static_cast<float>(pixel & 0xFF); }
+
+    float LabFunc(float value) {
+        return (value > kLabThreshold) ? std::cbrt(value) : kLabSlope * value + kLabOffset;
+    }
+
+    /// Scalar linear conversion of a range of pixels.
+    ///
+    void LinearScalar(const LinearModel& model, const uint32_t* pixels, size_t start, size_t count,
+                      float* out0, float* out1, float* out2) {
+        float* outs[3] = { out0, out1, out2 };
+        for (size_t i = start; i < count; i++) {
+            float r = Red(pixels[i]);
+            float g = Green(pixels[i]);
+            float b = Blue(pixels[i]);
+            for (int n = 0; n < 3; n++) {
+                outs[n][i] = model.rgb[n][0] * r + model.rgb[n][1] * g + model.rgb[n][2] * b + model.offset[n];
+            }
+        }
+    }
+
+    /// Scalar XYZ conversion of a range of pixels.
+    ///
+    void XYZScalar(const uint32_t* pixels, size_t start, size_t count, float* x, float* y, float* z) {
+        float* outs[3] = { x, y, z };
+        for (size_t i = start; i < count; i++) {
+            float r = kLinear.values[(pixels[i] >> 16) & 0xFF];
+            float g = kLinear.values[(pixels[i] >> 8) & 0xFF];
+            float b = kLinear.values[pixels[i] & 0xFF];
+            for (int n = 0; n < 3; n++) {
+                outs[n][i] = kXYZ.rgb[n][0] * r + kXYZ.rgb[n][1] * g + kXYZ.rgb[n][2] * b;
+            }
+        }
+    }
+
+#ifdef MEA_COLORBATCH_SSE2
+
+    /// Red, green and blue components of four pixels.
+    struct Components {
+        __m128 r;
+        __m128 g;
+        __m128 b;
+    };
+
+    /// Loads four pixels and separates their components.
+    ///
+    Components LoadComponents(const uint32_t* pixels) {
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        return {
+            _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(p, 16), mask)),
+            _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(p, 8), mask)),
+            _mm_cvtepi32_ps(_mm_and_si128(p, mask))
+        };
+    }
+
+    /// Loads the linearized components of four pixels. There is no SSE2 gather so the table lookups are scalar.
+    ///
+    Components LoadLinearComponents(const uint32_t* pixels) {
+        auto lookup = [pixels](int shift) {
+            return _mm_set_ps(kLinear.values[(pixels[3] >> shift) & 0xFF], kLinear.values[(pixels[2] >> shift) & 0xFF],
+                              kLinear.values[(pixels[1] >> shift) & 0xFF], kLinear.values[(pixels[0] >> shift) & 0xFF]);
+        };
+        return { lookup(16), lookup(8), lookup(0) };
+    }
+
+    /// Selects a where the mask is set and b elsewhere.
+    ///
+    __m128 Select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    /// Applies a linear model to four pixels.
+    ///
+    void ApplyLinear(const LinearModel& model, const Components& c, __m128 out[3]) {
+        for (int n = 0; n < 3; n++) {
+            __m128 value = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(model.rgb[n][0]), c.r),
+                                      _mm_mul_ps(_mm_set1_ps(model.rgb[n][1]), c.g));
+            value = _mm_add_ps(value, _mm_mul_ps(_mm_set1_ps(model.rgb[n][2]), c.b));
+            out[n] = _mm_add_ps(value, _mm_set1_ps(model.offset[n]));
+        }
+    }
+
+    /// Cube root of four non-negative values. The initial estimate divides the exponent by three by treating the
+    /// bits of the float as an integer. Three iterations of Newton's method then bring it to float precision.
+    ///
+    __m128 Cbrt(__m128 value) {
+        const __m128 third = _mm_set1_ps(1.0f / 3.0f);
+        const __m128i magic = _mm_set1_epi32(0x2A5137A0);
+        __m128 bits = _mm_cvtepi32_ps(_mm_castps_si128(value));
+        __m128 root = _mm_castsi128_ps(_mm_add_epi32(_mm_cvttps_epi32(_mm_mul_ps(bits, third)), magic));
+
+        for (int i = 0; i < 3; i++) {
+            __m128 square = _mm_mul_ps(root, root);
+            root = _mm_sub_ps(root, _mm_mul_ps(third, _mm_div_ps(_mm_sub_ps(_mm_mul_ps(square, root), value), square)));
+        }
+        return root;
+    }
+
+    /// L*a*b* function applied to four normalized XYZ components.
+    ///
+    __m128 LabFunc(__m128 value) {
+        __m128 linear = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kLabSlope), value), _mm_set1_ps(kLabOffset));
+        return Select(_mm_cmpgt_ps(value, _mm_set1_ps(kLabThreshold)), Cbrt(value), linear);
+    }
+
+#endif
+}
+
+
+void MeaColorBatch::ToHSL(const uint32_t* pixels, size_t count, float* hue, float* saturation, float* lightness) {
+    size_t i = 0;
+
+#ifdef MEA_COLORBATCH_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        Components c = LoadComponents(pixels + i);
+        __m128 cmax = _mm_max_ps(_mm_max_ps(c.r, c.g), c.b);
+        __m128 cmin = _mm_min_ps(_mm_min_ps(c.r, c.g), c.b);
+        __m128 sum = _mm_add_ps(cmax, cmin);
+        __m128 gray = _mm_cmpeq_ps(cmax, cmin);
+        __m128 delta = Select(gray, one, _mm_sub_ps(cmax, cmin));
+
+        // Components are in [0, 255] rather than [0, 1], so 2 - cmax - cmin becomes 510 - sum. Gray pixels, which
+        // include black and white, are given a delta of one to avoid dividing by zero and are zeroed below.
+        __m128 denom = Select(_mm_cmplt_ps(sum, _mm_set1_ps(255.0f)), sum, _mm_sub_ps(_mm_set1_ps(510.0f), sum));
+        __m128 s = _mm_div_ps(delta, Select(gray, one, denom));
+
+        __m128 redMax = _mm_cmpeq_ps(c.r, cmax);
+        __m128 greenMax = _mm_andnot_ps(redMax, _mm_cmpeq_ps(c.g, cmax));
+        __m128 h = Select(redMax, _mm_sub_ps(c.g, c.b),
+                          Select(greenMax, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.0f), delta), _mm_sub_ps(c.b, c.r)),
+                                 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(4.0f), delta), _mm_sub_ps(c.r, c.g))));
+        h = _mm_div_ps(h, _mm_mul_ps(_mm_set1_ps(6.0f), delta));
+        h = _mm_add_ps(h, _mm_and_ps(_mm_cmplt_ps(h, zero), one));
+
+        _mm_storeu_ps(hue + i, _mm_andnot_ps(gray, _mm_mul_ps(h, _mm_set1_ps(360.0f))));
+        _mm_storeu_ps(saturation + i, _mm_andnot_ps(gray, _mm_mul_ps(s, _mm_set1_ps(100.0f))));
+        _mm_storeu_ps(lightness + i, _mm_mul_ps(sum, _mm_set1_ps(100.0f / 510.0f)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        float r = Red(pixels[i]);
+        float g = Green(pixels[i]);
+        float b = Blue(pixels[i]);
+        float cmax = std::max({ r, g, b });
+        float cmin = std::min({ r, g, b });
+        float delta = cmax - cmin;
+        float sum = cmax + cmin;
+
+        lightness[i] = sum * (100.0f / 510.0f);
+        if (delta == 0.0f) {
+            hue[i] = 0.0f;
+            saturation[i] = 0.0f;
+        } else {
+            saturation[i] = 100.0f * delta / ((sum < 255.0f) ? sum : 510.0f - sum);
+
+            float h;
+            if (r == cmax) {
+                h = (g - b) / delta;
+            } else if (g == cmax) {
+                h = 2.0f + (b - r) / delta;
+            } else {
+                h = 4.0f + (r - g) / delta;
+            }
+            h /= 6.0f;
+            if (h < 0.0f) {
+                h += 1.0f;
+            }
+            hue[i] = 360.0f * h;
+        }
+    }
+}
+
+void MeaColorBatch::ToCMYK(const uint32_t* pixels, size_t count, float* cyan, float* magenta, float* yellow,
+                           float* black) {
+    size_t i = 0;
+
+#ifdef MEA_COLORBATCH_SSE2
+    const __m128 full = _mm_set1_ps(255.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        Components rgb = LoadComponents(pixels + i);
+        __m128 c = _mm_sub_ps(full, rgb.r);
+        __m128 m = _mm_sub_ps(full, rgb.g);
+        __m128 y = _mm_sub_ps(full, rgb.b);
+        __m128 k = _mm_min_ps(_mm_min_ps(c, m), y);
+
+        // For black pixels, c - k, m - k and y - k are zero, so any non-zero denominator produces the required zeros.
+        __m128 denom = _mm_sub_ps(full, k);
+        __m128 scale = _mm_div_ps(full, Select(_mm_cmpeq_ps(k, full), full, denom));
+
+        _mm_storeu_ps(cyan + i, _mm_mul_ps(_mm_sub_ps(c, k), scale));
+        _mm_storeu_ps(magenta + i, _mm_mul_ps(_mm_sub_ps(m, k), scale));
+        _mm_storeu_ps(yellow + i, _mm_mul_ps(_mm_sub_ps(y, k), scale));
+        _mm_storeu_ps(black + i, k);
+    }
+#endif
+
+    for (; i < count; i++) {
+        float c = 255.0f - Red(pixels[i]);
+        float m = 255.0f - Green(pixels[i]);
+        float y = 255.0f - Blue(pixels[i]);
+        float k = std::min({ c, m, y });
+
+        if (k == 255.0f) {
+            cyan[i] = magenta[i] = yellow[i] = 0.0f;
+        } else {
+            float scale = 255.0f / (255.0f - k);
+            cyan[i] = (c - k) * scale;
+            magenta[i] = (m - k) * scale;
+            yellow[i] = (y - k) * scale;
+        }
+        black[i] = k;
+    }
+}
+
+void MeaColorBatch::ToYCbCr(const uint32_t* pixels, size_t count, float* y, float* cb, float* cr) {
+    size_t i = 0;
+
+#ifdef MEA_COLORBATCH_SSE2
+    for (; i + 4 <= count; i += 4) {
+        __m128 out[3];
+        ApplyLinear(kYCbCr, LoadComponents(pixels + i), out);
+        _mm_storeu_ps(y + i, out[0]);
+        _mm_storeu_ps(cb + i, out[1]);
+        _mm_storeu_ps(cr + i, out[2]);
+    }
+#endif
+
+    LinearScalar(kYCbCr, pixels, i, count, y, cb, cr);
+}
+
+void MeaColorBatch::ToYIQ(const uint32_t* pixels, size_t count, float* y, float* i, float* q) {
+    size_t n = 0;
+
+#ifdef MEA_COLORBATCH_SSE2
+    for (; n + 4 <= count; n += 4) {
+        __m128 out[3];
+        ApplyLinear(kYIQ, LoadComponents(pixels + n), out);
+        _mm_storeu_ps(y + n, out[0]);
+        _mm_storeu_ps(i + n, out[1]);
+        _mm_storeu_ps(q + n, out[2]);
+    }
+#endif
+
+    LinearScalar(kYIQ, pixels, n, count, y, i, q);
+}
+
+void MeaColorBatch::ToXYZ(const uint32_t* pixels, size_t count, float* x, float* y, float* z) {
+    size_t i = 0;
+
+#ifdef MEA_COLORBATCH_SSE2
+    for (; i + 4 <= count; i += 4) {
+        __m128 out[3];
+        ApplyLinear(kXYZ, LoadLinearComponents(pixels + i), out);
+        _mm_storeu_ps(x + i, out[0]);
+        _mm_storeu_ps(y + i, out[1]);
+        _mm_storeu_ps(z + i, out[2]);
+    }
+#endif
+
+    XYZScalar(pixels, i, count, x, y, z);
+}
+
+void MeaColorBatch::ToLab(const uint32_t* pixels, size_t count, float* l, float* a, float* b) {
+    size_t i = 0;
+
+#ifdef MEA_COLORBATCH_SSE2
+    for (; i + 4 <= count; i += 4) {
+        __m128 xyz[3];
+        ApplyLinear(kXYZ, LoadLinearComponents(pixels + i), xyz);
+        __m128 fx = LabFunc(_mm_mul_ps(xyz[0], _mm_set1_ps(1.0f / kXRef)));
+        __m128 fy = LabFunc(_mm_mul_ps(xyz[1], _mm_set1_ps(1.0f / kYRef)));
+        __m128 fz = LabFunc(_mm_mul_ps(xyz[2], _mm_set1_ps(1.0f / kZRef)));
+
+        _mm_storeu_ps(l + i, _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(116.0f), fy), _mm_set1_ps(16.0f)));
+        _mm_storeu_ps(a + i, _mm_mul_ps(_mm_set1_ps(500.0f), _mm_sub_ps(fx, fy)));
+        _mm_storeu_ps(b + i, _mm_mul_ps(_mm_set1_ps(200.0f), _mm_sub_ps(fy, fz)));
+    }
+#endif
+
+    // The XYZ values are written to the output arrays and then converted in place.
+    XYZScalar(pixels, i, count, l, a, b);
+    for (; i < count; i++) {
+        float fx = LabFunc(l[i] / kXRef);
+        float fy = LabFunc(a[i] / kYRef);
+        float fz = LabFunc(b[i] / kZRef);
+
+        l[i] = (116.0f * fy) - 16.0f;
+        a[i] = 500.0f * (fx - fy);
+        b[i] = 200.0f * (fy - fz);
+    }
+}
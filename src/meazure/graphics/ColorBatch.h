@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Color space conversion of whole arrays of pixels.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+/// Batch versions of the MeaColors color space conversions, for analyzing
+/// entire captured regions rather than single pixels. The input is an
+/// array of packed 32 bit pixels as stored in a 32 bit DIB, i.e. 0xAARRGGBB
+/// (B, G, R, A in memory), with the alpha byte ignored. Note that this is a
+/// different byte order than a COLORREF. The output is planar: one float
+/// array per component of the color model, each with room for count values.
+///
+/// The outputs are in the same ranges as the corresponding single pixel
+/// MeaColors functions, but are not rounded to integers. Four pixels at a
+/// time are converted using SSE2 float arithmetic when available, with a
+/// scalar float fallback. Each output is within kTolerance of the value the
+/// single pixel function computes before rounding, so rounding an output
+/// to the nearest integer gives the single pixel result or differs from it
+/// by one when that value is within kTolerance of a rounding boundary.
+///
+namespace MeaColorBatch {
+
+    constexpr float kTolerance = 1e-3f;     ///< Maximum difference from the single pixel conversions.
+
+    /// Extracts the red, green and blue components of a pixel as a COLORREF,
+    /// for use with the single pixel MeaColors functions.
+    ///
+    /// @param pixel    [in] Packed 32 bit DIB pixel (0xAARRGGBB).
+    /// @return Corresponding COLORREF (0x00BBGGRR).
+    ///
+    constexpr uint32_t PixelToCOLORREF(uint32_t pixel) {
+        return ((pixel >> 16) & 0xFF) | (pixel & 0xFF00) | ((pixel & 0xFF) << 16);
+    }
+
+    /// Converts pixels to the Hue, Saturation and Lightness color space. See
+    /// MeaColors::RGBtoHSL.
+    ///
+    /// @param pixels       [in] Pixels to convert.
+    /// @param count        [in] Number of pixels to convert.
+    /// @param hue          [out] Hue of each pixel, in degrees [0, 360].
+    /// @param saturation   [out] Saturation of each pixel, as a percentage [0, 100].
+    /// @param lightness    [out] Lightness of each pixel, as a percentage [0, 100].
+    ///
+    void ToHSL(const uint32_t* pixels, size_t count, float* hue, float* saturation, float* lightness);
+
+    /// Converts pixels to the Cyan, Magenta, Yellow and Black color space.
+    /// See MeaColors::RGBtoCMYK.
+    ///
+    /// @param pixels       [in] Pixels to convert.
+    /// @param count        [in] Number of pixels to convert.
+    /// @param cyan         [out] Cyan component of each pixel [0, 255].
+    /// @param magenta      [out] Magenta component of each pixel [0, 255].
+    /// @param yellow       [out] Yellow component of each pixel [0, 255].
+    /// @param black        [out] Black component of each pixel [0, 255].
+    ///
+    void ToCMYK(const uint32_t* pixels, size_t count, float* cyan, float* magenta, float* yellow, float* black);
+
+    /// Converts pixels to the Luminance, Blue-Difference and Red-Difference
+    /// color space. See MeaColors::RGBtoYCbCr.
+    ///
+    /// @param pixels       [in] Pixels to convert.
+    /// @param count        [in] Number of pixels to convert.
+    /// @param y            [out] Luminance of each pixel [16, 235].
+    /// @param cb           [out] Blue difference of each pixel [16, 240].
+    /// @param cr           [out] Red difference of each pixel [16, 240].
+    ///
+    void ToYCbCr(const uint32_t* pixels, size_t count, float* y, float* cb, float* cr);
+
+    /// Converts pixels to the Luminance, In-phase and Quadrature color space.
+    /// See MeaColors::RGBtoYIQ.
+    ///
+    /// @param pixels       [in] Pixels to convert.
+    /// @param count        [in] Number of pixels to convert.
+    /// @param y            [out] Luminance of each pixel [0, 255].
+    /// @param i            [out] In-phase component of each pixel [-152, 152].
+    /// @param q            [out] Quadrature component of each pixel [-133, 133].
+    ///
+    void ToYIQ(const uint32_t* pixels, size_t count, float* y, float* i, float* q);
+
+    /// Converts pixels to the CIE 1931 XYZ color space. See
+    /// MeaColors::RGBtoXYZ.
+    ///
+    /// @param pixels       [in] Pixels to convert.
+    /// @param count        [in] Number of pixels to convert.
+    /// @param x            [out] X component of each pixel [0.0, 95.047].
+    /// @param y            [out] Y component of each pixel [0.0, 100.0].
+    /// @param z            [out] Z component of each pixel [0.0, 108.883].
+    ///
+    void ToXYZ(const uint32_t* pixels, size_t count, float* x, float* y, float* z);
+
+    /// Converts pixels to the CIE L*a*b* color space. See
+    /// MeaColors::RGBtoLab.
+    ///
+    /// @param pixels       [in] Pixels to convert.
+    /// @param count        [in] Number of pixels to convert.
+    /// @param l            [out] Lightness of each pixel [0.0, 100.0].
+    /// @param a            [out] a* component of each pixel.
+    /// @param b            [out] b* component of each pixel.
+    ///
+    void ToLab(const uint32_t* pixels, size_t count, float* l, float* a, float* b);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "ColorMatchTable.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+
+MeaColorMatchTable::MeaColorMatchTable(const MeaColors::ColorTableEntry* table, Matcher matcher) :
+    m_table(table),
+    m_matcher(matcher),
+    m_nextColor(0),
+    m_ready(false),
+    m_cancel(false),
+    m_started(false) {}
+
+MeaColorMatchTable::~MeaColorMatchTable() {
+    m_cancel = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void MeaColorMatchTable::Build() {
+    std::lock_guard<std::mutex> lock(m_buildMutex);
+
+    if (!m_started) {
+        m_started = true;
+        Run();
+    } else if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void MeaColorMatchTable::BuildAsync() {
+    std::lock_guard<std::mutex> lock(m_buildMutex);
+    if (!m_started) {
+        m_started = true;
+        m_thread = std::thread(&MeaColorMatchTable::Run, this);
+    }
+}
+
+void MeaColorMatchTable::Run() {
+    int numEntries = 0;
+    while (m_table[numEntries].name != nullptr) {
+        numEntries++;
+    }
+    if (numEntries == 0 || numEntries > kMaxEntries) {
+        return;
+    }
+
+    m_indices.reset(new uint8_t[kNumColors]);
+
+    // The calling thread is one of the workers. One processor is left
+    // for the user interface.
+    //
+    unsigned int numWorkers = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < numWorkers; i++) {
+        workers.emplace_back(&MeaColorMatchTable::MatchRange, this);
+    }
+    MatchRange();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    if (!m_cancel) {
+        m_ready.store(true, std::memory_order_release);
+    }
+}
+
+void MeaColorMatchTable::MatchRange() {
+    for (;;) {
+        uint32_t start = m_nextColor.fetch_add(kBatchSize);
+        if (start >= kNumColors || m_cancel) {
+            return;
+        }
+
+        for (uint32_t rgb = start; rgb < start + kBatchSize; rgb++) {
+            const MeaColors::ColorTableEntry* entry = m_matcher(m_table, rgb);
+            assert(entry != nullptr);
+            m_indices[rgb] = static_cast<uint8_t>(entry - m_table);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the precomputed color matching table.
+
+#pragma once
+
+#include "Colors.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+/// Precomputed answers to MeaColors::MatchColor for a color table. The
+/// closest table entry depends only on the 24 bit RGB value being matched,
+/// so the table records the index of the closest entry for every one of
+/// the 2^24 RGB values, one byte per value (16 MB). Once built, matching
+/// a color is a single memory read.
+///
+/// Building the table performs MatchColor for every RGB value, which takes
+/// a significant amount of processor time. The table is therefore built
+/// on demand on a background thread, which divides the work among all but
+/// one of the available processors. Until the table is ready, Lookup
+/// returns nullptr and callers fall back to matching the color directly.
+///
+/// MeaColors::MatchBasicColor and MeaColors::MatchExtendedColor do not use
+/// a match table. A caller that matches enough colors to justify the
+/// memory and build time, such as the magnifier, constructs its own table,
+/// owns its lifetime and falls back to those functions until it is ready.
+///
+class MeaColorMatchTable {
+
+public:
+    /// Function that finds the closest entry in a color table. The
+    /// signature matches MeaColors::MatchColor.
+    ///
+    typedef const MeaColors::ColorTableEntry* (*Matcher)(const MeaColors::ColorTableEntry* table, COLORREF rgb);
+
+    static constexpr uint32_t kNumColors { 1 << 24 };   ///< Number of 24 bit RGB values.
+    static constexpr int kMaxEntries { 255 };           ///< Maximum number of entries in a table that can be indexed.
+
+
+    /// Constructs an empty match table. No memory is allocated and no
+    /// matching is performed until Build or BuildAsync is called.
+    ///
+    /// @param table    [in] Color table to match against. Last entry must have a nullptr name. The table must
+    ///                 remain valid for the life of this object.
+    /// @param matcher  [in] Function used to find the closest entry for each color.
+    ///
+    explicit MeaColorMatchTable(const MeaColors::ColorTableEntry* table, Matcher matcher = MeaColors::MatchColor);
+
+    /// Stops any build in progress and destroys the table.
+    ///
+    ~MeaColorMatchTable();
+
+    MeaColorMatchTable(const MeaColorMatchTable&) = delete;
+    MeaColorMatchTable& operator=(const MeaColorMatchTable&) = delete;
+
+    /// Builds the table using the calling thread, if it has not already
+    /// been built. If a background build is in progress, waits for it to
+    /// finish.
+    ///
+    void Build();
+
+    /// Starts building the table on a background thread, if a build has not
+    /// already been started. Returns immediately.
+    ///
+    void BuildAsync();
+
+    /// Indicates whether the table has been built.
+    ///
+    /// @return <b>true</b> if Lookup will return matches.
+    ///
+    bool IsReady() const { return m_ready.load(std::memory_order_acquire); }
+
+    /// Obtains the closest entry for the specified color from the table.
+    ///
+    /// @param rgb      [in] Color to match.
+    /// @return Closest entry in the color table, or nullptr if the table has not been built or the color table
+    ///         cannot be indexed (i.e. it is empty or has more than kMaxEntries entries).
+    ///
+    const MeaColors::ColorTableEntry* Lookup(COLORREF rgb) const {
+        return IsReady() ? &m_table[m_indices[rgb & (kNumColors - 1)]] : nullptr;
+    }
+
+    /// Obtains the number of bytes of memory used by the table.
+    ///
+    /// @return Size of the table in bytes. Zero before the table is built.
+    ///
+    std::size_t GetMemorySize() const { return IsReady() ? kNumColors : 0; }
+
+private:
+    /// Performs the build. Runs on the thread calling Build or on the
+    /// background thread started by BuildAsync.
+    ///
+    void Run();
+
+    /// Matches a range of colors and records the indices of their closest
+    /// entries. Called concurrently by the worker threads.
+    ///
+    void MatchRange();
+
+    static constexpr uint32_t kBatchSize { 1 << 12 };   ///< Number of colors claimed by a worker at a time.
+
+    const MeaColors::ColorTableEntry* m_table;  ///< Color table being indexed.
+    Matcher m_matcher;                          ///< Function finding the closest entry for a color.
+    std::unique_ptr<uint8_t[]> m_indices;       ///< Index of the closest entry for each RGB value.
+    std::atomic<uint32_t> m_nextColor;          ///< Next color to be claimed by a worker.
+    std::atomic<bool> m_ready;                  ///< Indicates that the table has been built.
+    std::atomic<bool> m_cancel;                 ///< Requests that a build in progress stop.
+    std::mutex m_buildMutex;                    ///< Serializes starting a build.
+    bool m_started;                             ///< Indicates that a build has been started.
+    std::thread m_thread;                       ///< Background build thread, if BuildAsync was called.
+};
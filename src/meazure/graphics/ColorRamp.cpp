@@ -0,0 +1,282 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "ColorRamp.h"
+#include "Colors.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+ /// SSE2 instructions are available for the L*a*b* ramp.
+#define MEA_COLORRAMP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Remove Windows defines so std versions can be used.
+#undef min
+#undef max
+
+
+namespace {
+
+    // 1931 D65 2 degree illuminant reference, scaled to a Y of 1.0, and the L*a*b* function constants used by
+    // MeaColors::LabtoRGB.
+    constexpr float kXRef = 95.047f / 100.0f;
+    constexpr float kYRef = 100.000f / 100.0f;
+    constexpr float kZRef = 108.883f / 100.0f;
+    constexpr float kLabThreshold = 0.008856f;
+    constexpr float kLabSlope = 903.3f / 116.0f;
+    constexpr float kLabOffset = 16.0f / 116.0f;
+
+    /// XYZ to linear sRGB coefficients used by MeaColors::LabtoRGB.
+    constexpr float kRGB[3][3] = {
+        {  3.2404542f, -1.5371385f, -0.4985314f },
+        { -0.9692660f,  1.8760108f,  0.0415560f },
+        {  0.0556434f, -0.2040259f,  1.0572252f }
+    };
+
+    /// Linear sRGB values at which the 8 bit sRGB component values change, which replace the pow of the sRGB
+    /// companding and the rounding. Threshold k is the linear value of the sRGB component k + 0.5, so a linear value
+    /// rounds to the number of thresholds it is greater than or equal to. To find that number without a search, the
+    /// linear range [0, 1) is divided into kNumBuckets equal buckets, and the number of thresholds below each
+    /// bucket is recorded. The companding is steepest near zero, where it increases by about 0.8 component values per
+    /// bucket, so a bucket contains at most one threshold and a single comparison completes the conversion.
+    ///
+    struct CompandingThresholds {
+        static constexpr int kNumBuckets { 4096 };
+
+        float values[256];              ///< Threshold of each component value, plus an unreachable sentinel.
+        uint8_t buckets[kNumBuckets];   ///< Number of thresholds less than or equal to the start of each bucket.
+
+        constexpr CompandingThresholds() : values(), buckets() {
+            for (int k = 0; k < 255; k++) {
+                double value = (k + 0.5) / 255.0;
+                if (value > 0.04045) {
+                    // value^2.4 calculated as t^2 * (t^2)^(1/5) so that it can be evaluated at compile time.
+                    double t = (value + 0.055) / 1.055;
+                    value = t * t * MeaNumericUtils::NthRoot(t * t, 5);
+                } else {
+                    value = value / 12.92;
+                }
+                values[k] = static_cast<float>(value);
+            }
+            values[255] = 2.0f;
+
+            int count = 0;
+            for (int bucket = 0; bucket < kNumBuckets; bucket++) {
+                while (count < 255 && values[count] <= static_cast<float>(bucket) / kNumBuckets) {
+                    count++;
+                }
+                buckets[bucket] = static_cast<uint8_t>(count);
+            }
+        }
+    };
+
+    constexpr CompandingThresholds kThresholds;
+
+    /// Largest linear value converted, so that its bucket is within the table.
+    constexpr float kMaxLinear = 0.99999994f;
+
+    /// Converts a linear sRGB component in [0, kMaxLinear] to an 8 bit sRGB component.
+    ///
+    int Compand(float value) {
+        int count = kThresholds.buckets[static_cast<int>(value * CompandingThresholds::kNumBuckets)];
+        return count + ((value >= kThresholds.values[count]) ? 1 : 0);
+    }
+
+    /// Clamps a linear sRGB component to [0, kMaxLinear].
+    ///
+    float Clamp(float value) {
+        return std::min(std::max(value, 0.0f), kMaxLinear);
+    }
+
+    /// Inverse of the L*a*b* function.
+    ///
+    float InverseLabFunc(float value) {
+        float cube = value * value * value;
+        return (cube > kLabThreshold) ? cube : (value - kLabOffset) / kLabSlope;
+    }
+
+    /// Scalar conversion of an L*a*b* color to RGB in single precision. The SSE2 conversion performs the same
+    /// operations in the same order, so the two give identical results.
+    ///
+    COLORREF LabtoRGB(float l, float a, float b) {
+        float fy = (l + 16.0f) / 116.0f;
+        float x = InverseLabFunc(fy + a / 500.0f) * kXRef;
+        float y = InverseLabFunc(fy) * kYRef;
+        float z = InverseLabFunc(fy - b / 200.0f) * kZRef;
+
+        int components[3];
+        for (int n = 0; n < 3; n++) {
+            components[n] = Compand(Clamp(kRGB[n][0] * x + kRGB[n][1] * y + kRGB[n][2] * z));
+        }
+        return RGB(components[0], components[1], components[2]);
+    }
+
+    /// Produces delta * i / last rounded to the nearest integer for successive values of i starting at 1, with
+    /// halfway cases rounded away from zero as std::round does. The rounded quotient is maintained incrementally
+    /// with integer arithmetic rather than dividing for each value. This gives the same result as rounding the
+    /// floating point quotient computed by MeaColors::InterpolateColor because halfway values are exactly
+    /// representable in floating point.
+    ///
+    class RoundedSteps {
+    public:
+        RoundedSteps(int delta, size_t last) :
+            m_negative(delta < 0),
+            m_denominator(2 * static_cast<int64_t>(last)),
+            m_quotientStep((2 * std::abs(static_cast<int64_t>(delta))) / m_denominator),
+            m_remainderStep((2 * std::abs(static_cast<int64_t>(delta))) % m_denominator),
+            m_quotient(0),
+            m_remainder(static_cast<int64_t>(last)) {}
+
+        /// Advances to the next value of i.
+        ///
+        /// @return delta * i / last rounded to the nearest integer.
+        ///
+        int Next() {
+            // The rounded magnitude is (2 * |delta| * i + last) / (2 * last), of which m_quotient is the quotient
+            // and m_remainder is the remainder.
+            m_quotient += m_quotientStep;
+            m_remainder += m_remainderStep;
+            if (m_remainder >= m_denominator) {
+                m_remainder -= m_denominator;
+                m_quotient++;
+            }
+            return static_cast<int>(m_negative ? -m_quotient : m_quotient);
+        }
+
+    private:
+        bool m_negative;
+        int64_t m_denominator;
+        int64_t m_quotientStep;
+        int64_t m_remainderStep;
+        int64_t m_quotient;
+        int64_t m_remainder;
+    };
+
+    void GenerateHSL(COLORREF startRGB, COLORREF endRGB, COLORREF* colors, size_t count) {
+        MeaColors::HSL startHSL = MeaColors::RGBtoHSL(startRGB);
+        MeaColors::HSL endHSL = MeaColors::RGBtoHSL(endRGB);
+        size_t last = count - 1;
+        RoundedSteps hueSteps(endHSL.hue - startHSL.hue, last);
+        RoundedSteps saturationSteps(endHSL.saturation - startHSL.saturation, last);
+        RoundedSteps lightnessSteps(endHSL.lightness - startHSL.lightness, last);
+
+        // Adjacent colors of a long ramp often round to the same HSL color, so the conversion back to RGB is only
+        // performed when the HSL color changes.
+        MeaColors::HSL previousHSL(-1, -1, -1);
+        COLORREF rgb = startRGB;
+
+        for (size_t i = 1; i < last; i++) {
+            MeaColors::HSL hsl(startHSL.hue + hueSteps.Next(),
+                               startHSL.saturation + saturationSteps.Next(),
+                               startHSL.lightness + lightnessSteps.Next());
+            if (hsl.hue != previousHSL.hue || hsl.saturation != previousHSL.saturation ||
+                hsl.lightness != previousHSL.lightness) {
+                rgb = MeaColors::HSLtoRGB(hsl);
+                previousHSL = hsl;
+            }
+            colors[i] = rgb;
+        }
+    }
+
+    void GenerateLab(COLORREF startRGB, COLORREF endRGB, COLORREF* colors, size_t count) {
+        MeaColors::Lab startLab = MeaColors::RGBtoLab(startRGB);
+        MeaColors::Lab endLab = MeaColors::RGBtoLab(endRGB);
+        float l0 = static_cast<float>(startLab.l);
+        float a0 = static_cast<float>(startLab.a);
+        float b0 = static_cast<float>(startLab.b);
+        float deltaL = static_cast<float>(endLab.l - startLab.l);
+        float deltaA = static_cast<float>(endLab.a - startLab.a);
+        float deltaB = static_cast<float>(endLab.b - startLab.b);
+        float scale = 1.0f / static_cast<float>(count - 1);
+        size_t i = 0;
+
+#ifdef MEA_COLORRAMP_SSE2
+        const __m128 sixteen = _mm_set1_ps(16.0f);
+        const __m128 threshold = _mm_set1_ps(kLabThreshold);
+        const __m128 slope = _mm_set1_ps(kLabSlope);
+        const __m128 offset = _mm_set1_ps(kLabOffset);
+
+        auto inverseLabFunc = [threshold, slope, offset](__m128 value) {
+            __m128 cube = _mm_mul_ps(_mm_mul_ps(value, value), value);
+            __m128 linear = _mm_div_ps(_mm_sub_ps(value, offset), slope);
+            __m128 mask = _mm_cmpgt_ps(cube, threshold);
+            return _mm_or_ps(_mm_and_ps(mask, cube), _mm_andnot_ps(mask, linear));
+        };
+
+        __m128 position = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 t = _mm_mul_ps(position, _mm_set1_ps(scale));
+            __m128 l = _mm_add_ps(_mm_set1_ps(l0), _mm_mul_ps(_mm_set1_ps(deltaL), t));
+            __m128 a = _mm_add_ps(_mm_set1_ps(a0), _mm_mul_ps(_mm_set1_ps(deltaA), t));
+            __m128 b = _mm_add_ps(_mm_set1_ps(b0), _mm_mul_ps(_mm_set1_ps(deltaB), t));
+            position = _mm_add_ps(position, _mm_set1_ps(4.0f));
+
+            __m128 fy = _mm_div_ps(_mm_add_ps(l, sixteen), _mm_set1_ps(116.0f));
+            __m128 x = _mm_mul_ps(inverseLabFunc(_mm_add_ps(fy, _mm_div_ps(a, _mm_set1_ps(500.0f)))),
+                                  _mm_set1_ps(kXRef));
+            __m128 y = _mm_mul_ps(inverseLabFunc(fy), _mm_set1_ps(kYRef));
+            __m128 z = _mm_mul_ps(inverseLabFunc(_mm_sub_ps(fy, _mm_div_ps(b, _mm_set1_ps(200.0f)))),
+                                  _mm_set1_ps(kZRef));
+
+            // There is no SSE2 gather, so the threshold lookups are scalar.
+            alignas(16) float linear[3][4];
+            for (int n = 0; n < 3; n++) {
+                __m128 value = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kRGB[n][0]), x),
+                                          _mm_mul_ps(_mm_set1_ps(kRGB[n][1]), y));
+                value = _mm_add_ps(value, _mm_mul_ps(_mm_set1_ps(kRGB[n][2]), z));
+                _mm_store_ps(linear[n], _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(kMaxLinear)));
+            }
+            for (int k = 0; k < 4; k++) {
+                colors[i + k] = RGB(Compand(linear[0][k]), Compand(linear[1][k]), Compand(linear[2][k]));
+            }
+        }
+#endif
+
+        for (; i < count; i++) {
+            float t = static_cast<float>(i) * scale;
+            colors[i] = LabtoRGB(l0 + deltaL * t, a0 + deltaA * t, b0 + deltaB * t);
+        }
+    }
+}
+
+
+void MeaColorRamp::Generate(COLORREF startRGB, COLORREF endRGB, COLORREF* colors, size_t count,
+                            Interpolation interpolation) {
+    if (count == 0) {
+        return;
+    }
+
+    if (count > 2) {
+        if (interpolation == Interpolation::HSL) {
+            GenerateHSL(startRGB, endRGB, colors, count);
+        } else {
+            GenerateLab(startRGB, endRGB, colors, count);
+        }
+    }
+
+    colors[0] = startRGB;
+    if (count > 1) {
+        colors[count - 1] = endRGB;
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// @file
+/// @brief Generation of color ramps between two colors.
+
+#pragma once
+
+#include <cstddef>
+
+
+/// Generates a sequence of colors evenly spaced between two colors, such as
+/// for a gradient or a palette preview. This is equivalent to calling
+/// MeaColors::InterpolateColor for each color in the sequence, except that
+/// the two endpoint colors are converted only once for the whole sequence
+/// rather than once per color.
+///
+namespace MeaColorRamp {
+
+    /// Color space in which the colors are interpolated.
+    ///
+    enum class Interpolation {
+        HSL,    ///< Hue, saturation and lightness, as performed by MeaColors::InterpolateColor.
+        Lab     ///< CIE L*a*b*, which is perceptually uniform.
+    };
+
+    /// Generates colors evenly spaced from startRGB to endRGB. Color i of
+    /// the sequence is the interpolation i / (count - 1) of the way from
+    /// startRGB to endRGB. The first color is always startRGB and the last
+    /// color is always endRGB.
+    ///
+    /// For HSL interpolation, each color is identical to the result of
+    /// MeaColors::InterpolateColor for the same fraction. In particular, when
+    /// count is 101 color i is InterpolateColor(startRGB, endRGB, i).
+    ///
+    /// For L*a*b* interpolation, large ramps are converted four colors at a
+    /// time using SSE2 single precision arithmetic when available. Each
+    /// component is within one of MeaColors::LabtoRGB applied to the
+    /// interpolated L*a*b* color.
+    ///
+    /// @param startRGB         [in] Starting color of the ramp.
+    /// @param endRGB           [in] Ending color of the ramp.
+    /// @param colors           [out] Generated colors. Must have room for count colors.
+    /// @param count            [in] Number of colors to generate.
+    /// @param interpolation    [in] Color space in which to interpolate.
+    ///
+    void Generate(COLORREF startRGB, COLORREF endRGB, COLORREF* colors, size_t count,
+                  Interpolation interpolation = Interpolation::HSL);
+}
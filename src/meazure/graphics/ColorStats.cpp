@@ -0,0 +1,287 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "ColorStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+
+// Remove Windows defines so std versions can be used.
+#undef min
+#undef max
+
+
+namespace {
+
+    constexpr int kBandRows = 64;       ///< Number of rows claimed by a worker at a time.
+
+    /// Sums accumulated over the pixels processed by one worker.
+    ///
+    struct Accumulator {
+        uint64_t sumSquares[3];             ///< Sum of the squared red, green and blue values.
+        std::vector<uint32_t> counts;       ///< Number of pixels in each histogram bin.
+        std::vector<uint64_t> sums;         ///< Sum of the red, green and blue values of the pixels in each bin.
+
+        Accumulator() : sumSquares(), counts(MeaColorStats::kHistogramSize), sums(3 * MeaColorStats::kHistogramSize) {}
+
+        /// Adds the sums accumulated by another worker.
+        ///
+        void Add(const Accumulator& other) {
+            for (int c = 0; c < 3; c++) {
+                sumSquares[c] += other.sumSquares[c];
+            }
+            for (int bin = 0; bin < MeaColorStats::kHistogramSize; bin++) {
+                counts[bin] += other.counts[bin];
+                sums[3 * bin] += other.sums[3 * bin];
+                sums[3 * bin + 1] += other.sums[3 * bin + 1];
+                sums[3 * bin + 2] += other.sums[3 * bin + 2];
+            }
+        }
+    };
+
+    /// Accumulates the pixels of a range of rows.
+    ///
+    void AccumulateRows(const MeaPixelBuffer& buffer, int top, int bottom, Accumulator& acc) {
+        uint32_t* counts = acc.counts.data();
+        uint64_t* sums = acc.sums.data();
+        uint64_t squares[3] = { 0, 0, 0 };
+
+        for (int y = top; y < bottom; y++) {
+            const uint32_t* row = buffer.pixels + static_cast<std::ptrdiff_t>(y) * buffer.stride;
+            for (int x = 0; x < buffer.width; x++) {
+                uint32_t pixel = row[x];
+                uint32_t red = (pixel >> 16) & 0xFF;
+                uint32_t green = (pixel >> 8) & 0xFF;
+                uint32_t blue = pixel & 0xFF;
+
+                int bin = MeaColorStats::HistogramIndex(static_cast<int>(red), static_cast<int>(green),
+                                                        static_cast<int>(blue));
+                counts[bin]++;
+                sums[3 * bin] += red;
+                sums[3 * bin + 1] += green;
+                sums[3 * bin + 2] += blue;
+
+                squares[0] += red * red;
+                squares[1] += green * green;
+                squares[2] += blue * blue;
+            }
+        }
+
+        for (int c = 0; c < 3; c++) {
+            acc.sumSquares[c] += squares[c];
+        }
+    }
+
+    /// Box of histogram bins used by the median cut. The bounds are inclusive bin coordinates along the red, green
+    /// and blue axes.
+    ///
+    struct Box {
+        int lo[3];
+        int hi[3];
+        uint64_t count;
+    };
+
+    /// Calls a function for every bin in a box.
+    ///
+    template<typename Func>
+    void ForEachBin(const Box& box, Func func) {
+        for (int r = box.lo[0]; r <= box.hi[0]; r++) {
+            for (int g = box.lo[1]; g <= box.hi[1]; g++) {
+                for (int b = box.lo[2]; b <= box.hi[2]; b++) {
+                    func(r, g, b, (r << (2 * MeaColorStats::kHistogramBits)) | (g << MeaColorStats::kHistogramBits) | b);
+                }
+            }
+        }
+    }
+
+    /// Shrinks a box to the smallest box holding all of its non-empty bins and counts its pixels.
+    ///
+    void ShrinkBox(const Accumulator& acc, Box& box) {
+        Box tight { { MeaColorStats::kHistogramSide, MeaColorStats::kHistogramSide, MeaColorStats::kHistogramSide },
+                    { -1, -1, -1 }, 0 };
+        ForEachBin(box, [&acc, &tight](int r, int g, int b, int bin) {
+            if (acc.counts[bin] != 0) {
+                int coords[3] = { r, g, b };
+                for (int c = 0; c < 3; c++) {
+                    tight.lo[c] = std::min(tight.lo[c], coords[c]);
+                    tight.hi[c] = std::max(tight.hi[c], coords[c]);
+                }
+                tight.count += acc.counts[bin];
+            }
+        });
+        box = tight;
+    }
+
+    /// Splits a box at the median of its longest side.
+    ///
+    /// @return The upper part of the box. The box is reduced to the lower part.
+    ///
+    Box SplitBox(const Accumulator& acc, Box& box) {
+        int axis = 0;
+        for (int c = 1; c < 3; c++) {
+            if ((box.hi[c] - box.lo[c]) > (box.hi[axis] - box.lo[axis])) {
+                axis = c;
+            }
+        }
+
+        uint64_t slices[MeaColorStats::kHistogramSide] = {};
+        ForEachBin(box, [&acc, &slices, axis](int r, int g, int b, int bin) {
+            int coords[3] = { r, g, b };
+            slices[coords[axis]] += acc.counts[bin];
+        });
+
+        // The cut leaves at least one slice on each side. Both end slices are non-empty because the box is tight.
+        int cut = box.lo[axis];
+        uint64_t below = slices[cut];
+        while (cut < box.hi[axis] - 1 && 2 * below < box.count) {
+            below += slices[++cut];
+        }
+
+        Box upper = box;
+        upper.lo[axis] = cut + 1;
+        box.hi[axis] = cut;
+        ShrinkBox(acc, box);
+        ShrinkBox(acc, upper);
+        return upper;
+    }
+
+    /// Finds the dominant colors by median cut.
+    ///
+    std::vector<MeaColorStats::DominantColor> MedianCut(const Accumulator& acc, uint64_t pixelCount,
+                                                        int numDominant) {
+        std::vector<Box> boxes;
+        if (pixelCount == 0 || numDominant <= 0) {
+            return {};
+        }
+
+        Box all { { 0, 0, 0 }, { MeaColorStats::kHistogramSide - 1, MeaColorStats::kHistogramSide - 1,
+                                 MeaColorStats::kHistogramSide - 1 }, 0 };
+        ShrinkBox(acc, all);
+        boxes.push_back(all);
+
+        while (static_cast<int>(boxes.size()) < numDominant) {
+            // Split the most populous box that spans more than one bin.
+            Box* largest = nullptr;
+            for (Box& box : boxes) {
+                bool splittable = box.lo[0] < box.hi[0] || box.lo[1] < box.hi[1] || box.lo[2] < box.hi[2];
+                if (splittable && (largest == nullptr || box.count > largest->count)) {
+                    largest = &box;
+                }
+            }
+            if (largest == nullptr) {
+                break;
+            }
+            Box upper = SplitBox(acc, *largest);
+            boxes.push_back(upper);
+        }
+
+        std::vector<MeaColorStats::DominantColor> colors;
+        for (const Box& box : boxes) {
+            uint64_t sums[3] = { 0, 0, 0 };
+            ForEachBin(box, [&acc, &sums](int, int, int, int bin) {
+                sums[0] += acc.sums[3 * bin];
+                sums[1] += acc.sums[3 * bin + 1];
+                sums[2] += acc.sums[3 * bin + 2];
+            });
+
+            auto mean = [&box](uint64_t sum) { return static_cast<BYTE>((sum + box.count / 2) / box.count); };
+            COLORREF rgb = RGB(mean(sums[0]), mean(sums[1]), mean(sums[2]));
+            colors.push_back({ rgb, box.count, static_cast<double>(box.count) / pixelCount, nullptr });
+        }
+
+        std::sort(colors.begin(), colors.end(),
+                  [](const MeaColorStats::DominantColor& a, const MeaColorStats::DominantColor& b) {
+            return (a.count != b.count) ? (a.count > b.count) : (a.rgb < b.rgb);
+        });
+
+        for (MeaColorStats::DominantColor& color : colors) {
+            color.name = MeaColors::MatchExtendedColor(color.rgb);
+        }
+        return colors;
+    }
+}
+
+
+MeaColorStats::Stats MeaColorStats::Calculate(const MeaPixelBuffer& buffer, int numDominant, int numWorkers) {
+    Stats stats {};
+
+    int width = std::max(buffer.width, 0);
+    int height = std::max(buffer.height, 0);
+    int numBands = (height + kBandRows - 1) / kBandRows;
+
+    if (numWorkers <= 0) {
+        numWorkers = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+    }
+    numWorkers = std::max(std::min(numWorkers, numBands), 1);
+
+    // Each worker claims bands of rows until none remain. The calling thread is one of the workers.
+    //
+    std::vector<Accumulator> accumulators(numWorkers);
+    std::atomic<int> nextBand(0);
+    auto work = [&buffer, &nextBand, &accumulators, numBands, height](int worker) {
+        for (int band = nextBand++; band < numBands; band = nextBand++) {
+            int top = band * kBandRows;
+            AccumulateRows(buffer, top, std::min(top + kBandRows, height), accumulators[worker]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int worker = 1; worker < numWorkers; worker++) {
+        threads.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    Accumulator& total = accumulators[0];
+    for (int worker = 1; worker < numWorkers; worker++) {
+        total.Add(accumulators[worker]);
+    }
+
+    stats.pixelCount = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
+    stats.histogram = total.counts;
+
+    if (stats.pixelCount > 0) {
+        uint64_t sums[3] = { 0, 0, 0 };
+        for (int bin = 0; bin < kHistogramSize; bin++) {
+            sums[0] += total.sums[3 * bin];
+            sums[1] += total.sums[3 * bin + 1];
+            sums[2] += total.sums[3 * bin + 2];
+        }
+
+        ChannelStats* channels[3] = { &stats.red, &stats.green, &stats.blue };
+        for (int c = 0; c < 3; c++) {
+            double n = static_cast<double>(stats.pixelCount);
+            double mean = sums[c] / n;
+            double variance = total.sumSquares[c] / n - mean * mean;
+            channels[c]->mean = mean;
+            channels[c]->stddev = std::sqrt(std::max(variance, 0.0));
+        }
+
+        stats.meanColor = RGB(std::lround(stats.red.mean), std::lround(stats.green.mean), std::lround(stats.blue.mean));
+        stats.meanName = MeaColors::MatchExtendedColor(stats.meanColor);
+    }
+
+    stats.dominant = MedianCut(total, stats.pixelCount, numDominant);
+    return stats;
+}
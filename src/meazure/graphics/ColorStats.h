@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Color statistics over a rectangular array of pixels.
+
+#pragma once
+
+#include "Colors.h"
+#include "PixelZoom.h"
+#include <cstdint>
+#include <vector>
+
+
+/// Color statistics of a region of pixels, such as the screen area under
+/// the current tool's region. The pixels are provided in a MeaPixelBuffer
+/// as 0x00RRGGBB values (e.g. the bits of a 32 bit DIB section), so the
+/// statistics are calculated without reference to the screen.
+///
+/// The buffer is divided into bands of rows that are processed in parallel.
+/// Each worker accumulates integer sums and counts, which are combined when
+/// all workers finish, so the results are identical regardless of the
+/// number of workers.
+///
+namespace MeaColorStats {
+
+    constexpr int kHistogramBits = 5;                               ///< Bits per channel used by the histogram.
+    constexpr int kHistogramSide = 1 << kHistogramBits;             ///< Number of histogram bins per channel.
+    constexpr int kHistogramSize = 1 << (3 * kHistogramBits);       ///< Total number of histogram bins.
+
+    /// Mean and standard deviation of one color channel.
+    ///
+    struct ChannelStats {
+        double mean;        ///< Mean channel value [0, 255].
+        double stddev;      ///< Population standard deviation of the channel values.
+    };
+
+    /// One of the dominant colors of a region.
+    ///
+    struct DominantColor {
+        COLORREF rgb;                               ///< Mean color of the pixels represented by this color.
+        uint64_t count;                             ///< Number of pixels represented by this color.
+        double fraction;                            ///< Fraction of the region's pixels represented by this color.
+        const MeaColors::ColorTableEntry* name;     ///< Closest Web extended color.
+    };
+
+    /// Statistics of a region.
+    ///
+    struct Stats {
+        uint64_t pixelCount;                    ///< Number of pixels in the region.
+        ChannelStats red;                       ///< Red channel statistics.
+        ChannelStats green;                     ///< Green channel statistics.
+        ChannelStats blue;                      ///< Blue channel statistics.
+        COLORREF meanColor;                     ///< Color made up of the rounded channel means.
+        const MeaColors::ColorTableEntry* meanName;     ///< Closest Web extended color to the mean color.
+        std::vector<uint32_t> histogram;        ///< Pixel counts of the kHistogramSize bins. See HistogramIndex.
+        std::vector<DominantColor> dominant;    ///< Dominant colors, most common first.
+    };
+
+    /// Obtains the histogram bin of a color. Each channel is reduced to its
+    /// kHistogramBits most significant bits.
+    ///
+    /// @param red      [in] Red channel value [0, 255].
+    /// @param green    [in] Green channel value [0, 255].
+    /// @param blue     [in] Blue channel value [0, 255].
+    /// @return Index into Stats::histogram.
+    ///
+    constexpr int HistogramIndex(int red, int green, int blue) {
+        constexpr int shift = 8 - kHistogramBits;
+        return ((red >> shift) << (2 * kHistogramBits)) | ((green >> shift) << kHistogramBits) | (blue >> shift);
+    }
+
+    /// Calculates the statistics of the pixels in a buffer. The dominant
+    /// colors are found by median cut over the histogram: the box of bins
+    /// holding the most pixels is repeatedly split at the median of its
+    /// longest side, and each box is represented by the mean of its pixels.
+    /// The mean color and the dominant colors are named using
+    /// MeaColors::MatchExtendedColor.
+    ///
+    /// @param buffer       [in] Pixels to analyze.
+    /// @param numDominant  [in] Maximum number of dominant colors to find. Fewer are returned if the region has
+    ///                     fewer distinct histogram bins.
+    /// @param numWorkers   [in] Number of threads to use. Zero uses one thread per processor.
+    /// @return Statistics of the pixels. All values are zero for an empty buffer.
+    ///
+    Stats Calculate(const MeaPixelBuffer& buffer, int numDominant, int numWorkers = 0);
+}
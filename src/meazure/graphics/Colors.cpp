@@ -44,7 +44,7 @@ static Colors const defaultColors = {
 
 static Colors colors = defaultColors;
 
-static MeaColors::ColorTableEntry basicWebColors[] = {
+static constexpr MeaColors::ColorTableEntry basicWebColors[] = {
     { "black",      RGB(  0,   0,   0), MeaColors::RGBtoLab(RGB(  0,   0,   0)) },
     { "silver",     RGB(192, 192, 192), MeaColors::RGBtoLab(RGB(192, 192, 192)) },
     { "gray",       RGB(128, 128, 128), MeaColors::RGBtoLab(RGB(128, 128, 128)) },
@@ -64,7 +64,7 @@ static MeaColors::ColorTableEntry basicWebColors[] = {
     { nullptr,      0,                  MeaColors::Lab()                        },
 };
 
-static MeaColors::ColorTableEntry extendedWebColors[] = {
+static constexpr MeaColors::ColorTableEntry extendedWebColors[] = {
     { "aliceblue",              RGB(240, 248, 255), MeaColors::RGBtoLab(RGB(240, 248, 255)) },
     { "antiquewhite",           RGB(250, 235, 215), MeaColors::RGBtoLab(RGB(250, 235, 215)) },
     { "aqua",                   RGB(  0, 255, 255), MeaColors::RGBtoLab(RGB(  0, 255, 255)) },
@@ -209,6 +209,50 @@ static MeaColors::ColorTableEntry extendedWebColors[] = {
     { nullptr,                  0,                  MeaColors::Lab()                        },
 };
 
+/// Direct mapped cache of recent matches against a color table. Colors are typically the same over adjacent
+/// pixels, and the magnifier often alternates between a handful of colors, so most matches are found in the cache.
+/// Each thread has its own cache so that colors can be matched concurrently without locking.
+///
+class MatchCache {
+public:
+    /// Constructs a cache for the specified table. Every slot initially holds the first table entry, which is its
+    /// own closest match.
+    ///
+    /// @param table    [in] Color table to match against. Must have at least one entry.
+    ///
+    explicit MatchCache(const MeaColors::ColorTableEntry* table) : m_table(table) {
+        for (Slot& slot : m_slots) {
+            slot.rgb = table->rgb;
+            slot.entry = table;
+        }
+    }
+
+    /// Obtains the closest table entry for the specified color, from the cache if possible.
+    ///
+    /// @param rgb      [in] Color to match
+    /// @return Closest entry in the color table.
+    ///
+    const MeaColors::ColorTableEntry* Match(COLORREF rgb) {
+        Slot& slot = m_slots[static_cast<uint32_t>(rgb * 2654435761U) >> (32 - kSizeBits)];
+        if (slot.rgb != rgb) {
+            slot.entry = MeaColors::MatchColor(m_table, rgb);
+            slot.rgb = rgb;
+        }
+        return slot.entry;
+    }
+
+private:
+    static constexpr int kSizeBits { 8 };       ///< Log2 of the number of slots in the cache.
+
+    struct Slot {
+        COLORREF rgb;
+        const MeaColors::ColorTableEntry* entry;
+    };
+
+    const MeaColors::ColorTableEntry* m_table;  ///< Color table being matched.
+    Slot m_slots[1 << kSizeBits];               ///< Cached matches, indexed by a hash of the color.
+};
+
 
 void MeaColors::Reset() {
     colors = defaultColors;
@@ -298,7 +342,29 @@ COLORREF MeaColors::InterpolateColor(COLORREF startRGB, COLORREF endRGB, int per
     return HSLtoRGB(hsl);
 }
 
+/// Raises a value to the 7th power using multiplication, for the G factor and RC term of CIEDE2000.
+///
+/// @param x    [in] Value to raise to the 7th power
+/// @return x^7
+///
+static double Pow7(double x) {
+    double x2 = x * x;
+    return x2 * x2 * x2 * x;
+}
+
+MeaColors::PreparedLab MeaColors::PrepareLab(const Lab& color) {
+    PreparedLab prepared;
+    prepared.lab = color;
+    prepared.bSquared = color.b * color.b;
+    prepared.chroma = std::sqrt((color.a * color.a) + prepared.bSquared);
+    return prepared;
+}
+
 double MeaColors::ColorDifference(const MeaColors::Lab& color1, const MeaColors::Lab& color2) {
+    return ColorDifference(PrepareLab(color1), PrepareLab(color2));
+}
+
+double MeaColors::ColorDifference(const MeaColors::PreparedLab& prepared1, const MeaColors::PreparedLab& prepared2) {
     // This implementation of the CIEDE2000 algorithm follows the implementation notes in
     // https://hajim.rochester.edu/ece/sites/gsharma/ciede2000/ciede2000noteCRNA.pdf. Excerpts from this
     // paper and references to the equation numbers are included in the comments in this implementation.
@@ -308,26 +374,31 @@ double MeaColors::ColorDifference(const MeaColors::Lab& color1, const MeaColors:
     constexpr double deg360Rad = MeaNumericUtils::DegToRad(360.0);
     constexpr double deg180Rad = MeaNumericUtils::DegToRad(180.0);
     constexpr double deg30Rad = MeaNumericUtils::DegToRad(30.0);
-    constexpr double deg63Rad = MeaNumericUtils::DegToRad(63.0);
-    constexpr double deg6Rad = MeaNumericUtils::DegToRad(6.0);
     constexpr double deg25Rad = MeaNumericUtils::DegToRad(25.0);
     constexpr double deg275Rad = MeaNumericUtils::DegToRad(275.0);
+    constexpr double cos30 = 0.8660254037844387;
+    constexpr double sin30 = 0.5;
+    constexpr double cos6 = 0.9945218953682733;
+    constexpr double sin6 = 0.10452846326765347;
+    constexpr double cos63 = 0.4539904997395468;
+    constexpr double sin63 = 0.8910065241883678;
+
+    const Lab& color1 = prepared1.lab;
+    const Lab& color2 = prepared2.lab;
 
     //
     // Step 1
     //
 
-    // Equation 2
-    double b1Squared = color1.b * color1.b;
-    double b2Squared = color2.b * color2.b;
-    double c1 = std::sqrt((color1.a * color1.a) + b1Squared);
-    double c2 = std::sqrt((color2.a * color2.a) + b2Squared);
+    // Equation 2 (prepared)
+    double c1 = prepared1.chroma;
+    double c2 = prepared2.chroma;
 
     // Equation 3
     double cAve = (c1 + c2) / 2.0;
 
     // Equation 4
-    double cAvePow7 = std::pow(cAve, 7.0);
+    double cAvePow7 = Pow7(cAve);
     double g = 0.5 * (1.0 - std::sqrt(cAvePow7 / (cAvePow7 + pow25To7)));
 
     // Equation 5
@@ -335,8 +406,8 @@ double MeaColors::ColorDifference(const MeaColors::Lab& color1, const MeaColors:
     double aPrime2 = (1.0 + g) * color2.a;
 
     // Equation 6
-    double cPrime1 = std::sqrt((aPrime1 * aPrime1) + b1Squared);
-    double cPrime2 = std::sqrt((aPrime2 * aPrime2) + b2Squared);
+    double cPrime1 = std::sqrt((aPrime1 * aPrime1) + prepared1.bSquared);
+    double cPrime2 = std::sqrt((aPrime2 * aPrime2) + prepared2.bSquared);
 
     // Equation 7
     auto hueAngle = [deg360Rad](const Lab& color, double aPrime) {
@@ -415,22 +486,34 @@ double MeaColors::ColorDifference(const MeaColors::Lab& color1, const MeaColors:
     }
 
     // Equation 15
+    // The cosines of the multiples of the average hue are obtained from its sine and cosine using the double and
+    // triple angle identities, and the phase shifts are applied using the angle difference identities.
+    double cos1 = std::cos(hPrimeAve);
+    double sin1 = std::sin(hPrimeAve);
+    double cos2 = (2.0 * cos1 * cos1) - 1.0;
+    double sin2 = 2.0 * sin1 * cos1;
+    double cos3 = (cos2 * cos1) - (sin2 * sin1);
+    double sin3 = (sin2 * cos1) + (cos2 * sin1);
+    double cos4 = (2.0 * cos2 * cos2) - 1.0;
+    double sin4 = 2.0 * sin2 * cos2;
+
     double t = 1.0
-        - 0.17 * std::cos(hPrimeAve - deg30Rad)
-        + 0.24 * std::cos(2.0 * hPrimeAve)
-        + 0.32 * cos(3.0 * hPrimeAve + deg6Rad)
-        - 0.20 * std::cos(4.0 * hPrimeAve - deg63Rad);
+        - 0.17 * ((cos1 * cos30) + (sin1 * sin30))          // cos(h - 30)
+        + 0.24 * cos2                                       // cos(2h)
+        + 0.32 * ((cos3 * cos6) - (sin3 * sin6))            // cos(3h + 6)
+        - 0.20 * ((cos4 * cos63) + (sin4 * sin63));         // cos(4h - 63)
 
     // Equation 16
-    double deltaTheta = deg30Rad
-        * std::exp(-std::pow((hPrimeAve - deg275Rad) / deg25Rad, 2.0));
+    double hueOffset = (hPrimeAve - deg275Rad) / deg25Rad;
+    double deltaTheta = deg30Rad * std::exp(-(hueOffset * hueOffset));
 
     // Equation 17
-    double cPrimeAveTo7 = std::pow(cPrimeAve, 7.0);
+    double cPrimeAveTo7 = Pow7(cPrimeAve);
     double rc = 2.0 * std::sqrt(cPrimeAveTo7 / (cPrimeAveTo7 + pow25To7));
 
     // Equation 18
-    double lPrimeAveMinus50Squared = std::pow(lPrimeAve - 50.0, 2.0);
+    double lPrimeAveMinus50 = lPrimeAve - 50.0;
+    double lPrimeAveMinus50Squared = lPrimeAveMinus50 * lPrimeAveMinus50;
     double sl = 1.0 + 0.015 * lPrimeAveMinus50Squared / std::sqrt(20.0 + lPrimeAveMinus50Squared);
 
     // Equation 19
@@ -444,51 +527,115 @@ double MeaColors::ColorDifference(const MeaColors::Lab& color1, const MeaColors:
 
     // Equation 22
     // Use the reference conditions for the parametric weighting factors (i.e. kL=kC=kH=1.0).
-    return std::sqrt(std::pow(deltaLPrime / sl, 2.0)
-                     + std::pow(deltaCPrime / sc, 2.0)
-                     + std::pow(deltaHPrime / sh, 2.0)
-                     + rt * (deltaCPrime / sc) * (deltaHPrime / sh));
+    double lTerm = deltaLPrime / sl;
+    double cTerm = deltaCPrime / sc;
+    double hTerm = deltaHPrime / sh;
+    return std::sqrt((lTerm * lTerm) + (cTerm * cTerm) + (hTerm * hTerm) + (rt * cTerm * hTerm));
 }
 
-const MeaColors::ColorTableEntry* MeaColors::MatchBasicColor(COLORREF rgb) {
-    // Typically colors are the same over adjacent pixels so remember the last match.
-    static const ColorTableEntry* lastEntry = &basicWebColors[0];
-    static COLORREF lastColor = lastEntry->rgb;
+double MeaColors::ColorDifferenceLowerBound(const MeaColors::Lab& color1, const MeaColors::Lab& color2) {
+    return ColorDifferenceLowerBound(PrepareLab(color1), PrepareLab(color2));
+}
 
-    if (lastColor != rgb) {
-        lastEntry = MatchColor(basicWebColors, rgb);
-        lastColor = rgb;
-    }
+double MeaColors::ColorDifferenceLowerBound(const MeaColors::PreparedLab& prepared1,
+                                            const MeaColors::PreparedLab& prepared2) {
+    // The terms of Equation 22 are bounded as follows, using the equation numbers in ColorDifference:
+    //
+    // - The hue difference of Equation 11 satisfies deltaCPrime^2 + deltaHPrime^2 = deltaAPrime^2 + deltaB^2,
+    //   where aPrime = (1 + g) * a from Equation 5 (i.e. the chroma and hue differences together are the
+    //   Euclidean distance in the aPrime, b plane).
+    // - Because |aPrime| <= (1 + g) * |a|, the average cPrime is at most (1 + g) * cAve. Since T in Equation 15
+    //   is at most 1.93, sh <= sc <= 1 + 0.045 * (1 + g) * cAve.
+    // - The rotation angle in Equation 16 is at most 30 degrees, so |rt| <= sin(60) * rc, and rc increases with
+    //   the average cPrime. For any x and y, x^2 + y^2 + rt * x * y >= (1 - |rt| / 2) * (x^2 + y^2).
+    //
+    // A small amount is subtracted from the bound to cover the rounding differences between the two calculations.
+
+    constexpr double pow25To7 = 6103515625.0;     // 25^7
+    constexpr double sin60 = 0.86602540378443865;
+    constexpr double roundingMargin = 1e-9;
 
-    return lastEntry;
+    const Lab& color1 = prepared1.lab;
+    const Lab& color2 = prepared2.lab;
+
+    double cAve = (prepared1.chroma + prepared2.chroma) / 2.0;
+
+    double cAvePow7 = Pow7(cAve);
+    double g = 0.5 * (1.0 - std::sqrt(cAvePow7 / (cAvePow7 + pow25To7)));
+
+    double deltaAPrime = (1.0 + g) * (color2.a - color1.a);
+    double deltaB = color2.b - color1.b;
+
+    double cPrimeAveMax = (1.0 + g) * cAve;
+    double scMax = 1.0 + 0.045 * cPrimeAveMax;
+    double cPrimeAveMaxPow7 = Pow7(cPrimeAveMax);
+    double rcMax = 2.0 * std::sqrt(cPrimeAveMaxPow7 / (cPrimeAveMaxPow7 + pow25To7));
+    double rotationFactor = 1.0 - sin60 * rcMax / 2.0;
+
+    double deltaL = color2.l - color1.l;
+    double lAveMinus50 = (color1.l + color2.l) / 2.0 - 50.0;
+    double lAveMinus50Squared = lAveMinus50 * lAveMinus50;
+    double sl = 1.0 + 0.015 * lAveMinus50Squared / std::sqrt(20.0 + lAveMinus50Squared);
+
+    double boundSquared = (deltaL * deltaL) / (sl * sl)
+        + rotationFactor * ((deltaAPrime * deltaAPrime) + (deltaB * deltaB)) / (scMax * scMax);
+
+    boundSquared = boundSquared * (1.0 - roundingMargin) - roundingMargin;
+    return (boundSquared > 0.0) ? std::sqrt(boundSquared) : 0.0;
+}
+
+const MeaColors::ColorTableEntry* MeaColors::MatchBasicColor(COLORREF rgb) {
+    thread_local MatchCache cache(basicWebColors);
+    return cache.Match(rgb);
 }
 
 const MeaColors::ColorTableEntry* MeaColors::MatchExtendedColor(COLORREF rgb) {
-    // Typically colors are the same over adjacent pixels so remember the last match.
-    static const ColorTableEntry* lastEntry = &extendedWebColors[0];
-    static COLORREF lastColor = lastEntry->rgb;
+    thread_local MatchCache cache(extendedWebColors);
+    return cache.Match(rgb);
+}
 
-    if (lastColor != rgb) {
-        lastEntry = MatchColor(extendedWebColors, rgb);
-        lastColor = rgb;
+const MeaColors::ColorTableEntry* MeaColors::MatchColor(const ColorTableEntry* table, COLORREF rgb) {
+    if (table->name == nullptr) {
+        return nullptr;
     }
 
-    return lastEntry;
-}
+    for (const ColorTableEntry* entry = table; entry->name != nullptr; entry++) {
+        if (entry->rgb == rgb) {
+            return entry;
+        }
+    }
 
-const MeaColors::ColorTableEntry* MeaColors::MatchColor(const ColorTableEntry* table, COLORREF rgb) {
     Lab lab = RGBtoLab(rgb);
 
-    double minDiff = DBL_MAX;
-    const ColorTableEntry* bestEntry = nullptr;
+    // Start with the entry closest to the color in Euclidean L*a*b* distance (CIE76). That is usually the closest
+    // entry by CIEDE2000, or close to it, so the exact difference only needs to be computed for the few other
+    // entries whose lower bound does not exceed it. Equal differences are resolved in favor of the entry earliest
+    // in the table.
+    //
+    const ColorTableEntry* bestEntry = table;
+    double minDistSquared = DBL_MAX;
 
     for (const ColorTableEntry* entry = table; entry->name != nullptr; entry++) {
-        if (entry->rgb == rgb) {
-            return entry;
+        double deltaL = entry->lab.l - lab.l;
+        double deltaA = entry->lab.a - lab.a;
+        double deltaB = entry->lab.b - lab.b;
+        double distSquared = (deltaL * deltaL) + (deltaA * deltaA) + (deltaB * deltaB);
+        if (distSquared < minDistSquared) {
+            minDistSquared = distSquared;
+            bestEntry = entry;
         }
+    }
 
-        double diff = ColorDifference(entry->lab, lab);
-        if (diff < minDiff) {
+    PreparedLab query = PrepareLab(lab);
+    double minDiff = ColorDifference(bestEntry->prepared, query);
+
+    for (const ColorTableEntry* entry = table; entry->name != nullptr; entry++) {
+        if (entry == bestEntry || ColorDifferenceLowerBound(entry->prepared, query) > minDiff) {
+            continue;
+        }
+
+        double diff = ColorDifference(entry->prepared, query);
+        if (diff < minDiff || (diff == minDiff && entry < bestEntry)) {
             minDiff = diff;
             bestEntry = entry;
         }
@@ -497,6 +644,14 @@ const MeaColors::ColorTableEntry* MeaColors::MatchColor(const ColorTableEntry* t
     return bestEntry;
 }
 
+const MeaColors::ColorTableEntry* MeaColors::GetBasicColors() {
+    return basicWebColors;
+}
+
+const MeaColors::ColorTableEntry* MeaColors::GetExtendedColors() {
+    return extendedWebColors;
+}
+
 MeaColors::CMYK MeaColors::RGBtoCMYK(COLORREF rgb) {
     CMY cmy = RGBtoCMY(rgb);
     int black = std::min({ cmy.cyan, cmy.magenta, cmy.yellow });
@@ -604,6 +759,38 @@ COLORREF MeaColors::HSLtoRGB(const HSL& hsl) {
                static_cast<int>(std::round(b * 255.0)));
 }
 
+COLORREF MeaColors::LabtoRGB(const Lab& lab) {
+    // 1931 D65 2 degree illuminant reference.
+    //
+    constexpr double xref = 95.047;
+    constexpr double yref = 100.000;
+    constexpr double zref = 108.883;
+
+    constexpr double k = 903.3 / 116.0;
+    constexpr double m = 16.0 / 116.0;
+
+    auto inverseFunc = [k, m](double value) {
+        double cube = value * value * value;
+        return (cube > 0.008856) ? cube : (value - m) / k;
+    };
+
+    double fy = (lab.l + 16.0) / 116.0;
+    double x = inverseFunc(fy + lab.a / 500.0) * xref / 100.0;
+    double y = inverseFunc(fy) * yref / 100.0;
+    double z = inverseFunc(fy - lab.b / 200.0) * zref / 100.0;
+
+    auto companding = [](double value) {
+        value = std::clamp(value, 0.0, 1.0);
+        value = (value > 0.0031308) ? 1.055 * std::pow(value, 1.0 / 2.4) - 0.055 : 12.92 * value;
+        return static_cast<int>(std::round(value * 255.0));
+    };
+
+    int r = companding(x * 3.2404542 + y * -1.5371385 + z * -0.4985314);
+    int g = companding(x * -0.9692660 + y * 1.8760108 + z * 0.0415560);
+    int b = companding(x * 0.0556434 + y * -0.2040259 + z * 1.0572252);
+    return RGB(r, g, b);
+}
+
 MeaColors::YCbCr MeaColors::RGBtoYCbCr(COLORREF rgb) {
     double r = GetRValue(rgb);
     double g = GetGValue(rgb);
@@ -623,54 +810,3 @@ MeaColors::YIQ MeaColors::RGBtoYIQ(COLORREF rgb) {
     int q = static_cast<int>(std::round(0.212 * r - 0.523 * g + 0.311 * b));
     return YIQ(y, i, q);
 }
-
-MeaColors::XYZ MeaColors::RGBtoXYZ(COLORREF rgb) {
-    double r = GetRValue(rgb) / 255.0;
-    double g = GetGValue(rgb) / 255.0;
-    double b = GetBValue(rgb) / 255.0;
-
-    auto inverseCompanding = [](double value) {
-        return (value > 0.04045) ? std::pow((value + 0.055) / 1.055, 2.4) : value / 12.92;
-    };
-
-    r = 100.0 * inverseCompanding(r);
-    g = 100.0 * inverseCompanding(g);
-    b = 100.0 * inverseCompanding(b);
-
-    double x = r * 0.4124564 + g * 0.3575761 + b * 0.1804375;
-    double y = r * 0.2126729 + g * 0.7151522 + b * 0.0721750;
-    double z = r * 0.0193339 + g * 0.1191920 + b * 0.9503041;
-    return XYZ(x, y, z);
-}
-
-MeaColors::Lab MeaColors::XYZtoLab(const MeaColors::XYZ& xyz) {
-    // 1931 D65 2 degree illuminant reference.
-    //
-    constexpr double xref = 95.047;
-    constexpr double yref = 100.000;
-    constexpr double zref = 108.883;
-
-    constexpr double k = 903.3 / 116.0;
-    constexpr double m = 16.0 / 116.0;
-
-    double x = xyz.x / xref;
-    double y = xyz.y / yref;
-    double z = xyz.z / zref;
-
-    auto func = [k, m](double value) {
-        return (value > 0.008856) ? std::cbrt(value) : k * value + m;
-    };
-
-    x = func(x);
-    y = func(y);
-    z = func(z);
-
-    double l = (116.0 * y) - 16.0;
-    double a = 500.0 * (x - y);
-    double b = 200.0 * (y - z);
-    return Lab(l, a, b);
-}
-
-MeaColors::Lab MeaColors::RGBtoLab(COLORREF rgb) {
-    return XYZtoLab(RGBtoXYZ(rgb));
-}
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <meazure/profile/Profile.h>
+#include <meazure/utilities/NumericUtils.h>
 #include <map>
 
 // wingdi.h defines a CMYK macro.
@@ -118,6 +119,28 @@ namespace MeaColors {
         constexpr Lab(double lstar, double astar, double bstar) : l(lstar), a(astar), b(bstar) {}
     };
 
+    /// A CIE L*a*b* color together with the terms of the CIEDE2000 color difference that depend only on that color.
+    /// Preparing a color once avoids recalculating these terms each time the color is compared, such as for the
+    /// entries of a color table. Prepared colors are compared using the PreparedLab overload of ColorDifference.
+    ///
+    struct PreparedLab {
+        Lab lab;            ///< The color.
+        double bSquared;    ///< b* squared.
+        double chroma;      ///< Chroma, sqrt(a*^2 + b*^2) (Equation 2 of CIEDE2000).
+
+        constexpr PreparedLab() : lab(), bSquared(0.0), chroma(0.0) {}
+
+        /// Prepares a color at compile time. The chroma is calculated using MeaNumericUtils::NthRoot, which can
+        /// differ from std::sqrt in the last bit. Use PrepareLab to prepare a color at runtime.
+        ///
+        /// @param color    [in] Color to prepare.
+        ///
+        constexpr explicit PreparedLab(const Lab& color) :
+            lab(color),
+            bSquared(color.b * color.b),
+            chroma(MeaNumericUtils::NthRoot((color.a * color.a) + (color.b * color.b), 2)) {}
+    };
+
 
     /// Identifies the item whose color and opacity are maintained by this class.
     ///
@@ -139,6 +162,7 @@ namespace MeaColors {
         PCTSTR name;
         COLORREF rgb;
         Lab lab;
+        PreparedLab prepared { lab };       ///< The lab color prepared for ColorDifference.
     };
 
 
@@ -243,6 +267,44 @@ namespace MeaColors {
     ///
     double ColorDifference(const Lab& color1, const Lab& color2);
 
+    /// Calculates the CIEDE2000 difference between the two specified prepared colors. This is the same calculation
+    /// as the Lab overload, without recalculating the terms stored in the prepared colors.
+    ///
+    /// @param color1   [in] First color in the difference
+    /// @param color2   [in] Second color in the difference
+    /// @return A value representing the difference between the two specified colors. The smaller the difference,
+    ///     the visually closer the two colors. The value is never negative.
+    ///
+    double ColorDifference(const PreparedLab& color1, const PreparedLab& color2);
+
+    /// Calculates a lower bound on the CIEDE2000 difference between the two specified colors. The bound is the
+    /// Euclidean distance between the colors in the L*a'b* space of CIEDE2000, scaled by upper bounds on the
+    /// lightness, chroma and hue weighting functions and on the hue rotation term. It only requires a few square
+    /// roots, compared to the trigonometric and exponential functions needed by ColorDifference, and is used to rule
+    /// out colors that cannot be the closest match without computing their exact difference.
+    ///
+    /// @param color1   [in] First color in the difference
+    /// @param color2   [in] Second color in the difference
+    /// @return A value that is never greater than ColorDifference(color1, color2) and is never negative.
+    ///
+    double ColorDifferenceLowerBound(const Lab& color1, const Lab& color2);
+
+    /// Calculates a lower bound on the CIEDE2000 difference between the two specified prepared colors. See the Lab
+    /// overload.
+    ///
+    /// @param color1   [in] First color in the difference
+    /// @param color2   [in] Second color in the difference
+    /// @return A value that is never greater than ColorDifference(color1, color2) and is never negative.
+    ///
+    double ColorDifferenceLowerBound(const PreparedLab& color1, const PreparedLab& color2);
+
+    /// Prepares a color for ColorDifference at runtime.
+    ///
+    /// @param color    [in] Color to prepare
+    /// @return Prepared color.
+    ///
+    PreparedLab PrepareLab(const Lab& color);
+
     /// Attempts to match the specified color against the Web basic colors (https://en.wikipedia.org/wiki/Web_colors).
     /// The CIEDE2000 color difference algorithm is used to find the best match.
     /// 
@@ -268,6 +330,18 @@ namespace MeaColors {
     ///
     const ColorTableEntry* MatchColor(const ColorTableEntry* table, COLORREF rgb);
 
+    /// Returns the table of Web basic colors matched by MatchBasicColor.
+    ///
+    /// @return Basic color table. The last entry has a nullptr name.
+    ///
+    const ColorTableEntry* GetBasicColors();
+
+    /// Returns the table of Web extended colors matched by MatchExtendedColor.
+    ///
+    /// @return Extended color table. The last entry has a nullptr name.
+    ///
+    const ColorTableEntry* GetExtendedColors();
+
     /// Converts from the RGB color space to the Cyan (C), Magenta (M) and Yellow (Y) color space. The conversion is
     /// done using the algorithm for RGB to CMY conversion presented at http://www.easyrgb.com/en/math.php. The input
     /// and output range is [0, 255].
@@ -327,15 +401,50 @@ namespace MeaColors {
     /// 
     YIQ RGBtoYIQ(COLORREF rgb);
 
+    /// Linear sRGB values, scaled by 100.0, of each 8 bit color component. A component has only 256 possible values,
+    /// so its inverse sRGB companding is calculated once at compile time and looked up by RGBtoXYZ.
+    ///
+    struct LinearComponents {
+        double values[256];
+
+        constexpr LinearComponents() : values() {
+            for (int i = 0; i < 256; i++) {
+                double value = i / 255.0;
+                if (value > 0.04045) {
+                    // value^2.4 calculated as t^2 * (t^2)^(1/5) so that it can be evaluated at compile time.
+                    double t = (value + 0.055) / 1.055;
+                    value = t * t * MeaNumericUtils::NthRoot(t * t, 5);
+                } else {
+                    value = value / 12.92;
+                }
+                values[i] = 100.0 * value;
+            }
+        }
+    };
+
+    inline constexpr LinearComponents kLinearComponents;
+
     /// Converts from the RGB color space to the CIE 1931 XYZ color space. The conversion is done assuming inputs in
     /// the Standard RGB color space and a D65 2 degree standard illuminant. The input range is [0, 255]. The output is
     /// scaled by 100.0 resulting in the X range [0.0, 95.0470], Y [0.0, 100.0] and Z [0.0, 108.8830]. See
     /// http://www.brucelindbloom.com/index.html?Math.html and http://www.easyrgb.com/en/math.php for more information.
     /// 
+    /// The conversion is constexpr so that colors known at compile time, such as the Web color tables, are
+    /// converted by the compiler.
+    ///
     /// @param rgb      [in] RGB color
     /// @return XYZ color
     /// 
-    XYZ RGBtoXYZ(COLORREF rgb);
+    constexpr XYZ RGBtoXYZ(COLORREF rgb) {
+        double r = kLinearComponents.values[GetRValue(rgb)];
+        double g = kLinearComponents.values[GetGValue(rgb)];
+        double b = kLinearComponents.values[GetBValue(rgb)];
+
+        double x = r * 0.4124564 + g * 0.3575761 + b * 0.1804375;
+        double y = r * 0.2126729 + g * 0.7151522 + b * 0.0721750;
+        double z = r * 0.0193339 + g * 0.1191920 + b * 0.9503041;
+        return XYZ(x, y, z);
+    }
 
     /// Converts from the CIE 1931 XYZ color space to the CIE L*a*b* color space. The conversion is done assuming
     /// the Standard RGB color space and a D65 2 degree standard illuminant. The inputs are scaled XYZ with ranges
@@ -343,10 +452,34 @@ namespace MeaColors {
     /// and unbound for a and b. See http://www.brucelindbloom.com/index.html?Math.html and
     /// http://www.easyrgb.com/en/math.php for more information.
     /// 
+    /// The conversion is constexpr so that it can be evaluated at compile time.
+    ///
     /// @param xyz      [in] XYZ color
     /// @return L*a*b* color
     /// 
-    Lab XYZtoLab(const XYZ& xyz);
+    constexpr Lab XYZtoLab(const XYZ& xyz) {
+        // 1931 D65 2 degree illuminant reference.
+        //
+        constexpr double xref = 95.047;
+        constexpr double yref = 100.000;
+        constexpr double zref = 108.883;
+
+        constexpr double k = 903.3 / 116.0;
+        constexpr double m = 16.0 / 116.0;
+
+        auto func = [k, m](double value) {
+            return (value > 0.008856) ? MeaNumericUtils::NthRoot(value, 3) : k * value + m;
+        };
+
+        double x = func(xyz.x / xref);
+        double y = func(xyz.y / yref);
+        double z = func(xyz.z / zref);
+
+        double l = (116.0 * y) - 16.0;
+        double a = 500.0 * (x - y);
+        double b = 200.0 * (y - z);
+        return Lab(l, a, b);
+    }
 
     /// Converts the specified RGB color to the CIE L*a*b* color space. This is a convenience function which converts
     /// the RGB color to XYZ and then converts the XYZ value to Lab. See the RGBtoXYZ and XYZtoLab functions for
@@ -355,5 +488,15 @@ namespace MeaColors {
     /// @param rgb      [in] RGB color
     /// @return L*a*b* color
     /// 
-    Lab RGBtoLab(COLORREF rgb);
+    constexpr Lab RGBtoLab(COLORREF rgb) {
+        return XYZtoLab(RGBtoXYZ(rgb));
+    }
+
+    /// Converts the specified CIE L*a*b* color to the RGB color space. This is the inverse of RGBtoLab. L*a*b*
+    /// colors outside of the sRGB gamut are clamped to the nearest RGB component values.
+    ///
+    /// @param lab      [in] L*a*b* color
+    /// @return RGB color
+    ///
+    COLORREF LabtoRGB(const Lab& lab);
 };
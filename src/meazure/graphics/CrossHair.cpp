@@ -19,19 +19,20 @@
 
 #include <meazure/pch.h>
 #include "CrossHair.h"
-#include "Plotter.h"
 #include <meazure/resource.h>
 #include <meazure/ui/Layout.h>
 #define COMPILE_LAYERED_WINDOW_STUBS
 #include <meazure/ui/LayeredWindows.h>
 #include <cassert>
-#include <functional>
 
 
 CSize MeaCrossHair::m_size;
 CSize MeaCrossHair::m_halfSize;
 CSize MeaCrossHair::m_spread;
 UINT MeaCrossHair::m_flashInterval { 100 };
+CRgn MeaCrossHair::m_regionTemplate;
+const MeaCrossHairShape* MeaCrossHair::m_regionShape { nullptr };
+MeaCrossHair::RegionStats MeaCrossHair::m_regionStats { 0, 0 };
 
 
 BEGIN_MESSAGE_MAP(MeaCrossHair, MeaGraphic)
@@ -227,9 +228,6 @@ void MeaCrossHair::DestroyColors() {
 }
 
 void MeaCrossHair::SetRegion() {
-    POINT coords[4 * kTotalLayers];
-    POINT* coord = coords;
-
     // Each petal of the crosshair is made up of stacked rectangles.
     // Each rectangle is thk high by 2 * spread wide. Each rectangle
     // is called a layer.
@@ -245,17 +243,28 @@ void MeaCrossHair::SetRegion() {
     //          * *            |
     //           *             |
     //           * -------------
+    //
+    // All crosshairs share the same geometry, so the region is built
+    // once from the shared polygons and each window gets a copy.
+    //
+    const MeaCrossHairShape& shape = MeaCrossHairShape::Get(m_size, m_spread, kPetalLayers);
+
+    if (m_regionShape != &shape) {
+        m_regionTemplate.DeleteObject();
+        m_regionTemplate.CreatePolyPolygonRgn(const_cast<LPPOINT>(shape.GetPoints()),
+                                              const_cast<LPINT>(shape.GetPolyCounts()),
+                                              shape.GetPolyCount(), ALTERNATE);
+        m_regionShape = &shape;
+        m_regionStats.templates++;
+    }
 
-    std::function<void(int, int)> addPoint = [&](int x, int y) {
-        coord->x = x;
-        coord->y = y;
-        coord++;
-    };
-
-    MeaPlotter::PlotCrosshair(m_size, m_spread, kPetalLayers, addPoint);
+    CRgn region;
+    region.CreateRectRgn(0, 0, 0, 0);
+    region.CopyRgn(&m_regionTemplate);
+    m_regionStats.copies++;
 
-    HRGN region = ::CreatePolyPolygonRgn(coords, m_numCoords.data(), kTotalLayers, ALTERNATE);
-    SetWindowRgn(region, FALSE);
+    // The window owns the region once it is set.
+    SetWindowRgn(static_cast<HRGN>(region.Detach()), FALSE);
 }
 
 void MeaCrossHair::SetPosition(const POINT& center) {
@@ -23,9 +23,9 @@
 #pragma once
 
 #include "Graphic.h"
+#include "CrossHairShape.h"
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/units/UnitsProvider.h>
-#include <array>
 
 
 class MeaCrossHair;
@@ -106,6 +106,14 @@ public:
     static constexpr int kFlashCount { 9 };       ///< Number of times to flash the crosshair when Flash() is called
     static constexpr int kStrobeCount { 1 };      ///< Number of times to flash the crosshair when Strobe() is called
 
+    /// Counts of the window region constructions performed by all
+    /// crosshairs.
+    ///
+    struct RegionStats {
+        unsigned int templates;     ///< Number of times the region template was built from the crosshair polygons
+        unsigned int copies;        ///< Number of template copies handed to crosshair windows
+    };
+
 
     /// Constructs a crosshair. Prior to displaying the crosshair with
     /// the Show() method, the Create() method must be called to
@@ -186,6 +194,13 @@ public:
     ///
     void SetOpacity(BYTE opacity);
 
+    /// Obtains the number of window region constructions performed by
+    /// all crosshairs so far.
+    ///
+    /// @return Region construction counts.
+    ///
+    static const RegionStats& GetRegionStats() { return m_regionStats; }
+
     /// Relays messages to the crosshair's tooltip.
     ///
     /// @param pMsg     [in] Window message to relay
@@ -264,23 +279,15 @@ private:
         Inverted    ///< Draw the crosshair in its inverted appearance.
     };
 
-    static constexpr int kPetalLayers { 5 };
-    static constexpr int kTotalLayers { 4 * kPetalLayers };
-
-    static constexpr std::array<int, kTotalLayers> MakeNumCoords() noexcept {
-        std::array<int, kTotalLayers> arr {};
-        // The fill method is not constexpr until C++20
-        for (int i = 0; i < kTotalLayers; i++) {
-            arr[i] = 4;
-        }
-        return arr;
-    }
-    static inline const std::array<int, kTotalLayers> m_numCoords = MakeNumCoords();
+    static constexpr int kPetalLayers { 5 };    ///< Number of rectangles comprising a crosshair petal
 
     static CSize m_size;            ///< Width and height of the crosshair, in pixels
     static CSize m_halfSize;        ///< Half the width and height of the crosshair, in pixels
     static CSize m_spread;          ///< Half the length of the base of a triangular section of the crosshair, in pixels
     static UINT m_flashInterval;    ///< Number of milliseconds to hold each display state while flashing the crosshair
+    static CRgn m_regionTemplate;   ///< Crosshair region copied into each crosshair window
+    static const MeaCrossHairShape* m_regionShape;  ///< Shape from which the region template was built
+    static RegionStats m_regionStats;   ///< Region construction counts
 
     /// Given the center of the crosshair, returns the corresponding
     /// upper left corner.
@@ -294,7 +301,8 @@ private:
 
     /// Forms the window into the shape of the crosshair. A series of
     /// rectangular regions are aggregated together to form the four
-    /// petals of the crosshair.
+    /// petals of the crosshair. The region is built once for the
+    /// crosshair geometry and each window is given a copy of it.
     ///
     void SetRegion();
 
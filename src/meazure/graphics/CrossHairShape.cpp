@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "CrossHairShape.h"
+#include "Plotter.h"
+
+
+std::list<MeaCrossHairShape> MeaCrossHairShape::m_shapes;
+
+
+MeaCrossHairShape::MeaCrossHairShape(const SIZE& size, const SIZE& spread, int layers) :
+    m_size(size), m_spread(spread), m_layers(layers) {
+    m_points.reserve(16 * static_cast<std::size_t>(layers));
+
+    MeaPlotter::PlotCrosshair(size, spread, layers, [this](int x, int y) {
+        m_points.push_back({ x, y });
+    });
+
+    // Every layer is a rectangle.
+    m_polyCounts.assign(m_points.size() / 4, 4);
+}
+
+const MeaCrossHairShape& MeaCrossHairShape::Get(const SIZE& size, const SIZE& spread, int layers) {
+    for (const MeaCrossHairShape& shape : m_shapes) {
+        if (shape.IsShape(size, spread, layers)) {
+            return shape;
+        }
+    }
+
+    m_shapes.emplace_back(size, spread, layers);
+    return m_shapes.back();
+}
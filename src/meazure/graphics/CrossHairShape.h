@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Crosshair region polygon data header file.
+
+#pragma once
+
+#include <list>
+#include <vector>
+
+
+/// Polygon data for the window region of a crosshair. Each petal of the
+/// crosshair is made up of stacked rectangles, called layers, as plotted
+/// by MeaPlotter::PlotCrosshair. The polygons depend only on the crosshair
+/// geometry, which is the same for every crosshair at a given screen
+/// resolution and scaling, so they are computed once per geometry by
+/// Get() and shared by all crosshairs.
+///
+class MeaCrossHairShape {
+
+public:
+    /// Plots the polygons for a crosshair of the specified geometry.
+    ///
+    /// @param size     [in] Total size of the crosshair, in pixels
+    /// @param spread   [in] Half the width of a petal at its widest point, in pixels
+    /// @param layers   [in] Number of rectangles comprising a crosshair petal
+    ///
+    MeaCrossHairShape(const SIZE& size, const SIZE& spread, int layers);
+
+    /// Indicates whether the shape was plotted for the specified geometry.
+    ///
+    /// @param size     [in] Total size of the crosshair, in pixels
+    /// @param spread   [in] Half the width of a petal at its widest point, in pixels
+    /// @param layers   [in] Number of rectangles comprising a crosshair petal
+    ///
+    /// @return <b>true</b> if the shape has the specified geometry.
+    ///
+    bool IsShape(const SIZE& size, const SIZE& spread, int layers) const {
+        return m_size.cx == size.cx && m_size.cy == size.cy && m_spread.cx == spread.cx &&
+               m_spread.cy == spread.cy && m_layers == layers;
+    }
+
+    /// Obtains the vertices of all polygons, in the order expected by
+    /// CreatePolyPolygonRgn.
+    ///
+    /// @return Polygon vertices, in pixels relative to the top left corner of the crosshair.
+    ///
+    const POINT* GetPoints() const { return m_points.data(); }
+
+    /// Obtains the number of vertices in each polygon, in the order
+    /// expected by CreatePolyPolygonRgn.
+    ///
+    /// @return Number of vertices in each polygon.
+    ///
+    const INT* GetPolyCounts() const { return m_polyCounts.data(); }
+
+    /// Obtains the number of polygons. A petal has fewer than the requested
+    /// number of layers if its spread runs out first.
+    ///
+    /// @return Number of polygons.
+    ///
+    int GetPolyCount() const { return static_cast<int>(m_polyCounts.size()); }
+
+    /// Obtains the shared shape for the specified geometry. The shape is
+    /// plotted the first time a geometry is requested and the same object
+    /// is returned for subsequent requests.
+    ///
+    /// @param size     [in] Total size of the crosshair, in pixels
+    /// @param spread   [in] Half the width of a petal at its widest point, in pixels
+    /// @param layers   [in] Number of rectangles comprising a crosshair petal
+    ///
+    /// @return Shape for the geometry. The shape remains valid for the life of the program.
+    ///
+    static const MeaCrossHairShape& Get(const SIZE& size, const SIZE& spread, int layers);
+
+    /// Obtains the number of shapes plotted by Get() so far.
+    ///
+    /// @return Number of shapes plotted.
+    ///
+    static unsigned int GetPlotCount() { return static_cast<unsigned int>(m_shapes.size()); }
+
+private:
+    static std::list<MeaCrossHairShape> m_shapes;   ///< Shapes plotted by Get(), one per geometry
+
+    SIZE m_size;                        ///< Total size of the crosshair, in pixels
+    SIZE m_spread;                      ///< Half the width of a petal at its widest point, in pixels
+    int m_layers;                       ///< Number of rectangles comprising a crosshair petal
+    std::vector<POINT> m_points;        ///< Vertices of all polygons
+    std::vector<INT> m_polyCounts;      ///< Number of vertices in each polygon
+};
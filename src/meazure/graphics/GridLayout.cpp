@@ -0,0 +1,75 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "GridLayout.h"
+#include <cassert>
+
+
+void MeaGridLayout::CalcLines(int origin, int limit, int spacing, int spanStart, int spanEnd,
+                              std::vector<int>& lines) {
+    assert(spacing > 0);
+
+    lines.clear();
+
+    int pos = origin;
+    if (spanStart > origin) {
+        // Round up to the first grid line at or after the start of the span.
+        pos += ((spanStart - origin + spacing - 1) / spacing) * spacing;
+    }
+
+    for (int end = (limit < spanEnd - 1) ? limit : spanEnd - 1; pos <= end; pos += spacing) {
+        lines.push_back(pos - spanStart);
+    }
+}
+
+void MeaGridLayout::CalcRects(const RECT& virtualRect, const SIZE& spacing, const RECT& screenRect,
+                              std::vector<RECT>& rects) {
+    rects.clear();
+
+    std::vector<int> rows;
+    std::vector<int> columns;
+    CalcLines(virtualRect.top, virtualRect.bottom, spacing.cy, screenRect.top, screenRect.bottom, rows);
+    CalcLines(virtualRect.left, virtualRect.right, spacing.cx, screenRect.left, screenRect.right, columns);
+
+    const int width = screenRect.right - screenRect.left;
+    const int height = screenRect.bottom - screenRect.top;
+
+    // Where horizontal and vertical lines cross, the horizontal line takes the
+    // whole row. The vertical lines are broken into segments that fill the
+    // bands between the horizontal lines.
+    //
+    auto addBand = [&rects, &columns](int top, int bottom) {
+        if (top < bottom) {
+            for (int x : columns) {
+                rects.push_back({ x, top, x + 1, bottom });
+            }
+        }
+    };
+
+    rects.reserve(rows.size() + (rows.size() + 1) * columns.size());
+
+    int top = 0;
+    for (int y : rows) {
+        addBand(top, y);
+        rects.push_back({ 0, y, width, y + 1 });
+        top = y + 1;
+    }
+    addBand(top, height);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Layout of the screen grid lines.
+
+#pragma once
+
+#include <vector>
+
+
+/// Calculates where the lines of the screen grid fall. The grid is anchored
+/// at the top left corner of the virtual screen, with a horizontal line every
+/// spacing.cy pixels and a vertical line every spacing.cx pixels, up to and
+/// including the bottom and right edges of the virtual screen. Each line is
+/// one pixel thick and spans the entire virtual screen.
+///
+namespace MeaGridLayout {
+
+    /// Calculates the location of the grid lines along one axis that fall
+    /// within a span of that axis.
+    ///
+    /// @param origin       [in] Location of the first grid line, in pixels.
+    /// @param limit        [in] Location beyond which there are no more grid lines, inclusive, in pixels.
+    /// @param spacing      [in] Distance between grid lines, in pixels. Must be 1 or greater.
+    /// @param spanStart    [in] Start of the span, inclusive, in pixels.
+    /// @param spanEnd      [in] End of the span, exclusive, in pixels.
+    /// @param lines        [out] Locations of the grid lines in the span, in increasing order, relative to
+    ///                     spanStart. Any previous contents are replaced.
+    ///
+    void CalcLines(int origin, int limit, int spacing, int spanStart, int spanEnd, std::vector<int>& lines);
+
+    /// Calculates the rectangles covering the grid lines that cross a screen. The rectangles are relative to the
+    /// top left corner of the screen, do not overlap, and are sorted top to bottom and then left to right in bands
+    /// of equal height. This is the form required of the rectangles in the RGNDATA structure used to create a
+    /// window region with ExtCreateRegion.
+    ///
+    /// @param virtualRect  [in] Virtual screen rectangle on which the grid is anchored, in pixels.
+    /// @param spacing      [in] Horizontal and vertical grid spacing, in pixels. Must be 1 or greater.
+    /// @param screenRect   [in] Screen rectangle, in pixels.
+    /// @param rects        [out] Rectangles covering the grid lines. Any previous contents are replaced.
+    ///
+    void CalcRects(const RECT& virtualRect, const SIZE& spacing, const RECT& screenRect, std::vector<RECT>& rects);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "GridOverlay.h"
+#include "GridLayout.h"
+#include "Colors.h"
+#include <meazure/ui/LayeredWindows.h>
+#include <cassert>
+#include <cstring>
+
+
+MeaGridOverlay::MeaGridOverlay() :
+    MeaGraphic(),
+    m_screenRect(0, 0, 0, 0),
+    m_foreBrush(new CBrush(MeaColors::Get(MeaColors::LineFore))) {}
+
+MeaGridOverlay::~MeaGridOverlay() {
+    try {
+        delete m_foreBrush;
+    } catch (...) {
+        assert(false);
+    }
+}
+
+bool MeaGridOverlay::Create() {
+    CString wndClass = AfxRegisterWndClass(CS_HREDRAW | CS_VREDRAW, nullptr, *m_foreBrush);
+
+    if (!MeaGraphic::Create(wndClass, CSize(0, 0), nullptr)) {
+        return false;
+    }
+
+    // A fully opaque layered window that is transparent to the mouse lets
+    // clicks on the grid lines fall through to the windows below.
+    //
+    if (HaveLayeredWindows()) {
+        ModifyStyleEx(0, WS_EX_LAYERED | WS_EX_TRANSPARENT);
+        SetLayeredWindowAttributes(*this, 0, 255, LWA_ALPHA);
+    }
+
+    return true;
+}
+
+void MeaGridOverlay::SetGrid(const RECT& screenRect, const RECT& virtualRect, const SIZE& spacing) {
+    if (m_hWnd == nullptr) {
+        return;
+    }
+
+    MeaGridLayout::CalcRects(virtualRect, spacing, screenRect, m_rects);
+
+    // Build the region in a single call from the banded rectangles rather
+    // than combining a region for each line.
+    //
+    const std::size_t rectsSize = m_rects.size() * sizeof(RECT);
+    m_regionData.resize(sizeof(RGNDATAHEADER) + rectsSize);
+
+    RGNDATA* data = reinterpret_cast<RGNDATA*>(m_regionData.data());
+    data->rdh.dwSize = sizeof(RGNDATAHEADER);
+    data->rdh.iType = RDH_RECTANGLES;
+    data->rdh.nCount = static_cast<DWORD>(m_rects.size());
+    data->rdh.nRgnSize = static_cast<DWORD>(rectsSize);
+    ::SetRect(&data->rdh.rcBound, 0, 0, screenRect.right - screenRect.left, screenRect.bottom - screenRect.top);
+    if (!m_rects.empty()) {
+        std::memcpy(data->Buffer, m_rects.data(), rectsSize);
+    }
+
+    HRGN region = ::ExtCreateRegion(nullptr, static_cast<DWORD>(m_regionData.size()), data);
+    if (region == nullptr) {
+        return;
+    }
+
+    if (m_screenRect != screenRect) {
+        m_screenRect = screenRect;
+        SetWindowRgn(region, FALSE);
+        SetWindowPos(nullptr, m_screenRect.left, m_screenRect.top, m_screenRect.Width(), m_screenRect.Height(),
+                     SWP_NOACTIVATE | SWP_NOZORDER);
+    } else {
+        SetWindowRgn(region, TRUE);
+    }
+}
+
+void MeaGridOverlay::SetColor(COLORREF color) {
+    CBrush* brush = new CBrush(color);
+    if (m_hWnd != nullptr) {
+        ::SetClassLongPtr(m_hWnd, GCLP_HBRBACKGROUND,
+                        reinterpret_cast<LONG_PTR>(static_cast<HBRUSH>(*brush)));
+    }
+
+    delete m_foreBrush;
+    m_foreBrush = brush;
+
+    if (m_hWnd != nullptr) {
+        Invalidate();
+        UpdateWindow();
+    }
+}
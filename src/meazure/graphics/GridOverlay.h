@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Screen grid overlay graphic header file.
+
+#pragma once
+
+#include "Graphic.h"
+#include <vector>
+
+
+/// Draws the screen grid lines that cross one screen. Rather than using a
+/// window for each grid line, a single window covers the screen and its
+/// window region is shaped to the grid lines. The region is built from the
+/// rectangles calculated by MeaGridLayout::CalcRects. Where layered windows
+/// are available, the window is made transparent to the mouse so that
+/// clicks on the grid lines pass through to the windows below.
+///
+class MeaGridOverlay : public MeaGraphic {
+
+public:
+    /// Constructs a grid overlay. Prior to displaying the overlay with the
+    /// Show() method, the Create() method must be called to create the
+    /// overlay's window.
+    ///
+    MeaGridOverlay();
+
+    /// Destroys the grid overlay.
+    ///
+    virtual ~MeaGridOverlay();
+
+    /// Creates the window for the overlay. This method must be called
+    /// before the overlay can be displayed and before any operation that
+    /// attempts to manipulate the overlay's window. The overlay is created
+    /// as a popup window (<b>WS_POPUP</b>) and is assigned the main window
+    /// as a parent.
+    ///
+    /// @return <b>true</b> if the window is created successfully.
+    ///
+    bool Create();
+
+    /// Positions the overlay over a screen and shapes it to the grid lines
+    /// that cross that screen.
+    ///
+    /// @param screenRect   [in] Screen rectangle covered by the overlay, in pixels.
+    /// @param virtualRect  [in] Virtual screen rectangle on which the grid is anchored, in pixels.
+    /// @param spacing      [in] Horizontal and vertical grid spacing, in pixels.
+    ///
+    void SetGrid(const RECT& screenRect, const RECT& virtualRect, const SIZE& spacing);
+
+    /// Sets the color of the grid lines.
+    ///
+    /// @param color    [in] Color value defined by the Windows GDI RGB macro.
+    ///
+    void SetColor(COLORREF color);
+
+private:
+    /// Copy constructor is purposely undefined.
+    ///
+    MeaGridOverlay(const MeaGridOverlay&);
+
+    /// Assignment operator is purposely undefined
+    ///
+    MeaGridOverlay& operator=(const MeaGridOverlay&);
+
+
+    CRect m_screenRect;                 ///< Screen rectangle currently covered by the overlay, in pixels
+    CBrush* m_foreBrush;                ///< Brush used to draw the grid lines
+    std::vector<RECT> m_rects;          ///< Rectangles forming the window region, reused between updates
+    std::vector<BYTE> m_regionData;     ///< RGNDATA buffer for creating the window region, reused between updates
+};
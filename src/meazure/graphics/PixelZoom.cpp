@@ -0,0 +1,275 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <meazure/pch.h>
+#include "PixelZoom.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+ /// SSE2 instructions are available for the pixel replication kernels.
+#define MEA_PIXELZOOM_SSE2 1
+#include <emmintrin.h>
+#endif
+
+
+namespace {
+
+    /// Divides and rounds towards negative infinity.
+    ///
+    /// @param a    [in] Dividend.
+    /// @param b    [in] Divisor, must be positive.
+    ///
+    /// @return Quotient rounded down.
+    ///
+    int FloorDiv(int a, int b) {
+        return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+    }
+
+    /// Divides and rounds towards positive infinity.
+    ///
+    /// @param a    [in] Dividend.
+    /// @param b    [in] Divisor, must be positive.
+    ///
+    /// @return Quotient rounded up.
+    ///
+    int CeilDiv(int a, int b) {
+        return -FloorDiv(-a, b);
+    }
+
+    /// Replicates each source pixel kFactor times. Specialized for the
+    /// magnifier's zoom factors of 4 and greater.
+    ///
+    /// @tparam kFactor     Number of copies of each pixel.
+    /// @param src          [in] Pixels to replicate.
+    /// @param count        [in] Number of source pixels.
+    /// @param dst          [out] Replicated pixels, count * kFactor in total.
+    ///
+    template <int kFactor>
+    void ReplicateWide(const uint32_t* src, int count, uint32_t* dst) {
+        for (int i = 0; i < count; i++, dst += kFactor) {
+#ifdef MEA_PIXELZOOM_SSE2
+            const __m128i pixel = _mm_set1_epi32(static_cast<int>(src[i]));
+            for (int k = 0; k + 4 <= kFactor; k += 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), pixel);
+            }
+            if ((kFactor & 2) != 0) {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (kFactor & ~3)), pixel);
+            }
+            if ((kFactor & 1) != 0) {
+                dst[kFactor - 1] = src[i];
+            }
+#else
+            std::fill_n(dst, kFactor, src[i]);
+#endif
+        }
+    }
+
+    /// Replicates each source pixel twice.
+    ///
+    void Replicate2(const uint32_t* src, int count, uint32_t* dst) {
+        int i = 0;
+#ifdef MEA_PIXELZOOM_SSE2
+        for (; i + 4 <= count; i += 4, dst += 8) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi32(pixels, pixels));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_unpackhi_epi32(pixels, pixels));
+        }
+#endif
+        for (; i < count; i++, dst += 2) {
+            dst[0] = src[i];
+            dst[1] = src[i];
+        }
+    }
+
+    /// Replicates each source pixel three times.
+    ///
+    void Replicate3(const uint32_t* src, int count, uint32_t* dst) {
+        int i = 0;
+#ifdef MEA_PIXELZOOM_SSE2
+        for (; i + 4 <= count; i += 4, dst += 12) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 0, 0, 0)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(2, 2, 1, 1)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(3, 3, 3, 2)));
+        }
+#endif
+        for (; i < count; i++, dst += 3) {
+            dst[0] = src[i];
+            dst[1] = src[i];
+            dst[2] = src[i];
+        }
+    }
+
+    /// Replicates each source pixel the specified number of times, selecting
+    /// a kernel specialized for the factor when one is available.
+    ///
+    /// @param src      [in] Pixels to replicate.
+    /// @param count    [in] Number of source pixels.
+    /// @param dst      [out] Replicated pixels, count * factor in total.
+    /// @param factor   [in] Number of copies of each pixel.
+    ///
+    void Replicate(const uint32_t* src, int count, uint32_t* dst, int factor) {
+        switch (factor) {
+        case 1:
+            memcpy(dst, src, count * sizeof(uint32_t));
+            break;
+        case 2:
+            Replicate2(src, count, dst);
+            break;
+        case 3:
+            Replicate3(src, count, dst);
+            break;
+        case 4:
+            ReplicateWide<4>(src, count, dst);
+            break;
+        case 6:
+            ReplicateWide<6>(src, count, dst);
+            break;
+        case 8:
+            ReplicateWide<8>(src, count, dst);
+            break;
+        case 16:
+            ReplicateWide<16>(src, count, dst);
+            break;
+        case 32:
+            ReplicateWide<32>(src, count, dst);
+            break;
+        default:
+            for (int i = 0; i < count; i++, dst += factor) {
+                std::fill_n(dst, factor, src[i]);
+            }
+            break;
+        }
+    }
+
+    /// Zooms one row of source pixels into a destination row, clipping the
+    /// zoomed row to the destination and filling the remainder with black.
+    ///
+    /// @param src          [in] Source row.
+    /// @param srcWidth     [in] Number of pixels in the source row.
+    /// @param dst          [out] Destination row.
+    /// @param dstWidth     [in] Number of pixels in the destination row.
+    /// @param factor       [in] Zoom factor.
+    /// @param offsetX      [in] Destination x coordinate of the left edge of source pixel 0.
+    ///
+    void ZoomRow(const uint32_t* src, int srcWidth, uint32_t* dst, int dstWidth, int factor, int offsetX) {
+        int x = std::min(std::max(offsetX, 0), dstWidth);
+        std::fill_n(dst, x, MeaPixelZoom::kBlack);
+
+        int sx = FloorDiv(x - offsetX, factor);
+        int phase = (x - offsetX) - sx * factor;
+
+        // Partial cell clipped by the left edge of the destination.
+        if (phase != 0 && sx < srcWidth && x < dstWidth) {
+            int n = std::min(factor - phase, dstWidth - x);
+            std::fill_n(dst + x, n, src[sx]);
+            x += n;
+            sx++;
+        }
+
+        // Whole cells.
+        if (sx < srcWidth) {
+            int count = std::min(srcWidth - sx, (dstWidth - x) / factor);
+            Replicate(src + sx, count, dst + x, factor);
+            x += count * factor;
+            sx += count;
+        }
+
+        // Partial cell clipped by the right edge of the destination.
+        if (sx < srcWidth && x < dstWidth) {
+            int n = std::min(factor, dstWidth - x);
+            std::fill_n(dst + x, n, src[sx]);
+            x += n;
+        }
+
+        std::fill_n(dst + x, dstWidth - x, MeaPixelZoom::kBlack);
+    }
+}
+
+
+MeaPixelZoom::Layout MeaPixelZoom::CenterLayout(int dstWidth, int dstHeight, int factor) {
+    assert(factor >= 1);
+
+    Layout layout;
+
+    layout.cellX = FloorDiv(dstWidth - factor, 2);
+    layout.cellY = FloorDiv(dstHeight - factor, 2);
+    layout.centerX = std::max(CeilDiv(layout.cellX, factor), 0);
+    layout.centerY = std::max(CeilDiv(layout.cellY, factor), 0);
+    layout.srcWidth = layout.centerX + 1 + std::max(CeilDiv(dstWidth - layout.cellX - factor, factor), 0);
+    layout.srcHeight = layout.centerY + 1 + std::max(CeilDiv(dstHeight - layout.cellY - factor, factor), 0);
+    layout.offsetX = layout.cellX - layout.centerX * factor;
+    layout.offsetY = layout.cellY - layout.centerY * factor;
+
+    return layout;
+}
+
+void MeaPixelZoom::Zoom(const MeaPixelBuffer& src, const MeaPixelBuffer& dst, int factor, int offsetX, int offsetY,
+                        bool showGrid, uint32_t gridColor) {
+    assert(factor >= 1);
+
+    if (dst.width <= 0) {
+        return;
+    }
+
+    // Destination rows within the same cell are identical, apart from the
+    // grid line along the top of the cell, so each distinct row is zoomed
+    // once and copied to the rest of the cell.
+    //
+    const int gridX = offsetX - FloorDiv(offsetX, factor) * factor;
+    const int kBlackRow = -1;
+    const uint32_t* prevRow = nullptr;
+    int prevSrcRow = kBlackRow;
+
+    for (int y = 0; y < dst.height; y++) {
+        uint32_t* dstRow = dst.pixels + static_cast<std::ptrdiff_t>(y) * dst.stride;
+        int sy = FloorDiv(y - offsetY, factor);
+
+        if (showGrid && (y - offsetY) == sy * factor) {
+            std::fill_n(dstRow, dst.width, gridColor);
+            continue;
+        }
+
+        int srcRow = (sy >= 0 && sy < src.height) ? sy : kBlackRow;
+        if (prevRow != nullptr && srcRow == prevSrcRow) {
+            memcpy(dstRow, prevRow, dst.width * sizeof(uint32_t));
+            continue;
+        }
+
+        if (srcRow == kBlackRow) {
+            std::fill_n(dstRow, dst.width, kBlack);
+        } else {
+            ZoomRow(src.pixels + static_cast<std::ptrdiff_t>(srcRow) * src.stride, src.width, dstRow, dst.width, factor,
+                    offsetX);
+        }
+
+        if (showGrid) {
+            for (int x = gridX; x < dst.width; x += factor) {
+                dstRow[x] = gridColor;
+            }
+        }
+
+        prevRow = dstRow;
+        prevSrcRow = srcRow;
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Integer zoom of 32 bit pixel buffers for the magnifier.
+
+#pragma once
+
+#include <cstdint>
+
+
+/// A view of a rectangular array of 32 bit pixels, such as the bits of a
+/// DIB section. The pixels are stored top-down, row by row. The pixel
+/// format is not interpreted, except that zero is treated as black (e.g.
+/// 0x00RRGGBB as stored in a 32 bit DIB).
+///
+struct MeaPixelBuffer {
+    uint32_t* pixels;       ///< First pixel of the top row.
+    int width;              ///< Width of the buffer, in pixels.
+    int height;             ///< Height of the buffer, in pixels.
+    int stride;             ///< Distance between the start of consecutive rows, in pixels.
+};
+
+
+/// Nearest neighbor magnification by an integer zoom factor. Each source
+/// pixel is replicated into a square cell of factor by factor destination
+/// pixels. The zoomed image can be placed anywhere in the destination, with
+/// destination pixels outside of the zoomed image set to black. An optional
+/// one pixel grid can be composited along the top and left edge of every
+/// cell. Row replication uses SSE2 when available.
+///
+namespace MeaPixelZoom {
+
+    constexpr uint32_t kBlack = 0;      ///< Color of the destination outside the zoomed image.
+
+    /// Placement of a zoomed image so that a center source pixel appears in
+    /// the center of the destination, and the destination is covered by
+    /// whole or partial cells.
+    ///
+    struct Layout {
+        int srcWidth;       ///< Number of source pixels needed horizontally.
+        int srcHeight;      ///< Number of source pixels needed vertically.
+        int centerX;        ///< Horizontal index of the center pixel in the source.
+        int centerY;        ///< Vertical index of the center pixel in the source.
+        int offsetX;        ///< Destination x coordinate of the left edge of source pixel 0 (may be negative).
+        int offsetY;        ///< Destination y coordinate of the top edge of source pixel 0 (may be negative).
+        int cellX;          ///< Destination x coordinate of the left edge of the center pixel's cell.
+        int cellY;          ///< Destination y coordinate of the top edge of the center pixel's cell.
+    };
+
+    /// Calculates the source size and placement needed to center a zoomed
+    /// image in the destination.
+    ///
+    /// @param dstWidth     [in] Width of the destination, in pixels.
+    /// @param dstHeight    [in] Height of the destination, in pixels.
+    /// @param factor       [in] Zoom factor, must be 1 or greater.
+    ///
+    /// @return Layout of the zoomed image.
+    ///
+    Layout CenterLayout(int dstWidth, int dstHeight, int factor);
+
+    /// Zooms the source pixels into the destination. The destination pixel
+    /// at (x, y) receives the source pixel at ((x - offsetX) / factor,
+    /// (y - offsetY) / factor), rounded towards negative infinity, or black
+    /// if that is outside of the source.
+    ///
+    /// @param src          [in] Source pixels. Must not overlap the destination.
+    /// @param dst          [in] Destination pixels.
+    /// @param factor       [in] Zoom factor, must be 1 or greater.
+    /// @param offsetX      [in] Destination x coordinate of the left edge of source pixel 0.
+    /// @param offsetY      [in] Destination y coordinate of the top edge of source pixel 0.
+    /// @param showGrid     [in] Indicates whether to draw a grid line along the top and left edge of each cell,
+    ///                     extended across the entire destination.
+    /// @param gridColor    [in] Color of the grid lines.
+    ///
+    void Zoom(const MeaPixelBuffer& src, const MeaPixelBuffer& dst, int factor, int offsetX, int offsetY,
+              bool showGrid, uint32_t gridColor = kBlack);
+}
@@ -40,6 +40,7 @@ MeaRuler::MeaRuler(const MeaScreenProvider& screenProvider, const MeaUnitsProvid
     MeaGraphic(),
     m_screenProvider(screenProvider),
     m_unitsProvider(unitsProvider),
+    m_ticks(unitsProvider),
     m_borderColor(0),
     m_backColor(0),
     m_callback(nullptr),
@@ -337,16 +338,12 @@ void MeaRuler::DrawRuler(CDC& dc) {
         DrawIndicator(static_cast<IndicatorId>(indId), dc);
     }
 
-    // Draw tick marks and labels
-    // 
-    MeaLinearUnits* units = m_unitsProvider.GetLinearUnits();
-    int majorTickCount = m_unitsProvider.GetMajorTickCount();
-    double p;
-    bool isMajorTick, isExact;
-    int tick, x, xa, xb, y, ya, yb;
-    int tickHeight;
-
+    // Draw tick marks and labels. The tick layout is cached across paints and only
+    // recomputed when the units, resolution, origin or ruler extent change.
+    //
     MeaFSize minorIncr = m_unitsProvider.GetMinorIncr(winRect);
+    int majorTickCount = m_unitsProvider.GetMajorTickCount();
+    MeaRulerTicks::TickIter tickIter, tickEnd;
 
     // Determine the blending colors for non-pixel aligned hash mark placement.
     //
@@ -364,101 +361,95 @@ void MeaRuler::DrawRuler(CDC& dc) {
     if (m_labelPosition == Left || m_labelPosition == Right) {
         CFont* oldFont = dc.SelectObject(&m_vFont);
 
-        do {
-            for (p = 0.0, tick = 0, y = static_cast<int>(units->UnconvertCoord(MeaConvertY, this, p));
-                    y >= virtRect.top && y < virtRect.bottom;
-                    p += minorIncr.cy, tick++, y = static_cast<int>(units->UnconvertCoord(MeaConvertY, this, p))) {
-
-                if (y >= winRect.top && y < winRect.bottom) {
-                    isMajorTick = ((tick % majorTickCount) == 0);
-                    tickHeight = isMajorTick ? m_majorTickHeight.cx : m_minorTickHeight.cx;
-                    isExact = units->UnconvertCoord(MeaConvertY, this, p, ya, yb);
-
-                    MeaLayout::ScreenToClientY(*this, y);
-                    MeaLayout::ScreenToClientY(*this, ya);
-                    MeaLayout::ScreenToClientY(*this, yb);
-
-                    CPen* oldPen = dc.SelectObject(isExact ? &pen : &pen1);
-
-                    if (m_labelPosition == Left) {
-                        dc.MoveTo(clientRect.right, ya);
-                        dc.LineTo(clientRect.right - tickHeight, ya);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(clientRect.right, yb);
-                            dc.LineTo(clientRect.right - tickHeight, yb);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(clientRect.left + m_margin.cx, y, m_unitsProvider.Format(MeaY, p));
-                        }
-                    } else {
-                        dc.MoveTo(clientRect.left, ya);
-                        dc.LineTo(clientRect.left + tickHeight, ya);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(clientRect.left, yb);
-                            dc.LineTo(clientRect.left + tickHeight, yb);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(clientRect.left + tickHeight + m_margin.cx, y, m_unitsProvider.Format(MeaY, p));
-                        }
-                    }
-
-                    dc.SelectObject(oldPen);
+        m_ticks.Update(MeaConvertY, this, minorIncr.cy, majorTickCount, virtRect.top, virtRect.bottom);
+        m_ticks.GetTicks(winRect.top, winRect.bottom, tickIter, tickEnd);
+
+        for (; tickIter != tickEnd; ++tickIter) {
+            const MeaRulerTicks::Tick& tick = *tickIter;
+            int tickHeight = tick.major ? m_majorTickHeight.cx : m_minorTickHeight.cx;
+            int y = tick.pos;
+            int ya = tick.pos1;
+            int yb = tick.pos2;
+
+            MeaLayout::ScreenToClientY(*this, y);
+            MeaLayout::ScreenToClientY(*this, ya);
+            MeaLayout::ScreenToClientY(*this, yb);
+
+            CPen* oldPen = dc.SelectObject(tick.exact ? &pen : &pen1);
+
+            if (m_labelPosition == Left) {
+                dc.MoveTo(clientRect.right, ya);
+                dc.LineTo(clientRect.right - tickHeight, ya);
+                if (!tick.exact) {
+                    dc.SelectObject(&pen2);
+                    dc.MoveTo(clientRect.right, yb);
+                    dc.LineTo(clientRect.right - tickHeight, yb);
+                }
+                if (tick.major) {
+                    dc.TextOut(clientRect.left + m_margin.cx, y, tick.label);
+                }
+            } else {
+                dc.MoveTo(clientRect.left, ya);
+                dc.LineTo(clientRect.left + tickHeight, ya);
+                if (!tick.exact) {
+                    dc.SelectObject(&pen2);
+                    dc.MoveTo(clientRect.left, yb);
+                    dc.LineTo(clientRect.left + tickHeight, yb);
+                }
+                if (tick.major) {
+                    dc.TextOut(clientRect.left + tickHeight + m_margin.cx, y, tick.label);
                 }
             }
-            minorIncr.cy = -minorIncr.cy;
-        } while (minorIncr.cy < 0);
+
+            dc.SelectObject(oldPen);
+        }
 
         dc.SelectObject(oldFont);
     } else {
         CFont* oldFont = dc.SelectObject(&m_hFont);
 
-        do {
-            for (p = 0.0, tick = 0, x = static_cast<int>(units->UnconvertCoord(MeaConvertX, this, p));
-                    x >= virtRect.left && x < virtRect.right;
-                    p += minorIncr.cx, tick++, x = static_cast<int>(units->UnconvertCoord(MeaConvertX, this, p))) {
-
-                if (x >= winRect.left && x < winRect.right) {
-                    isMajorTick = ((tick % majorTickCount) == 0);
-                    tickHeight = isMajorTick ? m_majorTickHeight.cy : m_minorTickHeight.cy;
-                    isExact = units->UnconvertCoord(MeaConvertX, this, p, xa, xb);
-
-                    MeaLayout::ScreenToClientX(*this, x);
-                    MeaLayout::ScreenToClientX(*this, xa);
-                    MeaLayout::ScreenToClientX(*this, xb);
-
-                    CPen* oldPen = dc.SelectObject(isExact ? &pen : &pen1);
-
-                    if (m_labelPosition == Top) {
-                        dc.MoveTo(xa, clientRect.bottom);
-                        dc.LineTo(xa, clientRect.bottom - tickHeight);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(xb, clientRect.bottom);
-                            dc.LineTo(xb, clientRect.bottom - tickHeight);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(x, clientRect.top + m_margin.cy, m_unitsProvider.Format(MeaX, p));
-                        }
-                    } else {
-                        dc.MoveTo(xa, clientRect.top);
-                        dc.LineTo(xa, clientRect.top + tickHeight);
-                        if (!isExact) {
-                            dc.SelectObject(&pen2);
-                            dc.MoveTo(xb, clientRect.top);
-                            dc.LineTo(xb, clientRect.top + tickHeight);
-                        }
-                        if (isMajorTick) {
-                            dc.TextOut(x, clientRect.top + tickHeight + m_margin.cy, m_unitsProvider.Format(MeaX, p));
-                        }
-                    }
-
-                    dc.SelectObject(oldPen);
+        m_ticks.Update(MeaConvertX, this, minorIncr.cx, majorTickCount, virtRect.left, virtRect.right);
+        m_ticks.GetTicks(winRect.left, winRect.right, tickIter, tickEnd);
+
+        for (; tickIter != tickEnd; ++tickIter) {
+            const MeaRulerTicks::Tick& tick = *tickIter;
+            int tickHeight = tick.major ? m_majorTickHeight.cy : m_minorTickHeight.cy;
+            int x = tick.pos;
+            int xa = tick.pos1;
+            int xb = tick.pos2;
+
+            MeaLayout::ScreenToClientX(*this, x);
+            MeaLayout::ScreenToClientX(*this, xa);
+            MeaLayout::ScreenToClientX(*this, xb);
+
+            CPen* oldPen = dc.SelectObject(tick.exact ? &pen : &pen1);
+
+            if (m_labelPosition == Top) {
+                dc.MoveTo(xa, clientRect.bottom);
+                dc.LineTo(xa, clientRect.bottom - tickHeight);
+                if (!tick.exact) {
+                    dc.SelectObject(&pen2);
+                    dc.MoveTo(xb, clientRect.bottom);
+                    dc.LineTo(xb, clientRect.bottom - tickHeight);
+                }
+                if (tick.major) {
+                    dc.TextOut(x, clientRect.top + m_margin.cy, tick.label);
+                }
+            } else {
+                dc.MoveTo(xa, clientRect.top);
+                dc.LineTo(xa, clientRect.top + tickHeight);
+                if (!tick.exact) {
+                    dc.SelectObject(&pen2);
+                    dc.MoveTo(xb, clientRect.top);
+                    dc.LineTo(xb, clientRect.top + tickHeight);
+                }
+                if (tick.major) {
+                    dc.TextOut(x, clientRect.top + tickHeight + m_margin.cy, tick.label);
                 }
             }
-            minorIncr.cx = -minorIncr.cx;
-        } while (minorIncr.cx < 0);
+
+            dc.SelectObject(oldPen);
+        }
 
         dc.SelectObject(oldFont);
     }
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "Graphic.h"
+#include "RulerTicks.h"
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/units/UnitsProvider.h>
 
@@ -306,6 +307,7 @@ private:
 
     const MeaScreenProvider& m_screenProvider;  ///< Screen information provider
     const MeaUnitsProvider& m_unitsProvider;    ///< Units information provider
+    MeaRulerTicks m_ticks;                      ///< Cached tick mark layout
     COLORREF m_borderColor;                     ///< Color for the ruler border and tick marks.
     COLORREF m_backColor;                       ///< Color for the ruler background.
     CSize m_majorTickHeight;                    ///< Height of the major tick marks, in pixels.
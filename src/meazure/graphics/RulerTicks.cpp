@@ -0,0 +1,138 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "RulerTicks.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+
+MeaRulerTicks::MeaRulerTicks(const MeaUnitsProvider& unitsProvider) :
+    m_unitsProvider(unitsProvider),
+    m_dir(MeaConvertX),
+    m_wnd(nullptr),
+    m_units(nullptr),
+    m_minorIncr(0.0),
+    m_majorTickCount(1),
+    m_extentMin(0),
+    m_extentMax(0),
+    m_originPixel(0.0),
+    m_incrPixels(0.0),
+    m_firstIndex(0) {}
+
+void MeaRulerTicks::Update(MeaConvertDir dir, const CWnd* wnd, double minorIncr, int majorTickCount, int extentMin,
+                           int extentMax) {
+    MeaLinearUnits* units = m_unitsProvider.GetLinearUnits();
+
+    // The location of the origin, the orientation of the y-axis and the screen resolution are all captured by
+    // the pixel location of the origin and the distance between ticks in pixels.
+    //
+    double originPixel = units->UnconvertCoord(dir, wnd, 0.0);
+    double incrPixels = units->UnconvertCoord(dir, wnd, minorIncr) - originPixel;
+
+    if (dir != m_dir || units != m_units || wnd != m_wnd || minorIncr != m_minorIncr ||
+            majorTickCount != m_majorTickCount || extentMin != m_extentMin || extentMax != m_extentMax ||
+            originPixel != m_originPixel || incrPixels != m_incrPixels ||
+            units->GetDisplayPrecisions() != m_precisions) {
+        m_ticks.clear();
+
+        m_dir = dir;
+        m_units = units;
+        m_wnd = wnd;
+        m_minorIncr = minorIncr;
+        m_majorTickCount = majorTickCount;
+        m_extentMin = extentMin;
+        m_extentMax = extentMax;
+        m_originPixel = originPixel;
+        m_incrPixels = incrPixels;
+        m_precisions = units->GetDisplayPrecisions();
+    }
+}
+
+void MeaRulerTicks::GetTicks(int winMin, int winMax, TickIter& first, TickIter& last) {
+    int lo = std::max(winMin, m_extentMin);
+    int hi = std::min(winMax, m_extentMax);
+
+    if (lo >= hi || m_units == nullptr || m_incrPixels == 0.0) {
+        first = last = m_ticks.end();
+        return;
+    }
+
+    // Estimate the range of tick indices covering the window. The estimate is padded by a tick on either side
+    // to allow for rounding. Ticks falling outside the window are trimmed once the range has been laid out.
+    //
+    double i1 = (lo - m_originPixel) / m_incrPixels;
+    double i2 = (hi - m_originPixel) / m_incrPixels;
+    if (i1 > i2) {
+        std::swap(i1, i2);
+    }
+    int indexMin = static_cast<int>(floor(i1)) - 1;
+    int indexMax = static_cast<int>(ceil(i2)) + 1;
+
+    // Lay out only those ticks not already in the cache. If the window does not overlap or abut the cached
+    // range, start over rather than laying out all of the ticks in between.
+    //
+    int cacheMax = m_firstIndex + static_cast<int>(m_ticks.size()) - 1;
+    if (m_ticks.empty() || indexMax < m_firstIndex - 1 || indexMin > cacheMax + 1) {
+        m_ticks.clear();
+        m_firstIndex = indexMin;
+        cacheMax = indexMin - 1;
+    }
+
+    if (indexMin < m_firstIndex) {
+        std::vector<Tick> ticks(m_firstIndex - indexMin);
+        for (int index = indexMin; index < m_firstIndex; index++) {
+            LayoutTick(index, ticks[index - indexMin]);
+        }
+        m_ticks.insert(m_ticks.begin(), std::make_move_iterator(ticks.begin()), std::make_move_iterator(ticks.end()));
+        m_firstIndex = indexMin;
+    }
+
+    for (int index = cacheMax + 1; index <= indexMax; index++) {
+        m_ticks.emplace_back();
+        LayoutTick(index, m_ticks.back());
+    }
+
+    first = m_ticks.begin() + (indexMin - m_firstIndex);
+    last = m_ticks.begin() + (indexMax - m_firstIndex + 1);
+
+    // Tick locations are monotonic in the tick index so the ticks within the window are contiguous.
+    //
+    while (first != last && ((*first).pos < lo || (*first).pos >= hi)) {
+        ++first;
+    }
+    while (last != first && ((*(last - 1)).pos < lo || (*(last - 1)).pos >= hi)) {
+        --last;
+    }
+}
+
+void MeaRulerTicks::LayoutTick(int index, Tick& tick) const {
+    double p = index * m_minorIncr;
+
+    tick.pos = static_cast<int>(m_units->UnconvertCoord(m_dir, m_wnd, p));
+    tick.exact = m_units->UnconvertCoord(m_dir, m_wnd, p, tick.pos1, tick.pos2);
+    tick.major = ((index % m_majorTickCount) == 0);
+
+    if (tick.major) {
+        tick.label = m_unitsProvider.Format((m_dir == MeaConvertX) ? MeaX : MeaY, p);
+    } else {
+        tick.label.Empty();
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Tick mark layout for the ruler.
+
+#pragma once
+
+#include <meazure/units/UnitsProvider.h>
+#include <vector>
+
+
+/// Computes and caches the location and appearance of the tick marks along a ruler. Placing a tick mark requires
+/// converting its position from the current units to pixels, determining whether the conversion is exact and
+/// formatting a label for each major tick. Rather than performing this work on every paint, the layout is cached
+/// and reused for as long as the units, precision, resolution, origin, orientation and extent of the ruler are
+/// unchanged. When only the visible portion of the ruler changes (e.g. the ruler is moved), only the ticks that
+/// have not yet been laid out are computed.
+///
+class MeaRulerTicks {
+
+public:
+    /// Location and appearance of a single tick mark. All locations are in screen coordinates along the ruler's
+    /// major axis.
+    ///
+    struct Tick {
+        int pos;            ///< Location of the tick, in pixels.
+        int pos1;           ///< Closest integral pixel location to the tick.
+        int pos2;           ///< Second closest integral pixel location to the tick.
+        bool exact;         ///< Indicates whether the tick lands exactly on pos1.
+        bool major;         ///< Indicates whether the tick is a major tick.
+        CString label;      ///< Label for a major tick. Empty for a minor tick.
+    };
+
+    typedef std::vector<Tick>::const_iterator TickIter;     ///< Iterator over the laid out ticks.
+
+
+    /// Constructs a tick layout.
+    ///
+    /// @param unitsProvider    [in] Units information provider.
+    ///
+    explicit MeaRulerTicks(const MeaUnitsProvider& unitsProvider);
+
+    /// Validates the cached layout against the current ruler parameters. The layout is discarded if any of the
+    /// parameters, or any of the units settings that affect the placement or labeling of the ticks, have changed
+    /// since the last call.
+    ///
+    /// @param dir              [in] Axis along which the ruler runs.
+    /// @param wnd              [in] Ruler window, used to determine the screen resolution.
+    /// @param minorIncr        [in] Distance between minor ticks, in the current units.
+    /// @param majorTickCount   [in] Number of minor ticks between major ticks.
+    /// @param extentMin        [in] Lowest pixel location on which a tick can be placed (e.g. the virtual screen
+    ///                         left edge).
+    /// @param extentMax        [in] One past the highest pixel location on which a tick can be placed.
+    ///
+    void Update(MeaConvertDir dir, const CWnd* wnd, double minorIncr, int majorTickCount, int extentMin,
+                int extentMax);
+
+    /// Obtains the ticks located in the specified window, laying out any that have not yet been computed. Update
+    /// must have been called before calling this method.
+    ///
+    /// @param winMin   [in] Lowest visible pixel location.
+    /// @param winMax   [in] One past the highest visible pixel location.
+    /// @param first    [out] First tick in the window.
+    /// @param last     [out] One past the last tick in the window.
+    ///
+    void GetTicks(int winMin, int winMax, TickIter& first, TickIter& last);
+
+private:
+    /// Lays out the tick at the specified index. Tick 0 is located at the origin.
+    ///
+    /// @param index    [in] Index of the tick to layout.
+    /// @param tick     [out] Layout of the tick.
+    ///
+    void LayoutTick(int index, Tick& tick) const;
+
+    const MeaUnitsProvider& m_unitsProvider;    ///< Units information provider.
+
+    MeaConvertDir m_dir;                        ///< Axis along which the ruler runs.
+    const CWnd* m_wnd;                          ///< Ruler window, used to determine the screen resolution.
+    MeaLinearUnits* m_units;                    ///< Units used to lay out the ticks.
+    MeaLinearUnits::DisplayPrecisions m_precisions;     ///< Units precisions used to label the ticks.
+    double m_minorIncr;                         ///< Distance between minor ticks, in the current units.
+    int m_majorTickCount;                       ///< Number of minor ticks between major ticks.
+    int m_extentMin;                            ///< Lowest pixel location on which a tick can be placed.
+    int m_extentMax;                            ///< One past the highest pixel location on which a tick can be placed.
+    double m_originPixel;                       ///< Pixel location of tick 0.
+    double m_incrPixels;                        ///< Distance between minor ticks, in pixels.
+
+    std::vector<Tick> m_ticks;                  ///< Cached ticks, in index order.
+    int m_firstIndex;                           ///< Index of the first cached tick.
+};
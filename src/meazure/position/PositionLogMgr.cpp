@@ -30,6 +30,7 @@
 #include <meazure/utilities/StringUtils.h>
 #include <xercesc/framework/LocalFileInputSource.hpp>
 #include <cassert>
+#include <vector>
 
 
 MeaPositionLogMgr::MeaPositionLogMgr(token) :
@@ -229,12 +230,26 @@ void MeaPositionLogMgr::ShowPosition(unsigned int posIndex) {
         toolMgr.UpdateTools(MeaUpdateReason::OriginChanged);
     }
 
-    // Show the points.
+    // Show the points. The points are converted to pixels as a batch so
+    // that the screen and its conversion factors are looked up once for
+    // all points on the same screen.
     //
+    const MeaPosition::PointMap& points = position.GetPoints();
+    std::vector<MeaFPoint> coords;
+    coords.reserve(points.size());
+
+    for (const auto& pointEntry : points) {
+        coords.push_back(pointEntry.second);
+    }
+
+    std::vector<POINT> pixels(coords.size());
+    unitsMgr.UnconvertCoords(coords.data(), pixels.data(), coords.size());
+
     MeaRadioTool::PointMap toolPoints;
+    std::vector<POINT>::const_iterator pixelIter = pixels.begin();
 
-    for (const auto& pointEntry : position.GetPoints()) {
-        toolPoints[pointEntry.first] = unitsMgr.UnconvertCoord(pointEntry.second);
+    for (const auto& pointEntry : points) {
+        toolPoints[pointEntry.first] = *pixelIter++;
     }
 
     toolMgr.SetPosition(toolPoints);
@@ -84,45 +84,27 @@ bool MeaFileProfile::WriteStr(PCTSTR key, PCTSTR value) {
 }
 
 bool MeaFileProfile::ReadBool(PCTSTR key, bool defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        CString val = (*iter).second;
-        val.MakeLower();
-        return ((val == _T("true")) || (val == _T("1")) || (val == _T("yes")));
-    }
-    return defaultValue;
+    bool value = defaultValue;
+    m_valueMap.GetBool(key, value);
+    return value;
 }
 
 UINT MeaFileProfile::ReadInt(PCTSTR key, int defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        return _ttoi((*iter).second);
-    }
-    return defaultValue;
+    int value = defaultValue;
+    m_valueMap.GetInt(key, value);
+    return value;
 }
 
 double MeaFileProfile::ReadDbl(PCTSTR key, double defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        return _tcstod((*iter).second, nullptr);
-    }
-    return defaultValue;
+    double value = defaultValue;
+    m_valueMap.GetDbl(key, value);
+    return value;
 }
 
 CString MeaFileProfile::ReadStr(PCTSTR key, PCTSTR defaultValue) {
-    std::map<CString, CString>::const_iterator iter;
-
-    iter = m_valueMap.find(key);
-    if (iter != m_valueMap.end()) {
-        return (*iter).second;
-    }
-    return defaultValue;
+    CString value(defaultValue);
+    m_valueMap.GetStr(key, value);
+    return value;
 }
 
 bool MeaFileProfile::UserInitiated() {
@@ -188,7 +170,7 @@ void MeaFileProfile::StartElement(const CString& container, const CString& eleme
     } else if ((container == _T("data")) || (m_readVersion == 1)) {
         CString value;
         attrs.GetValueStr(_T("value"), value);
-        m_valueMap[elementName] = value;
+        m_valueMap.Set(elementName, value);
     }
 }
 
@@ -23,9 +23,9 @@
 #pragma once
 
 #include "Profile.h"
+#include "ProfileValueMap.h"
 #include <meazure/xml/XMLParser.h>
 #include <meazure/xml/XMLWriter.h>
-#include <map>
 #include <memory>
 #include <fstream>
 
@@ -182,5 +182,5 @@ private:
     Mode m_mode;                    ///< Opening mode for the profile file.
     int m_readVersion;              ///< Profile format version number read from the profile file.
     CString m_title;                ///< Title for the profile file.
-    std::map<CString, CString>  m_valueMap;     ///< Maps profile keys to values.
+    MeaProfileValueMap m_valueMap;  ///< Maps profile keys to values.
 };
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "ProfileValueMap.h"
+#include <string>
+#include <type_traits>
+
+
+MeaProfileValueMap::MeaProfileValueMap() : m_slots(kMinSlots, kEmptySlot) {}
+
+void MeaProfileValueMap::Set(PCTSTR key, PCTSTR value) {
+    Entry* entry = Find(key);
+    if (entry != nullptr) {
+        entry->text = value;
+        entry->converted = std::monostate();
+        return;
+    }
+
+    if (2 * (m_entries.size() + 1) > m_slots.size()) {
+        Grow();
+    }
+
+    Entry newEntry;
+    newEntry.hash = Hash(key, newEntry.keyLength);
+    newEntry.keyOffset = m_keyPool.size();
+    newEntry.text = value;
+    m_keyPool.insert(m_keyPool.end(), key, key + newEntry.keyLength + 1);
+
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = newEntry.hash & mask;
+    while (m_slots[slot] != kEmptySlot) {
+        slot = (slot + 1) & mask;
+    }
+
+    m_entries.push_back(std::move(newEntry));
+    m_slots[slot] = static_cast<uint32_t>(m_entries.size());
+}
+
+bool MeaProfileValueMap::GetBool(PCTSTR key, bool& value) {
+    Entry* entry = Find(key);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    if (!std::holds_alternative<bool>(entry->converted)) {
+        CString text = entry->text;
+        text.MakeLower();
+        entry->converted = (text == _T("true")) || (text == _T("1")) || (text == _T("yes"));
+    }
+    value = std::get<bool>(entry->converted);
+    return true;
+}
+
+bool MeaProfileValueMap::GetInt(PCTSTR key, int& value) {
+    Entry* entry = Find(key);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    if (!std::holds_alternative<int>(entry->converted)) {
+        entry->converted = _ttoi(entry->text);
+    }
+    value = std::get<int>(entry->converted);
+    return true;
+}
+
+bool MeaProfileValueMap::GetDbl(PCTSTR key, double& value) {
+    Entry* entry = Find(key);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    if (!std::holds_alternative<double>(entry->converted)) {
+        entry->converted = _tcstod(entry->text, nullptr);
+    }
+    value = std::get<double>(entry->converted);
+    return true;
+}
+
+bool MeaProfileValueMap::GetStr(PCTSTR key, CString& value) const {
+    const Entry* entry = Find(key);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    value = entry->text;
+    return true;
+}
+
+uint32_t MeaProfileValueMap::Hash(PCTSTR key, std::size_t& length) {
+    uint32_t hash = 2166136261U;
+    std::size_t i = 0;
+    for (; key[i] != 0; i++) {
+        hash ^= static_cast<uint32_t>(static_cast<std::make_unsigned_t<TCHAR>>(key[i]));
+        hash *= 16777619U;
+    }
+    length = i;
+    return hash;
+}
+
+const MeaProfileValueMap::Entry* MeaProfileValueMap::Find(PCTSTR key) const {
+    std::size_t length;
+    uint32_t hash = Hash(key, length);
+
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = hash & mask; m_slots[slot] != kEmptySlot; slot = (slot + 1) & mask) {
+        const Entry& entry = m_entries[m_slots[slot] - 1];
+        if (entry.hash == hash && entry.keyLength == length &&
+            std::char_traits<TCHAR>::compare(&m_keyPool[entry.keyOffset], key, length) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void MeaProfileValueMap::Grow() {
+    std::vector<uint32_t> slots(2 * m_slots.size(), kEmptySlot);
+    std::size_t mask = slots.size() - 1;
+
+    for (std::size_t i = 0; i < m_entries.size(); i++) {
+        std::size_t slot = m_entries[i].hash & mask;
+        while (slots[slot] != kEmptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<uint32_t>(i + 1);
+    }
+
+    m_slots.swap(slots);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// @file
+/// @brief Header file for the profile key to value map.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+
+/// Maps profile keys to their values for a profile read from a file. The
+/// values are stored as the strings read from the file and are converted
+/// to the type requested by the first typed read of each key. The
+/// converted value is kept, so subsequent reads of the key as the same
+/// type do not convert the string again.
+///
+/// The map uses open addressing with linear probing in a power of two
+/// table that is kept at most half full. The key strings are interned in a
+/// single character pool rather than allocated individually. Keys are case
+/// sensitive.
+///
+class MeaProfileValueMap {
+
+public:
+    /// Constructs an empty map.
+    ///
+    MeaProfileValueMap();
+
+    /// Sets the value of the specified key, replacing any previous value.
+    ///
+    /// @param key      [in] Profile key.
+    /// @param value    [in] Value for the key, as read from the profile.
+    ///
+    void Set(PCTSTR key, PCTSTR value);
+
+    /// Obtains the value of the specified key as a boolean. The values
+    /// "true", "1" and "yes", in any case, are true and all other values
+    /// are false.
+    ///
+    /// @param key      [in] Profile key.
+    /// @param value    [out] Value of the key. Unchanged if the key is not found.
+    /// @return <b>true</b> if the key was found.
+    ///
+    bool GetBool(PCTSTR key, bool& value);
+
+    /// Obtains the value of the specified key as an integer.
+    ///
+    /// @param key      [in] Profile key.
+    /// @param value    [out] Value of the key. Unchanged if the key is not found.
+    /// @return <b>true</b> if the key was found.
+    ///
+    bool GetInt(PCTSTR key, int& value);
+
+    /// Obtains the value of the specified key as a double.
+    ///
+    /// @param key      [in] Profile key.
+    /// @param value    [out] Value of the key. Unchanged if the key is not found.
+    /// @return <b>true</b> if the key was found.
+    ///
+    bool GetDbl(PCTSTR key, double& value);
+
+    /// Obtains the value of the specified key as a string.
+    ///
+    /// @param key      [in] Profile key.
+    /// @param value    [out] Value of the key. Unchanged if the key is not found.
+    /// @return <b>true</b> if the key was found.
+    ///
+    bool GetStr(PCTSTR key, CString& value) const;
+
+    /// Obtains the number of keys in the map.
+    ///
+    /// @return Number of keys.
+    ///
+    std::size_t GetSize() const { return m_entries.size(); }
+
+private:
+    /// A key and its value.
+    ///
+    struct Entry {
+        std::size_t keyOffset;      ///< Offset of the key in the key pool.
+        std::size_t keyLength;      ///< Length of the key in characters.
+        uint32_t hash;              ///< Hash of the key.
+        CString text;               ///< Value as read from the profile.
+        std::variant<std::monostate, bool, int, double> converted;  ///< Value converted by the last typed read.
+    };
+
+    static constexpr uint32_t kEmptySlot { 0 };     ///< Slot not holding an entry.
+    static constexpr std::size_t kMinSlots { 64 };  ///< Initial size of the slot table.
+
+    /// Hashes a key using the 32 bit FNV-1a hash.
+    ///
+    /// @param key      [in] Key to hash.
+    /// @param length   [out] Length of the key in characters.
+    /// @return Hash of the key.
+    ///
+    static uint32_t Hash(PCTSTR key, std::size_t& length);
+
+    /// Finds the entry for the specified key.
+    ///
+    /// @param key      [in] Key to find.
+    /// @return Entry for the key, or nullptr if the key is not in the map.
+    ///
+    const Entry* Find(PCTSTR key) const;
+
+    /// Finds the entry for the specified key.
+    ///
+    /// @param key      [in] Key to find.
+    /// @return Entry for the key, or nullptr if the key is not in the map.
+    ///
+    Entry* Find(PCTSTR key) {
+        return const_cast<Entry*>(static_cast<const MeaProfileValueMap*>(this)->Find(key));
+    }
+
+    /// Doubles the size of the slot table and reinserts the entries.
+    ///
+    void Grow();
+
+
+    std::vector<TCHAR> m_keyPool;       ///< Interned keys, each null terminated.
+    std::vector<Entry> m_entries;       ///< Entries in the order their keys were first set.
+    std::vector<uint32_t> m_slots;      ///< Index of an entry plus one, or kEmptySlot.
+};
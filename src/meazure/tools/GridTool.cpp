@@ -28,11 +28,13 @@ MeaGridTool::MeaGridTool(MeaToolMgr& mgr, const MeaScreenProvider& screenProvide
                          const MeaUnitsProvider& unitsProvider) :
     MeaTool(mgr, screenProvider, unitsProvider),
     m_gridSpacing(kDefDefaultSpacing, kDefDefaultSpacing),
-    m_linked(kDefLinked) {}
+    m_linked(kDefLinked),
+    m_numShown(0) {}
 
 MeaGridTool::~MeaGridTool() {
     try {
         Disable();
+        DeleteOverlays();
     } catch (...) {
         assert(false);
     }
@@ -86,54 +88,15 @@ void MeaGridTool::Disable() {
 
     MeaTool::Disable();
 
-    HideLines(VDir);
-    HideLines(HDir);
+    HideOverlays();
 }
 
 void MeaGridTool::Update(MeaUpdateReason reason) {
     if (IsEnabled()) {
         MeaTool::Update(reason);
 
-        // To prevent visual artifacts and to improve
-        // performance, hide the grid lines, move then
-        // as needed, and then show the lines.
-        //
-        HideLines(HDir);
-        HideLines(VDir);
-
-        SetLines(HDir);
-        SetLines(VDir);
-
-        ShowLines(HDir);
-        ShowLines(VDir);
-    }
-}
-
-void MeaGridTool::UpdateH() {
-    if (IsEnabled()) {
-        MeaTool::Update(MeaUpdateReason::NormalUpdate);
-
-        // To prevent visual artifacts and to improve
-        // performance, hide the grid lines, move then
-        // as needed, and then show the lines.
-        //
-        HideLines(HDir);
-        SetLines(HDir);
-        ShowLines(HDir);
-    }
-}
-
-void MeaGridTool::UpdateV() {
-    if (IsEnabled()) {
-        MeaTool::Update(MeaUpdateReason::NormalUpdate);
-
-        // To prevent visual artifacts and to improve
-        // performance, hide the grid lines, move then
-        // as needed, and then show the lines.
-        //
-        HideLines(VDir);
-        SetLines(VDir);
-        ShowLines(VDir);
+        SetOverlays();
+        ShowOverlays();
     }
 }
 
@@ -146,133 +109,70 @@ const POINT& MeaGridTool::GetPosition() const {
 }
 
 void MeaGridTool::SetGridSpacing(const SIZE& spacing) {
-    int v;
-
     // Checks the specified spacing value against the minimum and maximum spacing values.
     // The returned value is clamped to be between the min and max spacing.
     auto validateSpace = [](LONG s) { return (s < kDefMinSpacing) ? kDefMinSpacing : ((s > kDefMaxSpacing) ? kDefMaxSpacing : s); };
 
-    v = validateSpace(spacing.cx);
-    if (m_gridSpacing.cx != v) {
-        m_gridSpacing.cx = v;
-        UpdateH();
-    }
-
-    v = validateSpace(spacing.cy);
-    if (m_gridSpacing.cy != v) {
-        m_gridSpacing.cy = v;
-        UpdateV();
+    CSize newSpacing(validateSpace(spacing.cx), validateSpace(spacing.cy));
+    if (m_gridSpacing != newSpacing) {
+        m_gridSpacing = newSpacing;
+        Update(MeaUpdateReason::NormalUpdate);
     }
 }
 
 void MeaGridTool::ColorsChanged() {
-    // Draw the horizontal lines in the new color.
+    // Draw the grid lines in the new color.
     //
-    for (auto line : m_hlineList) {
-        line->SetColor(MeaColors::Get(MeaColors::LineFore));
-    }
-
-    // Draw the vertical lines in the new color.
-    //
-    for (auto line : m_vlineList) {
-        line->SetColor(MeaColors::Get(MeaColors::LineFore));
+    for (auto overlay : m_overlays) {
+        overlay->SetColor(MeaColors::Get(MeaColors::LineFore));
     }
 }
 
-void MeaGridTool::SetLines(LineDir dir) {
-    int numLinesReq, numLinesAct;
+void MeaGridTool::SetOverlays() {
     const CRect& virtRect = m_screenProvider.GetVirtualRect();
 
-    if (dir == VDir) {
-        // New lines are created on demand and added to the list
-        // for positioning.
-        //
-        numLinesReq = virtRect.Height() / m_gridSpacing.cy + 1;
-        numLinesAct = static_cast<int>(m_hlineList.size());
-
-        if (numLinesAct < numLinesReq) {
-            int delta = numLinesReq - numLinesAct;
-            for (int i = 0; i < delta; i++) {
-                MeaLine* line = new MeaLine();
-                line->Create(0, m_screenProvider);
-                m_hlineList.push_back(line);
-            }
-        }
+    m_numShown = 0;
 
-        // Position the lines.
+    for (MeaScreenProvider::ScreenIter iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter);
+         ++iter) {
+        // New overlays are created on demand and reused when
+        // the grid or the screen arrangement changes.
         //
-        LineList::const_iterator iter = m_hlineList.begin();
-        CPoint startPoint(virtRect.left, virtRect.top);
-        CPoint endPoint(virtRect.right, virtRect.top);
-
-        for ( ; startPoint.y <= virtRect.bottom; startPoint.y += m_gridSpacing.cy, endPoint.y = startPoint.y) {
-            (*iter++)->SetPosition(startPoint, endPoint);
-        }
-    } else {
-        // New lines are created on demand and added to the list
-        // for positioning.
-        //
-        numLinesReq = virtRect.Width() / m_gridSpacing.cx + 1;
-        numLinesAct = static_cast<int>(m_vlineList.size());
-
-        if (numLinesAct < numLinesReq) {
-            int delta = numLinesReq - numLinesAct;
-            for (int i = 0; i < delta; i++) {
-                MeaLine* line = new MeaLine();
-                line->Create(0, m_screenProvider);
-                m_vlineList.push_back(line);
-            }
+        if (m_numShown == m_overlays.size()) {
+            MeaGridOverlay* overlay = new MeaGridOverlay();
+            overlay->Create();
+            m_overlays.push_back(overlay);
         }
 
-        // Position the lines.
-        //
-        LineList::const_iterator iter = m_vlineList.begin();
-        CPoint startPoint(virtRect.left, virtRect.top);
-        CPoint endPoint(virtRect.left, virtRect.bottom);
+        m_overlays[m_numShown++]->SetGrid(m_screenProvider.GetScreenRect(iter), virtRect, m_gridSpacing);
+    }
 
-        for ( ; startPoint.x <= virtRect.right; startPoint.x += m_gridSpacing.cx, endPoint.x = startPoint.x) {
-            (*iter++)->SetPosition(startPoint, endPoint);
-        }
+    // Hide any overlays left over from screens that are no longer present.
+    //
+    for (std::size_t i = m_numShown; i < m_overlays.size(); i++) {
+        m_overlays[i]->Hide();
     }
 }
 
-void MeaGridTool::HideLines(LineDir dir) const {
-    if (dir == VDir) {
-        for (auto line : m_hlineList) {
-            line->Hide();
-        }
-    } else {
-        for (auto line : m_vlineList) {
-            line->Hide();
-        }
+void MeaGridTool::ShowOverlays() {
+    for (std::size_t i = 0; i < m_numShown; i++) {
+        m_overlays[i]->Show();
     }
 }
 
-void MeaGridTool::ShowLines(LineDir dir) {
-    int c;
-    const CRect& virtRect = m_screenProvider.GetVirtualRect();
-
-    if (dir == VDir) {
-        LineList::const_iterator iter = m_hlineList.begin();
-
-        for (c = virtRect.top; c <= virtRect.bottom; c += m_gridSpacing.cy) {
-            (*iter++)->Show();
-        }
-    } else {
-        LineList::const_iterator iter = m_vlineList.begin();
-
-        for (c = virtRect.left; c <= virtRect.right; c += m_gridSpacing.cx) {
-            (*iter++)->Show();
-        }
+void MeaGridTool::HideOverlays() const {
+    for (auto overlay : m_overlays) {
+        overlay->Hide();
     }
 }
 
-void MeaGridTool::DeleteLines(LineList& lineList) const {
-    for (auto line : lineList) {
-        line->Hide();
-        delete line;
+void MeaGridTool::DeleteOverlays() {
+    for (auto overlay : m_overlays) {
+        overlay->Hide();
+        delete overlay;
     }
-    lineList.clear();
+    m_overlays.clear();
+    m_numShown = 0;
 }
 
 
@@ -22,10 +22,10 @@
 
 #pragma once
 
-#include <list>
+#include <vector>
 
 #include "Tool.h"
-#include <meazure/graphics/Line.h>
+#include <meazure/graphics/GridOverlay.h>
 #include <meazure/ui/NumberField.h>
 
 
@@ -135,7 +135,8 @@ private:
 /// Grid overlay tool. This tool overlays a rectangular grid on
 /// the screen. If there are multiple monitors, the grid is overlayed
 /// continuously across all monitors. The grid spacing can be changed
-/// using the MeaGridDialog.
+/// using the MeaGridDialog. The grid lines on each monitor are drawn
+/// by a single MeaGridOverlay window.
 ///
 class MeaGridTool : public MeaTool {
 
@@ -196,14 +197,6 @@ public:
     ///
     virtual void Update(MeaUpdateReason reason) override;
 
-    /// Draws the horizontal grid lines.
-    ///
-    void UpdateH();
-
-    /// Draws the vertical grid lines.
-    ///
-    void UpdateV();
-
     /// Returns the name of the tool. Each tool has a unique name
     /// which is used to identify the tool in profiles and position
     /// logs.
@@ -251,51 +244,33 @@ public:
     void SetLinked(bool linked) { m_linked = linked; }
 
 private:
-    typedef std::list<MeaLine*> LineList;       ///< List of grid lines
-
-    /// Grid line direction
-    ///
-    enum LineDir {
-        HDir = 0,
-        VDir = 1
-    };
+    typedef std::vector<MeaGridOverlay*> OverlayList;     ///< Grid overlays, one per screen
 
 
-    /// Creates the vertical or horizontal lines for the grid as needed
-    /// and positions them on the grid according to the currently set
-    /// grid spacing. Since there are many lines on a grid and line
-    /// creation is expensive, lines are created on demand and
-    /// reused. The lines are destroyed only when the tool is
-    /// destroyed.
+    /// Creates a grid overlay for each screen as needed and shapes it to
+    /// the grid lines crossing that screen according to the currently set
+    /// grid spacing. Overlays are created on demand and reused. Overlays
+    /// beyond the current number of screens are hidden. The overlays are
+    /// destroyed only when the tool is destroyed.
     ///
-    /// @param dir      [in] Direction of the lines to create
-    ///
-    void SetLines(LineDir dir);
+    void SetOverlays();
 
-    /// Displays the vertical or horizontal grid lines.
-    ///
-    /// @param dir      [in] Direction of the lines to display
+    /// Displays the grid overlays for the current screens.
     ///
-    void ShowLines(LineDir dir);
+    void ShowOverlays();
 
-    /// Hides the vertical or horizontal grid lines
-    ///
-    /// @param dir      [in] Direction of the lines to display
+    /// Hides all grid overlays.
     ///
-    void HideLines(LineDir dir) const;
+    void HideOverlays() const;
 
-    /// Hides and then destroys the lines in the specified line list.
-    /// The line list is then cleared.
+    /// Hides and then destroys all grid overlays. The overlay list is
+    /// empty following the call to this method.
     ///
-    /// @param list     [in] List of lines whose contents is to be
-    ///                 destroyed. The list is empty following the
-    ///                 call to this method.
-    ///
-    void DeleteLines(LineList& list) const;
-    
+    void DeleteOverlays();
+
 
-    CSize m_gridSpacing;    ///< Vertical and horizontal grid spacing, in pixels
-    bool m_linked;          ///< <b>true</b> if the vertical and horizontal grid spacings are linked (i.e. kept equal)
-    LineList m_hlineList;   ///< List of horizontal grid lines
-    LineList m_vlineList;   ///< List of vertical grid lines
+    CSize m_gridSpacing;        ///< Vertical and horizontal grid spacing, in pixels
+    bool m_linked;              ///< <b>true</b> if the vertical and horizontal grid spacings are kept equal
+    OverlayList m_overlays;     ///< Grid overlays, one per screen
+    std::size_t m_numShown;     ///< Number of overlays in use for the current screens
 };
@@ -24,6 +24,7 @@
 #include <meazure/prefs/Preferences.h>
 #include "Layout.h"
 #include "ScreenMgr.h"
+#include <meazure/utilities/CachedRegistry.h>
 #include <meazure/utilities/Registry.h>
 
 
@@ -114,10 +115,12 @@ int AppFrame::OnCreate(LPCREATESTRUCT lpCreateStruct) {
     MeaLayout::SetWindowSize(*this, m_appWidth,
         frameRect.Height() + m_toolbarHeight + m_statusbarHeight);
 
-    // Restore the state of the program from the registry.
+    // Restore the state of the program from the registry. The cache reads
+    // each registry section once rather than one value at a time.
     //
     MeaRegistry registry;
-    MeaRegistryProfile profile(registry);
+    MeaCachedRegistry cachedRegistry(registry);
+    MeaRegistryProfile profile(cachedRegistry);
     LoadProfile(profile);
 
     // Tell everyone to initialize its view
@@ -354,17 +357,23 @@ void AppFrame::OnReportIssue() {
 void AppFrame::OnEndSession(BOOL bEnding) {
     if (bEnding) {
         MeaRegistry registry;
-        MeaRegistryProfile profile(registry);
+        MeaCachedRegistry cachedRegistry(registry);
+        MeaRegistryProfile profile(cachedRegistry);
         SaveProfile(profile);
+        cachedRegistry.Flush();
     }
 
     CFrameWnd::OnEndSession(bEnding);
 }
 
 void AppFrame::OnClose() {
+    // Only the values that changed since they were last saved are written.
+    //
     MeaRegistry registry;
-    MeaRegistryProfile profile(registry);
+    MeaCachedRegistry cachedRegistry(registry);
+    MeaRegistryProfile profile(cachedRegistry);
     SaveProfile(profile);
+    cachedRegistry.Flush();
 
     CFrameWnd::OnClose();
 }
@@ -230,6 +230,7 @@ void AppView::LoadProfile(MeaProfile& profile) {
         m_startupProfile = profile.ReadStr(_T("StartupProfile"), m_startupProfile);
     }
 
+    CancelMouseFrame();
     toolMgr.DisableRadioTools();
     toolMgr.LoadProfile(profile);
     toolMgr.ChangeRadioToolEnable();
@@ -266,6 +267,7 @@ void AppView::MasterReset() {
 
     MeaToolMgr& toolMgr = MeaToolMgr::Instance();
     toolMgr.ColorsChanged();
+    CancelMouseFrame();
     toolMgr.DisableRadioTools();
     toolMgr.MasterReset();
     toolMgr.ChangeRadioToolEnable();
@@ -357,7 +359,17 @@ int AppView::OnCreate(LPCREATESTRUCT lpCreateStruct) {
 
     frame->MoveWindow(frameRect);
 
-    m_snapshotTimer.Create(this);
+    m_snapshotTimer.Create(this, kSnapshotTimerId);
+    m_mouseFrameTimer.Create(this, kMouseFrameTimerId);
+
+    // Pace the pointer driven tool updates to the display refresh rate.
+    //
+    HDC screenDC = ::GetDC(nullptr);
+    int refreshRate = ::GetDeviceCaps(screenDC, VREFRESH);
+    ::ReleaseDC(nullptr, screenDC);
+    if (refreshRate > 1) {
+        m_mouseScheduler.SetFrameInterval(std::chrono::microseconds(1000000 / refreshRate));
+    }
 
     MeaToolMgr& toolMgr = MeaToolMgr::Instance();
 
@@ -486,7 +498,38 @@ BOOL AppView::PreTranslateMessage(MSG* pMsg) {
 }
 
 void AppView::OnMouseHook(WPARAM wParam, LPARAM lParam) {
-    MeaToolMgr::Instance().OnMouseHook(wParam, lParam);
+    // Mouse hook messages can arrive far faster than the display refreshes
+    // (e.g. high polling rate mice). Rather than updating the tools for every
+    // message, only the latest pointer position is dispatched once per frame.
+    //
+    MeaUpdateScheduler::Clock::time_point now = MeaUpdateScheduler::Clock::now();
+
+    switch (m_mouseScheduler.AddEvent(wParam, lParam, now)) {
+    case MeaUpdateScheduler::DispatchNow:
+        DispatchMouseFrame();
+        break;
+    case MeaUpdateScheduler::ScheduleFrame:
+        m_mouseFrameTimer.Start(static_cast<int>(
+                std::chrono::ceil<std::chrono::milliseconds>(m_mouseScheduler.GetFrameDelay(now)).count()));
+        break;
+    case MeaUpdateScheduler::Coalesced:
+        break;
+    }
+}
+
+void AppView::DispatchMouseFrame() {
+    WPARAM wParam;
+    LPARAM lParam;
+
+    if (m_mouseScheduler.BeginFrame(MeaUpdateScheduler::Clock::now(), wParam, lParam)) {
+        MeaToolMgr::Instance().OnMouseHook(wParam, lParam);
+        m_mouseScheduler.EndFrame(MeaUpdateScheduler::Clock::now());
+    }
+}
+
+void AppView::CancelMouseFrame() {
+    m_mouseFrameTimer.Stop();
+    m_mouseScheduler.Clear();
 }
 
 LRESULT AppView::OnGetPosition(WPARAM /* wParam */, LPARAM lParam) {
@@ -813,6 +856,8 @@ void AppView::OnUpdateRadioTool(CCmdUI* pCmdUI) {
 }
 
 void AppView::OnRadioTool(UINT nID) {
+    CancelMouseFrame();
+
     switch (nID) {
     case ID_MEA_CURSOR:
         MeaToolMgr::Instance().SetRadioTool(MeaCursorTool::kToolName);
@@ -1069,6 +1114,7 @@ LRESULT AppView::OnDataChange(WPARAM wParam, LPARAM lParam) {
 }
 
 void AppView::OnDestroy() {
+    CancelMouseFrame();
     MeaToolMgr::Instance().DisableRadioTools();
     m_magnifier.Disable();
     CWnd::OnDestroy();
@@ -1289,7 +1335,12 @@ void AppView::OnCopyRegion() {
     }
 }
 
-LRESULT AppView::OnHPTimer(WPARAM, LPARAM) {
+LRESULT AppView::OnHPTimer(WPARAM wParam, LPARAM) {
+    if (wParam == kMouseFrameTimerId) {
+        DispatchMouseFrame();
+        return 0;
+    }
+
     // Get the screen region to copy.
     //
     CRect rect(MeaToolMgr::Instance().GetRegion());
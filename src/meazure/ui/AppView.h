@@ -24,6 +24,7 @@
 
 #include "DataDisplay.h"
 #include "Magnifier.h"
+#include "UpdateScheduler.h"
 #include <meazure/prefs/Preferences.h>
 #include <meazure/profile/Profile.h>
 #include <meazure/tools/Tool.h>
@@ -173,9 +174,9 @@ protected:
     /// 
     afx_msg LRESULT OnGetPosition(WPARAM wParam, LPARAM lParam);
 
-    /// Called when the region snapshot timer expires.
+    /// Called when the region snapshot timer or the mouse hook frame timer expires.
     /// 
-    /// @param wParam   [in] Not used
+    /// @param wParam   [in] Identifies the timer that expired
     /// @param lParam   [in] Not used.
     /// @return Always returns 0.
     /// 
@@ -538,6 +539,8 @@ protected:
 
 private:
     static constexpr SIZE kBaseMargin { 5, 5 };     ///< Vertical and horizontal margins around major sections.
+    static constexpr WPARAM kSnapshotTimerId { 0 };     ///< Identifies the region snapshot timer.
+    static constexpr WPARAM kMouseFrameTimerId { 1 };   ///< Identifies the mouse hook frame timer.
 
 
     /// Determines the desired width of the application menu.
@@ -605,6 +608,17 @@ private:
     ///
     void ViewMagnifier(bool enable);
 
+    /// Dispatches the latest mouse hook event to the tools, if one is
+    /// awaiting dispatch.
+    ///
+    void DispatchMouseFrame();
+
+    /// Discards any mouse hook event awaiting dispatch. Called before the
+    /// radio tool changes or the mouse hook is disabled so that a position
+    /// reported for the previous tool is not delivered to the next one.
+    ///
+    void CancelMouseFrame();
+
     CSize m_margin;                 ///< Margins around major sections scaled by effective DPI.
     bool m_enabled;                 ///< Used in determining margins when the application is collapsed.
     bool m_profileMagnifierEnabled; ///< Indicates if the stored user preference is to show the magnifier window.
@@ -617,6 +631,8 @@ private:
     MeaPreferences m_prefs;         ///< Application preferences.
     CString m_startupProfile;       ///< Pathname for the startup profile, if any.
     MeaTimer m_snapshotTimer;       ///< Timer used in copying a tool's region to the clipboard.
+    MeaTimer m_mouseFrameTimer;     ///< Timer used to dispatch coalesced mouse hook events.
+    MeaUpdateScheduler m_mouseScheduler;    ///< Paces mouse hook driven tool updates to the display refresh rate.
     int m_adjustHeight;             ///< Adjustment used when computing the height of the application, in pixels.
     bool m_expandToolbar;           ///< Indicates if the toolbar is displayed.
     bool m_expandStatusbar;         ///< Indicates if the status bar is displayed.
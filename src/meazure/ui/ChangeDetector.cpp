@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <meazure/pch.h>
+#include "ChangeDetector.h"
+#include <algorithm>
+#include <cstddef>
+
+
+MeaChangeDetector::MeaChangeDetector(int baseInterval, int maxInterval, int idleChecks) :
+    m_baseInterval(baseInterval),
+    m_maxInterval(std::max(baseInterval, maxInterval)),
+    m_idleChecks(idleChecks),
+    m_interval(baseInterval),
+    m_idleCount(0),
+    m_valid(false),
+    m_position(),
+    m_zoomIndex(0),
+    m_pixelHash(0),
+    m_stats() {}
+
+uint64_t MeaChangeDetector::Hash(const MeaPixelBuffer& pixels) {
+    const uint64_t kOffsetBasis = 14695981039346656037ULL;
+    const uint64_t kPrime = 1099511628211ULL;
+
+    uint64_t hash = kOffsetBasis;
+    hash = (hash ^ static_cast<uint32_t>(pixels.width)) * kPrime;
+    hash = (hash ^ static_cast<uint32_t>(pixels.height)) * kPrime;
+
+    for (int y = 0; y < pixels.height; y++) {
+        const uint32_t* row = pixels.pixels + static_cast<std::ptrdiff_t>(y) * pixels.stride;
+        for (int x = 0; x < pixels.width; x++) {
+            hash = (hash ^ row[x]) * kPrime;
+        }
+    }
+
+    return hash;
+}
+
+bool MeaChangeDetector::Check(const POINT& position, int zoomIndex, uint64_t pixelHash) {
+    m_stats.checks++;
+
+    bool changed = !m_valid || position.x != m_position.x || position.y != m_position.y ||
+            zoomIndex != m_zoomIndex || pixelHash != m_pixelHash;
+
+    m_valid = true;
+    m_position = position;
+    m_zoomIndex = zoomIndex;
+    m_pixelHash = pixelHash;
+
+    if (changed) {
+        m_idleCount = 0;
+        m_interval = m_baseInterval;
+    } else {
+        m_stats.unchanged++;
+        if (++m_idleCount >= m_idleChecks) {
+            m_interval = std::min(m_interval * 2, m_maxInterval);
+        }
+    }
+
+    return changed;
+}
+
+void MeaChangeDetector::Invalidate() {
+    m_valid = false;
+    m_idleCount = 0;
+    m_interval = m_baseInterval;
+}
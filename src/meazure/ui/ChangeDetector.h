@@ -0,0 +1,105 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for detecting when the magnified image needs to be redrawn.
+
+#pragma once
+
+#include <meazure/graphics/PixelZoom.h>
+#include <cstdint>
+
+
+/// Determines whether the magnifier image has changed since it was last
+/// drawn, and how long to wait before checking again. A check compares the
+/// magnified position and zoom index, and a hash of the captured pixels,
+/// with those from the previous check. While nothing changes, the interval
+/// between checks backs off exponentially up to a maximum. Any change
+/// returns the interval to its base value.
+///
+class MeaChangeDetector {
+
+public:
+    /// Detector statistics for diagnostic purposes.
+    ///
+    struct Stats {
+        unsigned long checks;       ///< Number of checks performed.
+        unsigned long unchanged;    ///< Number of checks that found nothing had changed.
+    };
+
+
+    /// Constructs a change detector.
+    ///
+    /// @param baseInterval     [in] Interval between checks while the image is changing, in milliseconds.
+    /// @param maxInterval      [in] Longest interval between checks while the image is idle, in milliseconds.
+    /// @param idleChecks       [in] Number of consecutive unchanged checks before the interval starts to back off.
+    ///
+    MeaChangeDetector(int baseInterval, int maxInterval, int idleChecks);
+
+    /// Calculates a hash of the specified pixels. The hash is an FNV-1a
+    /// hash over whole pixels, which guarantees that any change to a single
+    /// pixel changes the hash. Pixels in the row padding are not included.
+    ///
+    /// @param pixels   [in] Pixels to hash.
+    ///
+    /// @return Hash of the pixels and their dimensions.
+    ///
+    static uint64_t Hash(const MeaPixelBuffer& pixels);
+
+    /// Compares the specified state with the state from the previous check
+    /// and adjusts the check interval accordingly.
+    ///
+    /// @param position     [in] Position being magnified.
+    /// @param zoomIndex    [in] Magnifier zoom index.
+    /// @param pixelHash    [in] Hash of the captured pixels (see Hash).
+    ///
+    /// @return <b>true</b> if the state has changed and the image must be redrawn.
+    ///
+    bool Check(const POINT& position, int zoomIndex, uint64_t pixelHash);
+
+    /// Forces the next check to report a change and returns the check
+    /// interval to its base value. Call this when something other than the
+    /// checked state affects the image (e.g. the grid is toggled).
+    ///
+    void Invalidate();
+
+    /// Returns the time to wait before the next check.
+    ///
+    /// @return Check interval, in milliseconds.
+    ///
+    int GetInterval() const { return m_interval; }
+
+    /// Returns the detector statistics.
+    ///
+    /// @return Statistics accumulated since the detector was constructed.
+    ///
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    int m_baseInterval;         ///< Interval between checks while changing.
+    int m_maxInterval;          ///< Longest interval between checks while idle.
+    int m_idleChecks;           ///< Number of unchanged checks before backing off.
+    int m_interval;             ///< Current check interval.
+    int m_idleCount;            ///< Number of consecutive unchanged checks.
+    bool m_valid;               ///< Indicates whether the previous state is valid.
+    POINT m_position;           ///< Position from the previous check.
+    int m_zoomIndex;            ///< Zoom index from the previous check.
+    uint64_t m_pixelHash;       ///< Pixel hash from the previous check.
+    Stats m_stats;              ///< Detector statistics.
+};
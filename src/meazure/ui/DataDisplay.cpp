@@ -22,6 +22,7 @@
 #include "Layout.h"
 #include "ScreenMgr.h"
 #include <meazure/resource.h>
+#include <meazure/utilities/NumberFormat.h>
 #include <meazure/utilities/NumericUtils.h>
 #include <meazure/utilities/Geometry.h>
 #include <stdio.h>
@@ -32,6 +33,7 @@
 BEGIN_MESSAGE_MAP(MeaDataDisplay, CWnd)
     ON_MESSAGE(MeaFieldEnterMsg, OnFieldEntry)
     ON_MESSAGE(MeaFieldArrowMsg, OnFieldEntry)
+    ON_CONTROL_RANGE(EN_CHANGE, MeaX1Field, MeaYVField, OnFieldChange)
     ON_MESSAGE(WM_HELPHITTEST, OnHelpHitTest)
 END_MESSAGE_MAP()
 
@@ -39,6 +41,7 @@ END_MESSAGE_MAP()
 BEGIN_MESSAGE_MAP(MeaDataSection, CButton)
     ON_MESSAGE(MeaFieldEnterMsg, OnFieldEntry)
     ON_MESSAGE(MeaFieldArrowMsg, OnFieldEntry)
+    ON_CONTROL_RANGE(EN_CHANGE, MeaX1Field, MeaYVField, OnFieldChange)
     ON_BN_CLICKED(IDC_MEA_CAL_BTN, OnCalButton)
 END_MESSAGE_MAP()
 
@@ -446,68 +449,63 @@ void MeaDataDisplay::Disable(MeaSection section) {
 }
 
 void MeaDataDisplay::ShowXY1(const POINT& point, const MeaFPoint& cpoint) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
     m_x1.SetSpinPos(point.x);
     m_y1.SetSpinPos(point.y);
 
-    m_x1.SetText(unitsMgr.Format(MeaX, cpoint.x));
-    m_y1.SetText(unitsMgr.Format(MeaY, cpoint.y));
+    ShowValue(m_x1, MeaX, cpoint.x);
+    ShowValue(m_y1, MeaY, cpoint.y);
 }
 
 void MeaDataDisplay::ShowXY2(const POINT& point, const MeaFPoint& cpoint) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
     m_x2.SetSpinPos(point.x);
     m_y2.SetSpinPos(point.y);
 
-    m_x2.SetText(unitsMgr.Format(MeaX, cpoint.x));
-    m_y2.SetText(unitsMgr.Format(MeaY, cpoint.y));
+    ShowValue(m_x2, MeaX, cpoint.x);
+    ShowValue(m_y2, MeaY, cpoint.y);
 }
 
 void MeaDataDisplay::ShowXYV(const POINT& point, const MeaFPoint& cpoint) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
     m_xv.SetSpinPos(point.x);
     m_yv.SetSpinPos(point.y);
 
-    m_xv.SetText(unitsMgr.Format(MeaX, cpoint.x));
-    m_yv.SetText(unitsMgr.Format(MeaY, cpoint.y));
+    ShowValue(m_xv, MeaX, cpoint.x);
+    ShowValue(m_yv, MeaY, cpoint.y);
 }
 
 void MeaDataDisplay::ShowWH(const MeaFSize& size) {
-    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
-
-    m_width.SetText(unitsMgr.Format(MeaW, size.cx));
-    m_height.SetText(unitsMgr.Format(MeaH, size.cy));
+    ShowValue(m_width, MeaW, size.cx);
+    ShowValue(m_height, MeaH, size.cy);
 }
 
 void MeaDataDisplay::ShowDistance(const MeaFSize& size) {
-    m_length.SetText(MeaUnitsMgr::Instance().Format(MeaD, MeaGeometry::CalcLength(size.cx, size.cy)));
+    ShowValue(m_length, MeaD, MeaGeometry::CalcLength(size.cx, size.cy));
 }
 
 void MeaDataDisplay::ShowDistance(double dist) {
-    m_length.SetText(MeaUnitsMgr::Instance().Format(MeaD, dist));
+    ShowValue(m_length, MeaD, dist);
 }
 
 void MeaDataDisplay::ShowAngle(double angle) {
-    m_angle.SetText(MeaUnitsMgr::Instance().FormatConvertAngle(angle));
+    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
+    double convertedAngle = unitsMgr.ConvertAngle(angle);
+
+    m_angle.SetText(convertedAngle, unitsMgr.GetAngularUnits()->GetDisplayPrecisions()[MeaA],
+                    [&unitsMgr, convertedAngle] { return unitsMgr.FormatNumber(MeaA, convertedAngle); });
 }
 
 void MeaDataDisplay::ShowAspect(const MeaFSize& size) {
     double aspectRatio = (size.cy == 0) ? 0.0 : ((double)size.cx / (double)size.cy);
 
-    CString vstr;
-    vstr.Format(_T("%0.*f"), kAspectPrecision, aspectRatio);
-    m_aspect.SetText(vstr);
+    m_aspect.SetText(aspectRatio, kAspectPrecision,
+                     [aspectRatio] { return MeaNumberFormat::FormatFixed(aspectRatio, kAspectPrecision); });
 }
 
 void MeaDataDisplay::ShowRectArea(const MeaFSize& size) {
-    m_area.SetText(MeaUnitsMgr::Instance().Format(MeaAr, size.cx * size.cy));
+    ShowValue(m_area, MeaAr, size.cx * size.cy);
 }
 
 void MeaDataDisplay::ShowCircleArea(double radius) {
-    m_area.SetText(MeaUnitsMgr::Instance().Format(MeaAr, MeaNumericUtils::PI * radius * radius));
+    ShowValue(m_area, MeaAr, MeaNumericUtils::PI * radius * radius);
 }
 
 void MeaDataDisplay::ShowScreenName(const CString& name) {
@@ -515,17 +513,20 @@ void MeaDataDisplay::ShowScreenName(const CString& name) {
 }
 
 void MeaDataDisplay::ShowScreenWH(const MeaFSize& size) {
-    MeaUnitsMgr& units = MeaUnitsMgr::Instance();
-
-    m_screenWidth.SetText(units.Format(MeaW, size.cx));
-    m_screenHeight.SetText(units.Format(MeaH, size.cy));
+    ShowValue(m_screenWidth, MeaW, size.cx);
+    ShowValue(m_screenHeight, MeaH, size.cy);
 }
 
 void MeaDataDisplay::ShowScreenRes(const MeaFSize& res) {
-    MeaUnitsMgr& units = MeaUnitsMgr::Instance();
+    ShowValue(m_screenResX, MeaRx, res.cx);
+    ShowValue(m_screenResY, MeaRy, res.cy);
+}
 
-    m_screenResX.SetText(units.Format(MeaRx, res.cx));
-    m_screenResY.SetText(units.Format(MeaRy, res.cy));
+void MeaDataDisplay::ShowValue(DataItem& item, MeaLinearMeasurementId id, double value) {
+    MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
+
+    item.SetText(value, unitsMgr.GetLinearUnits()->GetDisplayPrecisions()[id],
+                 [&unitsMgr, id, value] { return unitsMgr.FormatNumber(id, value); });
 }
 
 void MeaDataDisplay::EnableRegionFields(UINT enableFields, UINT editableFields) {
@@ -596,50 +597,81 @@ MeaNumberField* MeaDataDisplay::GetFieldFocus() const {
     return (iter == m_fields.end()) ? nullptr : (*iter);
 }
 
+MeaFieldTextCache::Stats MeaDataDisplay::GetTextStats() const {
+    const DataItem* items[] = {
+        &m_x1, &m_y1, &m_x2, &m_y2, &m_xv, &m_yv, &m_width, &m_height, &m_length, &m_angle, &m_aspect, &m_area,
+        &m_screenWidth, &m_screenHeight, &m_screenResX, &m_screenResY
+    };
+    MeaFieldTextCache::Stats stats {};
+
+    for (const DataItem* item : items) {
+        const MeaFieldTextCache::Stats& itemStats = item->GetTextStats();
+        stats.updates += itemStats.updates;
+        stats.formatsSkipped += itemStats.formatsSkipped;
+        stats.textsSkipped += itemStats.textsSkipped;
+    }
+
+    return stats;
+}
+
 LRESULT MeaDataSection::OnFieldEntry(WPARAM wParam, LPARAM id) {
     GetParent()->SendMessage(MeaFieldEnterMsg, wParam, id);
     return TRUE;
 }
 
+void MeaDataSection::OnFieldChange(UINT id) {
+    CWnd* field = GetDlgItem(id);
+    if (field != nullptr) {
+        GetParent()->SendMessage(WM_COMMAND, MAKEWPARAM(id, EN_CHANGE), reinterpret_cast<LPARAM>(field->GetSafeHwnd()));
+    }
+}
+
 LRESULT MeaDataDisplay::OnFieldEntry(WPARAM wParam, LPARAM id) {
     MeaFPoint pos;
     LONG pixels = 0;
     const MeaNumberField* field = nullptr;
+    DataItem* item = nullptr;
     MeaUnitsMgr& unitsMgr = MeaUnitsMgr::Instance();
 
     switch (id) {
     case MeaX1Field:
         field = &m_x1.GetField();
+        item = &m_x1;
         pos.x = m_x1.GetValue();
         pos.y = m_y1.GetValue();
         pixels = unitsMgr.UnconvertCoord(pos).x;
         break;
     case MeaY1Field:
         field = &m_y1.GetField();
+        item = &m_y1;
         pos.x = m_x1.GetValue();
         pos.y = m_y1.GetValue();
         pixels = unitsMgr.UnconvertCoord(pos).y;
         break;
     case MeaX2Field:
         field = &m_x2.GetField();
+        item = &m_x2;
         pos.x = m_x2.GetValue();
         pos.y = m_y2.GetValue();
         pixels = unitsMgr.UnconvertCoord(pos).x;
         break;
     case MeaY2Field:
         field = &m_y2.GetField();
+        item = &m_y2;
         pos.x = m_x2.GetValue();
         pos.y = m_y2.GetValue();
         pixels = unitsMgr.UnconvertCoord(pos).y;
         break;
     case MeaXVField:
         field = &m_xv.GetField();
+        item = &m_xv;
         pos.x = m_xv.GetValue();
         pos.y = m_yv.GetValue();
         pixels = unitsMgr.UnconvertCoord(pos).x;
         break;
     case MeaYVField:
         field = &m_yv.GetField();
+        item = &m_yv;
         pos.x = m_xv.GetValue();
         pos.y = m_yv.GetValue();
         pixels = unitsMgr.UnconvertCoord(pos).y;
@@ -649,6 +681,13 @@ LRESULT MeaDataDisplay::OnFieldEntry(WPARAM wParam, LPARAM id) {
         break;
     }
 
+    // The field text was entered by the user so it must be replaced when
+    // the tool reports the resulting position, even if it is unchanged.
+    //
+    if (item != nullptr) {
+        item->InvalidateText();
+    }
+
     GetParent()->SendMessage(MeaDataChangeMsg, static_cast<WPARAM>(pixels) + wParam, id);
     assert(field != nullptr);
     const_cast<MeaNumberField*>(field)->SetFocus();
@@ -656,6 +695,40 @@ LRESULT MeaDataDisplay::OnFieldEntry(WPARAM wParam, LPARAM id) {
     return TRUE;
 }
 
+void MeaDataDisplay::OnFieldChange(UINT id) {
+    DataItem* item = nullptr;
+
+    switch (id) {
+    case MeaX1Field:
+        item = &m_x1;
+        break;
+    case MeaY1Field:
+        item = &m_y1;
+        break;
+    case MeaX2Field:
+        item = &m_x2;
+        break;
+    case MeaY2Field:
+        item = &m_y2;
+        break;
+    case MeaXVField:
+        item = &m_xv;
+        break;
+    case MeaYVField:
+        item = &m_yv;
+        break;
+    default:
+        return;
+    }
+
+    // Setting the field text programmatically clears the field's modified
+    // flag, so the flag is only set when the user has typed in the field.
+    //
+    if (item->GetField().GetModify()) {
+        item->InvalidateText();
+    }
+}
+
 LRESULT MeaDataDisplay::OnHelpHitTest(WPARAM, LPARAM lparam) {
     CPoint point(GET_X_LPARAM(lparam), GET_Y_LPARAM(lparam));
     if (m_regionSectionRect.PtInRect(point)) {
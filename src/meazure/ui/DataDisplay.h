@@ -23,6 +23,7 @@
 #pragma once
 
 #include "DataFieldId.h"
+#include "FieldTextCache.h"
 #include "NumberField.h"
 #include "Label.h"
 #include "Themes.h"
@@ -63,6 +64,13 @@ protected:
     ///
     afx_msg LRESULT OnFieldEntry(WPARAM wParam, LPARAM id);
 
+    /// Called when the text in one of the coordinate text fields changes.
+    /// The notification is passed on to the data display.
+    ///
+    /// @param id       [in] ID of the text field.
+    ///
+    afx_msg void OnFieldChange(UINT id);
+
     /// Called when spin control UDN_DELTAPOS messages are sent.
     ///
     /// @param wParam       [in] Control ID
@@ -283,6 +291,14 @@ public:
     ///
     MeaNumberField* GetFieldFocus() const;
 
+    /// Returns the combined text cache statistics for all data fields. The
+    /// statistics indicate how many field updates were able to skip value
+    /// formatting and setting the field text.
+    ///
+    /// @return Text cache statistics.
+    ///
+    MeaFieldTextCache::Stats GetTextStats() const;
+
 protected:
     /// Called when the Enter key is pressed on one of the text fields.
     ///
@@ -293,6 +309,15 @@ protected:
     ///
     afx_msg LRESULT OnFieldEntry(WPARAM wParam, LPARAM id);
 
+    /// Called when the text in one of the coordinate text fields changes.
+    /// If the change was made by the user, the field's text cache is
+    /// invalidated so that the next position update replaces the typed
+    /// text, even if the position is unchanged.
+    ///
+    /// @param id           [in] ID of the text field.
+    ///
+    afx_msg void OnFieldChange(UINT id);
+
     /// Determines where the help cursor was clicked and provides
     /// the appropriate ID.
     ///
@@ -445,9 +470,39 @@ private:
         /// @param text     [in] Text to display.
         ///
         void SetText(PCTSTR text) {
-            m_field.SetWindowText(text);
+            if (m_textCache.Update(text)) {
+                m_field.SetWindowText(text);
+            }
         }
 
+        /// Displays the specified value in the data item's text field. The
+        /// value is only formatted if it or its precision has changed since
+        /// it was last displayed, and the field is only updated if the
+        /// resulting text has changed.
+        ///
+        /// @param value        [in] Value to display.
+        /// @param precision    [in] Number of decimal places the value is formatted with.
+        /// @param format       [in] Function returning the formatted value.
+        ///
+        template <typename Formatter>
+        void SetText(double value, int precision, Formatter format) {
+            if (m_textCache.Update(value, precision, format)) {
+                m_field.SetWindowText(m_textCache.GetText());
+            }
+        }
+
+        /// Forces the next value or text displayed in the data item to be
+        /// set into its text field. Used when the field contents may have
+        /// been changed by the user.
+        ///
+        void InvalidateText() { m_textCache.Invalidate(); }
+
+        /// Returns the statistics for the data item's text cache.
+        ///
+        /// @return Text cache statistics.
+        ///
+        const MeaFieldTextCache::Stats& GetTextStats() const { return m_textCache.GetStats(); }
+
         /// Returns the contents of the data item's text field converted to
         /// a double precision floating point value.
         ///
@@ -535,6 +590,7 @@ private:
         CSpinButtonCtrl* m_spin;        ///< Spin control associated with the text field or nullptr if no spin
                                         ///< control for this data item.
         MeaUnitsLabel* m_unitsLabel;    ///< Units label or nullptr if no units label for this data item.
+        MeaFieldTextCache m_textCache;  ///< Last value and text displayed in the text field.
     };
 
 
@@ -564,6 +620,15 @@ private:
     ///
     bool CreateScreenSection();
 
+    /// Displays the specified linear measurement value in a data item,
+    /// formatted using the current units.
+    ///
+    /// @param item     [in] Data item in which to display the value.
+    /// @param id       [in] Identifies the measurement.
+    /// @param value    [in] Value to display, in the current units.
+    ///
+    void ShowValue(DataItem& item, MeaLinearMeasurementId id, double value);
+
 
     MeaDataSection m_regionSection;     ///< Measurement tool display section.
     MeaDataSection m_screenSection;     ///< Screen information display section.
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the cache of the text displayed in a data field.
+
+#pragma once
+
+
+/// Remembers the value last displayed in a data field and the text it was
+/// formatted into. Formatting is skipped when the value and the precision
+/// used to format it are unchanged, and the caller is told to update the
+/// field only when the resulting text differs from what is displayed. The
+/// cache has no dependency on the field window so that it can be tested
+/// independently.
+///
+class MeaFieldTextCache {
+
+public:
+    /// Cache statistics for diagnostic purposes.
+    ///
+    struct Stats {
+        unsigned long updates;          ///< Number of requests to display a value or text.
+        unsigned long formatsSkipped;   ///< Number of value updates that did not require formatting.
+        unsigned long textsSkipped;     ///< Number of updates that did not require the field text to be set.
+    };
+
+
+    MeaFieldTextCache() : m_haveValue(false), m_haveText(false), m_value(0.0), m_precision(0), m_stats() {}
+
+    /// Requests the display of the specified value.
+    ///
+    /// @param value        [in] Value to display.
+    /// @param precision    [in] Number of decimal places the value is formatted with.
+    /// @param format       [in] Function returning the formatted value as a
+    ///                     string convertible to PCTSTR (e.g. MeaNumberString).
+    ///                     Only called if the value or precision has changed.
+    ///
+    /// @return <b>true</b> if the text has changed and must be set into the field.
+    ///
+    template <typename Formatter>
+    bool Update(double value, int precision, Formatter format) {
+        m_stats.updates++;
+
+        if (m_haveValue && value == m_value && precision == m_precision) {
+            m_stats.formatsSkipped++;
+            m_stats.textsSkipped++;
+            return false;
+        }
+
+        m_haveValue = true;
+        m_value = value;
+        m_precision = precision;
+
+        return ChangeText(format());
+    }
+
+    /// Requests the display of the specified text (e.g. to clear the field).
+    ///
+    /// @param text     [in] Text to display.
+    ///
+    /// @return <b>true</b> if the text has changed and must be set into the field.
+    ///
+    bool Update(PCTSTR text) {
+        m_stats.updates++;
+        m_haveValue = false;
+        return ChangeText(text);
+    }
+
+    /// Returns the text most recently requested for display.
+    ///
+    /// @return Field text.
+    ///
+    const CString& GetText() const { return m_text; }
+
+    /// Forgets the cached value and text so that the next update is always
+    /// formatted and set into the field. Call this when the field contents
+    /// may have been changed by other means (e.g. edited by the user).
+    ///
+    void Invalidate() {
+        m_haveValue = false;
+        m_haveText = false;
+    }
+
+    /// Returns the cache statistics.
+    ///
+    /// @return Statistics accumulated since the cache was constructed.
+    ///
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    /// Records the specified text as the field text.
+    ///
+    /// @param text     [in] Text to display.
+    ///
+    /// @return <b>true</b> if the text differs from the current field text.
+    ///
+    bool ChangeText(PCTSTR text) {
+        if (m_haveText && m_text == text) {
+            m_stats.textsSkipped++;
+            return false;
+        }
+
+        m_haveText = true;
+        m_text = text;
+        return true;
+    }
+
+    bool m_haveValue;       ///< Indicates whether m_value and m_precision are valid.
+    bool m_haveText;        ///< Indicates whether m_text reflects the field contents.
+    double m_value;         ///< Value last displayed.
+    int m_precision;        ///< Precision used to format m_value.
+    CString m_text;         ///< Text last set into the field.
+    Stats m_stats;          ///< Cache statistics.
+};
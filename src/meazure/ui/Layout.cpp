@@ -19,7 +19,56 @@
 
 #include <meazure/pch.h>
 #include "Layout.h"
+#include "OpacityTile.h"
 #include <stdarg.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace {
+    /// Obtains the pattern brush for drawing the opacity background dots of the specified size. The brush is
+    /// created from a rendered tile the first time a dot size is requested and reused thereafter.
+    ///
+    /// @param dotSize  [in] Width and height of a dot, in pixels.
+    ///
+    /// @return Pattern brush for the dot size.
+    ///
+    CBrush& GetOpacityBrush(const SIZE& dotSize) {
+        static std::map<std::pair<LONG, LONG>, CBrush> brushes;
+
+        CBrush& brush = brushes[std::make_pair(dotSize.cx, dotSize.cy)];
+        if (brush.GetSafeHandle() == nullptr) {
+            const SIZE tileSize = MeaOpacityTile::GetTileSize(dotSize);
+            std::vector<uint32_t> tile;
+            MeaOpacityTile::Render(dotSize, tile);
+
+            // Pack the tile as a bottom-up 32 bit DIB.
+            //
+            const std::size_t width = static_cast<std::size_t>(tileSize.cx);
+            std::vector<BYTE> dib(sizeof(BITMAPINFOHEADER) + tile.size() * sizeof(uint32_t));
+
+            BITMAPINFOHEADER* header = reinterpret_cast<BITMAPINFOHEADER*>(dib.data());
+            header->biSize = sizeof(BITMAPINFOHEADER);
+            header->biWidth = tileSize.cx;
+            header->biHeight = tileSize.cy;
+            header->biPlanes = 1;
+            header->biBitCount = 32;
+            header->biCompression = BI_RGB;
+
+            uint32_t* bits = reinterpret_cast<uint32_t*>(dib.data() + sizeof(BITMAPINFOHEADER));
+            for (LONG y = 0; y < tileSize.cy; y++) {
+                const uint32_t* row = tile.data() + static_cast<std::size_t>(tileSize.cy - 1 - y) * width;
+                std::copy(row, row + width, bits + static_cast<std::size_t>(y) * width);
+            }
+
+            brush.CreateDIBPatternBrush(dib.data(), DIB_RGB_COLORS);
+        }
+
+        return brush;
+    }
+}
 
 
 void MeaLayout::AlignLeft(int leftX, ...) {
@@ -147,26 +196,22 @@ void MeaLayout::DrawOpacityBackground(const CWnd& wnd, CDC& dc, const MeaScreenP
     CRect clientRect;
     CRect winRect;
 
-    COLORREF foreColor = RGB(0, 0, 0);
-    COLORREF backColor = RGB(0xFF, 0xFF, 0xFF);
-
     wnd.GetClientRect(clientRect);
     wnd.GetWindowRect(winRect);
 
-    dc.FillSolidRect(clientRect.left, clientRect.top, clientRect.Width(), clientRect.Height(), backColor);
-
     MeaFSize res = screenProvider.GetScreenRes(screenProvider.GetScreenIter(winRect));
 
     SIZE forePixels = unitsProvider.ConvertToPixels(MeaInchesId, res, 0.02, 3);
-    CSize sepPixels(3 * forePixels.cx, 3 * forePixels.cy);
-
-    int x, y;
 
-    for (x = clientRect.left; x < clientRect.right; x += sepPixels.cx) {
-        for (y = clientRect.top; y < clientRect.bottom; y += sepPixels.cy) {
-            dc.FillSolidRect(x, y, forePixels.cx, forePixels.cy, foreColor);
-        }
-    }
+    // Fill the client area in one call with a brush made from a single
+    // tile of the dot pattern, rather than drawing each dot separately.
+    // The brush origin places a dot at the top left of the client area.
+    //
+    CPoint oldOrg = dc.SetBrushOrg(clientRect.left, clientRect.top);
+    CBrush* oldBrush = dc.SelectObject(&GetOpacityBrush(forePixels));
+    dc.PatBlt(clientRect.left, clientRect.top, clientRect.Width(), clientRect.Height(), PATCOPY);
+    dc.SelectObject(oldBrush);
+    dc.SetBrushOrg(oldOrg);
 }
 
 int MeaLayout::GetEffectiveDPI(const CWnd& wnd) {
@@ -23,11 +23,73 @@
 #include "ScreenMgr.h"
 #include <meazure/resource.h>
 #include <meazure/graphics/Colors.h>
+#include <meazure/graphics/PixelZoom.h>
 #include <AfxPriv.h>
 #include <cassert>
 #include <string.h>
 
 
+MeaMagnifier::Surface::Surface() :
+    m_dc(nullptr),
+    m_bitmap(nullptr),
+    m_oldBitmap(nullptr),
+    m_bits(nullptr),
+    m_width(0),
+    m_height(0) {}
+
+MeaMagnifier::Surface::~Surface() {
+    Destroy();
+}
+
+bool MeaMagnifier::Surface::Create(int width, int height) {
+    Destroy();
+
+    BITMAPINFO info;
+    memset(&info, 0, sizeof(info));
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height;          // Top-down
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = nullptr;
+    m_bitmap = ::CreateDIBSection(nullptr, &info, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (m_bitmap == nullptr) {
+        return false;
+    }
+
+    m_dc = ::CreateCompatibleDC(nullptr);
+    if (m_dc == nullptr) {
+        ::DeleteObject(m_bitmap);
+        m_bitmap = nullptr;
+        return false;
+    }
+
+    m_oldBitmap = ::SelectObject(m_dc, m_bitmap);
+    m_bits = static_cast<DWORD*>(bits);
+    m_width = width;
+    m_height = height;
+    return true;
+}
+
+void MeaMagnifier::Surface::Destroy() {
+    if (m_dc != nullptr) {
+        ::SelectObject(m_dc, m_oldBitmap);
+        ::DeleteDC(m_dc);
+        m_dc = nullptr;
+    }
+    if (m_bitmap != nullptr) {
+        ::DeleteObject(m_bitmap);
+        m_bitmap = nullptr;
+    }
+    m_oldBitmap = nullptr;
+    m_bits = nullptr;
+    m_width = 0;
+    m_height = 0;
+}
+
+
 BEGIN_MESSAGE_MAP(MeaMagnifier, CWnd)
     ON_WM_PAINT()
     ON_WM_HSCROLL()
@@ -43,9 +105,16 @@ m_curPos(0, 0),
 m_enabled(true),
 m_runState(kDefRunState),
 m_colorFmt(kDefColorFmt),
+m_basicMatchTable(MeaColors::GetBasicColors()),
+m_extendedMatchTable(MeaColors::GetExtendedColors()),
 m_zoomIndex(kDefZoomIndex),
 m_showGrid(kDefShowGrid),
-m_magHeight(0) {}
+m_magHeight(0),
+m_swatchColor(RGB(0, 0, 0)),
+m_changeDetector(kUpdateRate, kMaxUpdateRate, kIdleUpdates),
+m_markerBrush(RGB(0xFF, 0, 0)) {
+    ResetDrawStats();
+}
 
 
 MeaMagnifier::~MeaMagnifier() {
@@ -160,7 +229,7 @@ bool MeaMagnifier::Create(const POINT& topLeft, int width, CWnd* parentWnd) {
     m_zoomSlider.SetPos(0);
 
     m_timer.Create(this);
-    OnHPTimer(0, 0);
+    StartRefresh();
 
     return true;
 }
@@ -188,13 +257,35 @@ void MeaMagnifier::MasterReset() {
     SetRunState(kDefRunState);
 }
 
+void MeaMagnifier::SetColorFmt(ColorFmt colorFmt) {
+    m_colorFmt = colorFmt;
+
+    // Matching every refresh against a color table is costly, so the
+    // table for a named format is precomputed once it is first selected.
+    //
+    switch (m_colorFmt) {
+    case BasicNameFmt:
+    case BasicHexFmt:
+        m_basicMatchTable.BuildAsync();
+        break;
+    case ExtendedNameFmt:
+    case ExtendedHexFmt:
+        m_extendedMatchTable.BuildAsync();
+        break;
+    default:
+        break;
+    }
+
+    Update();
+}
+
 void MeaMagnifier::Enable() {
     if (!m_enabled) {
         m_enabled = true;
 
         if (m_hWnd != nullptr) {
             ShowWindow(SW_SHOW);
-            OnHPTimer(0, 0);
+            StartRefresh();
         }
     }
 }
@@ -228,7 +319,7 @@ void MeaMagnifier::ChangeRunState(RunState runState) {
 
         if (m_enabled) {
             if (m_runState == RunState::Run) {
-                OnHPTimer(0, 0);
+                StartRefresh();
             } else {
                 m_timer.Stop();
             }
@@ -238,18 +329,63 @@ void MeaMagnifier::ChangeRunState(RunState runState) {
 
 void MeaMagnifier::Update() {
     if (IsEnabled()) {
-        CRect rect;
         CString str;
 
-        GetClientRect(rect);
-        rect.bottom = rect.right;
-
         str.Format(_T("%d X"), kZoomFactorArr[m_zoomIndex]);
         m_factorLabel.SetWindowText(str);
 
-        InvalidateRect(rect, FALSE);
-        UpdateWindow();
+        m_changeDetector.Invalidate();
+        Refresh();
+    }
+}
+
+void MeaMagnifier::StartRefresh() {
+    Update();
+    m_timer.Start(m_changeDetector.GetInterval());
+}
+
+void MeaMagnifier::Refresh() {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    Clock::time_point frameStart = Clock::now();
+
+    CaptureResult result = Capture();
+
+    if (result == CaptureResult::Failed) {
+        // Nothing was captured. Creating the surfaces is retried on the
+        // next refresh.
+        //
+        m_drawStats.captureFailures++;
+        return;
+    }
+
+    if (result == CaptureResult::Unchanged) {
+        // The swatch window does not paint itself, so keep it current even
+        // though the image is unchanged.
+        //
+        m_drawStats.framesSkipped++;
+        PaintSwatch();
+        return;
+    }
+
+    Compose();
+
+    Clock::duration frameTime = Clock::now() - frameStart;
+    m_drawStats.frames++;
+    m_drawStats.lastFrameTime = frameTime;
+    m_drawStats.totalFrameTime += frameTime;
+    if (frameTime > m_drawStats.maxFrameTime) {
+        m_drawStats.maxFrameTime = frameTime;
     }
+
+    CRect rect;
+    GetClientRect(rect);
+    rect.bottom = rect.right;
+
+    InvalidateRect(rect, FALSE);
+    UpdateWindow();
 }
 
 LRESULT MeaMagnifier::OnHelpHitTest(WPARAM, LPARAM) {
@@ -263,9 +399,9 @@ void MeaMagnifier::OnHScroll(UINT /* nSBCode */, UINT /* nPos */,
 }
 
 LRESULT MeaMagnifier::OnHPTimer(WPARAM, LPARAM) {
-    Update();
+    Refresh();
 
-    m_timer.Start(kUpdateRate);
+    m_timer.Start(m_changeDetector.GetInterval());
 
     return 0;
 }
@@ -275,10 +411,38 @@ void MeaMagnifier::OnPaint() {
     Draw(dc);
 }
 
-void MeaMagnifier::Draw(HDC hDC) {
-    int srcLen, j;
-    int xCoord, yCoord;
+void MeaMagnifier::ResetDrawStats() {
+    m_drawStats.frames = 0;
+    m_drawStats.framesSkipped = 0;
+    m_drawStats.bufferRebuilds = 0;
+    m_drawStats.captureFailures = 0;
+    m_drawStats.lastFrameTime = Clock::duration::zero();
+    m_drawStats.maxFrameTime = Clock::duration::zero();
+    m_drawStats.totalFrameTime = Clock::duration::zero();
+}
+
+bool MeaMagnifier::PrepareSurfaces(int width, int height) {
+    if (m_backBuffer.GetDC() != nullptr && m_backBuffer.GetWidth() == width && m_backBuffer.GetHeight() == height) {
+        return true;
+    }
+
+    m_drawStats.bufferRebuilds++;
+    m_changeDetector.Invalidate();
 
+    // The largest source region is captured at the 1X zoom factor.
+    //
+    MeaPixelZoom::Layout maxLayout = MeaPixelZoom::CenterLayout(width, height, 1);
+
+    if (!m_backBuffer.Create(width, height) || !m_capture.Create(maxLayout.srcWidth, maxLayout.srcHeight)) {
+        m_backBuffer.Destroy();
+        m_capture.Destroy();
+        return false;
+    }
+
+    return true;
+}
+
+MeaMagnifier::CaptureResult MeaMagnifier::Capture() {
     //
     // Center the magnifier around cursor
     //
@@ -287,33 +451,27 @@ void MeaMagnifier::Draw(HDC hDC) {
     }
 
     //
-    // Initialize the destination rectangle
+    // The magnified image is square and occupies the top of the window.
     //
     CRect rect;
     GetClientRect(rect);
 
-    CRect dstRect(0, 0, rect.Width(), rect.Width());
-    int dstWidth = dstRect.Width();
-    int dstHeight = dstRect.Height();
+    int dstWidth = rect.Width();
+    int dstHeight = rect.Width();
 
-    //
-    // Create a memory context
-    //
-    HDC memDC = ::CreateCompatibleDC(hDC);
-    HBITMAP memBmp = ::CreateCompatibleBitmap(hDC, dstWidth, dstHeight);
-    HGDIOBJ memBmpOld = ::SelectObject(memDC, memBmp);
+    if (!PrepareSurfaces(dstWidth, dstHeight)) {
+        return CaptureResult::Failed;
+    }
 
     //
-    // Calculate the size of the source rectangle
+    // Calculate the source rectangle. Each source pixel is magnified into a
+    // square cell of zoom factor pixels with the cell for the pixel under
+    // the cursor centered in the magnifier.
     //
-    srcLen = (dstWidth / kZoomFactorArr[m_zoomIndex]) / 2;
-    if (srcLen == 0) {
-        srcLen = 1;
-    }
-    CRect srcRect((m_curPos.x - srcLen) + 1, (m_curPos.y - srcLen) + 1,
-                    m_curPos.x + srcLen, m_curPos.y + srcLen);
-    int srcWidth = srcRect.Width();
-    int srcHeight = srcRect.Height();
+    m_layout = MeaPixelZoom::CenterLayout(dstWidth, dstHeight, kZoomFactorArr[m_zoomIndex]);
+
+    CRect srcRect(CPoint(m_curPos.x - m_layout.centerX, m_curPos.y - m_layout.centerY),
+                  CSize(m_layout.srcWidth, m_layout.srcHeight));
 
     // Get the screen corresponding to the current position.
     //
@@ -321,85 +479,75 @@ void MeaMagnifier::Draw(HDC hDC) {
     CRect screenRect = mgr.GetScreenRect(mgr.GetScreenIter(m_curPos));
 
     //
-    // Determine if the source rectangle extends beyond the screen, and if so,
-    // clear the edges to black and set the clip region.
+    // Capture the source rectangle from the screen. If the source rectangle
+    // extends beyond the screen, the portion outside the screen is black.
     //
-    if (srcRect.left < screenRect.left || srcRect.right > screenRect.right ||
-            srcRect.top < screenRect.top || srcRect.bottom > screenRect.bottom) {
-        RECT clipRect;
-
-        clipRect.left = (srcRect.left < screenRect.left) ? screenRect.left : srcRect.left;
-        clipRect.top = (srcRect.top < screenRect.top) ? screenRect.top : srcRect.top;
-        clipRect.right = (srcRect.right > screenRect.right) ? screenRect.right : srcRect.right;
-        clipRect.bottom = (srcRect.bottom > screenRect.bottom) ? screenRect.bottom : srcRect.bottom;
-
-        clipRect.left = (clipRect.left - srcRect.left) * dstWidth / srcWidth;
-        clipRect.right = (clipRect.right - srcRect.left) * dstWidth / srcWidth;
-        clipRect.top = (clipRect.top - srcRect.top) * dstHeight / srcHeight;
-        clipRect.bottom = (clipRect.bottom - srcRect.top) * dstHeight / srcHeight;
-
-        ::BitBlt(memDC, dstRect.left, dstRect.top, dstRect.right, dstRect.bottom, 0, 0, 0, BLACKNESS);
+    HDC captureDC = m_capture.GetDC();
+    CRect visibleRect;
+    visibleRect.IntersectRect(srcRect, screenRect);
+    if (visibleRect != srcRect) {
+        ::BitBlt(captureDC, 0, 0, srcRect.Width(), srcRect.Height(), nullptr, 0, 0, BLACKNESS);
+    }
 
-        CRgn rgn;
-        rgn.CreateRectRgnIndirect(&clipRect);
-        ::SelectClipRgn(memDC, rgn);
+    if (!visibleRect.IsRectEmpty()) {
+        HDC screenDC = ::GetDC(nullptr);
+        ::BitBlt(captureDC, visibleRect.left - srcRect.left, visibleRect.top - srcRect.top,
+                 visibleRect.Width(), visibleRect.Height(), screenDC, visibleRect.left, visibleRect.top, SRCCOPY);
+        ::ReleaseDC(nullptr, screenDC);
     }
 
+    ::GdiFlush();
+
     //
-    // Blt the screen to the magnifier.
+    // Only redraw if something has changed since the last capture. The hash
+    // of the source block is cheap compared with zooming and painting it.
     //
-    ::SetStretchBltMode(hDC, COLORONCOLOR);
-    HDC screenDC = ::GetDC(nullptr);
-    COLORREF colorValue = ::GetPixel(screenDC, m_curPos.x, m_curPos.y);
-    ::StretchBlt(memDC, 0, 0, dstWidth, dstHeight, screenDC, srcRect.left, srcRect.top, srcWidth, srcHeight, SRCCOPY);
-    ::ReleaseDC(nullptr, screenDC);
+    MeaPixelBuffer srcPixels { reinterpret_cast<uint32_t*>(m_capture.GetBits()), m_layout.srcWidth,
+                               m_layout.srcHeight, m_capture.GetWidth() };
 
-    ::FrameRect(memDC, dstRect, static_cast<HBRUSH>(GetStockObject(BLACK_BRUSH)));
+    bool changed = m_changeDetector.Check(m_curPos, m_zoomIndex, MeaChangeDetector::Hash(srcPixels));
+    return changed ? CaptureResult::Changed : CaptureResult::Unchanged;
+}
+
+void MeaMagnifier::Compose() {
+    HDC backDC = m_backBuffer.GetDC();
+    int dstWidth = m_backBuffer.GetWidth();
+    int dstHeight = m_backBuffer.GetHeight();
+    CRect dstRect(0, 0, dstWidth, dstHeight);
+    int zoomFactor = kZoomFactorArr[m_zoomIndex];
 
     //
-    // Draw the grid on the image.
+    // The color of the pixel under the cursor is read from the captured
+    // pixels.
     //
-    if (m_showGrid && (kZoomFactorArr[m_zoomIndex] >= kMinGridFactor)) {
-        CPen gridPen(PS_SOLID, 1, RGB(0, 0, 0));
-        HGDIOBJ hOld = ::SelectObject(memDC, gridPen);
-
-        for (j = 0; j < srcWidth; j++) {
-            xCoord = j * dstWidth / srcWidth;
-            ::MoveToEx(memDC, xCoord, 0, nullptr);
-            ::LineTo(memDC, xCoord, dstHeight);
-        }
-        for (j = 0; j < srcHeight; j++) {
-            yCoord = j * dstHeight / srcHeight;
-            ::MoveToEx(memDC, 0, yCoord, nullptr);
-            ::LineTo(memDC, dstWidth, yCoord);
-        }
-        ::DeleteObject(::SelectObject(memDC, hOld));
-    }
+    DWORD pixel = m_capture.GetBits()[m_layout.centerY * m_capture.GetWidth() + m_layout.centerX];
+    COLORREF colorValue = RGB((pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF, pixel & 0xFF);
 
     //
-    // Draw the center marker on the image.
+    // Zoom the captured pixels into the back buffer, drawing the grid if
+    // the cells are large enough for it not to obscure the image.
     //
-    xCoord = srcWidth / 2;
-    yCoord = srcHeight / 2;
+    MeaPixelBuffer srcPixels { reinterpret_cast<uint32_t*>(m_capture.GetBits()), m_layout.srcWidth,
+                               m_layout.srcHeight, m_capture.GetWidth() };
+    MeaPixelBuffer dstPixels { reinterpret_cast<uint32_t*>(m_backBuffer.GetBits()), dstWidth, dstHeight,
+                               m_backBuffer.GetWidth() };
+    bool showGrid = m_showGrid && (zoomFactor >= kMinGridFactor);
 
-    CRect centerRect(
-        xCoord * dstWidth / srcWidth,                   // Left
-        yCoord * dstHeight / srcHeight,                 // Top
-        (xCoord + 1) * dstWidth / srcWidth + 1,         // Right
-        (yCoord + 1) * dstHeight / srcHeight + 1        // Bottom
-    );
-
-    CBrush brush(RGB(0xFF, 0, 0));
-    ::FrameRect(memDC, &centerRect, brush);
+    MeaPixelZoom::Zoom(srcPixels, dstPixels, zoomFactor, m_layout.offsetX, m_layout.offsetY, showGrid);
 
-    ::BitBlt(hDC, dstRect.left, dstRect.top, dstRect.right, dstRect.bottom, memDC, 0, 0, SRCCOPY);
+    ::FrameRect(backDC, dstRect, static_cast<HBRUSH>(GetStockObject(BLACK_BRUSH)));
 
     //
-    // Clean up blt objects
+    // Draw the center marker on the image.
     //
-    ::SelectObject(memDC, memBmpOld);
-    ::DeleteObject(memBmp);
-    ::DeleteDC(memDC);
+    CRect centerRect(
+        m_layout.cellX,                                 // Left
+        m_layout.cellY,                                 // Top
+        m_layout.cellX + zoomFactor + 1,                // Right
+        m_layout.cellY + zoomFactor + 1                 // Bottom
+    );
+
+    ::FrameRect(backDC, &centerRect, m_markerBrush);
 
     //
     // Report the color information
@@ -462,7 +610,7 @@ void MeaMagnifier::Draw(HDC hDC) {
     case BasicNameFmt:
         {
             colorLbl = _T("Basic:");
-            const MeaColors::ColorTableEntry* color = MeaColors::MatchBasicColor(colorValue);
+            const MeaColors::ColorTableEntry* color = MatchBasicColor(colorValue);
             colorStr = color->name;
             swatchColor = color->rgb;
         }
@@ -470,7 +618,7 @@ void MeaMagnifier::Draw(HDC hDC) {
     case BasicHexFmt:
         {
             colorLbl = _T("Basic:");
-            const MeaColors::ColorTableEntry* color = MeaColors::MatchBasicColor(colorValue);
+            const MeaColors::ColorTableEntry* color = MatchBasicColor(colorValue);
             colorStr.Format(_T("#%02X%02X%02X"), GetRValue(color->rgb), GetGValue(color->rgb), GetBValue(color->rgb));
             swatchColor = color->rgb;
         }
@@ -478,7 +626,7 @@ void MeaMagnifier::Draw(HDC hDC) {
     case ExtendedNameFmt:
         {
             colorLbl = _T("Ext:");
-            const MeaColors::ColorTableEntry* color = MeaColors::MatchExtendedColor(colorValue);
+            const MeaColors::ColorTableEntry* color = MatchExtendedColor(colorValue);
             colorStr = color->name;
             swatchColor = color->rgb;
         }
@@ -486,7 +634,7 @@ void MeaMagnifier::Draw(HDC hDC) {
     case ExtendedHexFmt:
         {
             colorLbl = _T("Ext:");
-            const MeaColors::ColorTableEntry* color = MeaColors::MatchExtendedColor(colorValue);
+            const MeaColors::ColorTableEntry* color = MatchExtendedColor(colorValue);
             colorStr.Format(_T("#%02X%02X%02X"), GetRValue(color->rgb), GetGValue(color->rgb), GetBValue(color->rgb));
             swatchColor = color->rgb;
         }
@@ -504,13 +652,24 @@ void MeaMagnifier::Draw(HDC hDC) {
         m_swatchField.SetWindowText(colorStr);
     }
 
+    m_swatchColor = swatchColor;
+    PaintSwatch();
+}
+
+void MeaMagnifier::PaintSwatch() {
     RECT colorRect;
     m_swatchWin.GetClientRect(&colorRect);
     CDC* dc = m_swatchWin.GetDC();
-    dc->FillSolidRect(&colorRect, swatchColor);
+    dc->FillSolidRect(&colorRect, m_swatchColor);
     m_swatchWin.ReleaseDC(dc);
 }
 
+void MeaMagnifier::Draw(HDC hDC) {
+    if (m_backBuffer.GetDC() != nullptr) {
+        ::BitBlt(hDC, 0, 0, m_backBuffer.GetWidth(), m_backBuffer.GetHeight(), m_backBuffer.GetDC(), 0, 0, SRCCOPY);
+    }
+}
+
 void MeaMagnifier::OnCopyColor() {
     CString colorStr;
     m_swatchField.GetWindowText(colorStr);
@@ -26,9 +26,13 @@
 #include "TextField.h"
 #include "Themes.h"
 #include "ImageButton.h"
+#include "ChangeDetector.h"
 #include <meazure/Messages.h>
 #include <meazure/utilities/Timer.h>
 #include <meazure/profile/Profile.h>
+#include <meazure/graphics/PixelZoom.h>
+#include <meazure/graphics/ColorMatchTable.h>
+#include <chrono>
 
 
 /// Provides a screen magnifier window complete with freeze frame, optional
@@ -73,6 +77,21 @@ public:
     };
 
 
+    typedef std::chrono::steady_clock Clock;    ///< Clock used to time the drawing of the magnified image.
+
+    /// Drawing statistics for diagnostic purposes.
+    ///
+    struct DrawStats {
+        unsigned long frames;           ///< Number of magnified images drawn.
+        unsigned long framesSkipped;    ///< Number of refreshes skipped because the image had not changed.
+        unsigned long bufferRebuilds;   ///< Number of times the back buffer was (re)created.
+        unsigned long captureFailures;  ///< Number of refreshes abandoned because the surfaces could not be created.
+        Clock::duration lastFrameTime;  ///< Time taken to capture and draw the most recent image.
+        Clock::duration maxFrameTime;   ///< Longest time taken to draw an image.
+        Clock::duration totalFrameTime; ///< Total time spent drawing images.
+    };
+
+
     static constexpr int kDefZoomIndex { 1 };                   ///< Default index for the zoom factor.
     static constexpr bool kDefShowGrid { true };                ///< Indicates whether the grid should be display by default.
     static constexpr ColorFmt kDefColorFmt { RGBFmt };          ///< Default color display format.
@@ -179,14 +198,13 @@ public:
     ///
     int GetZoomIndex() const { return m_zoomIndex; }
 
-    /// Sets the color display format.
+    /// Sets the color display format. Selecting a named color format
+    /// starts building the corresponding color match table in the
+    /// background.
     ///
     /// @param colorFmt     [in] Color format specifier.
     ///
-    void SetColorFmt(ColorFmt colorFmt) {
-        m_colorFmt = colorFmt;
-        Update();
-    }
+    void SetColorFmt(ColorFmt colorFmt);
 
     /// Returns the current color display format.
     ///
@@ -235,6 +253,16 @@ public:
         return (GetFocus() == &m_swatchField) ? &m_swatchField : nullptr;
     }
 
+    /// Returns the magnifier drawing statistics.
+    ///
+    /// @return Statistics accumulated since construction or the last call to ResetDrawStats.
+    ///
+    const DrawStats& GetDrawStats() const { return m_drawStats; }
+
+    /// Clears the magnifier drawing statistics.
+    ///
+    void ResetDrawStats();
+
 protected:
     DECLARE_MESSAGE_MAP()
 
@@ -272,6 +300,8 @@ protected:
 
 private:
     static constexpr int kUpdateRate { 70 };        ///< Magnifier refresh rate, in milliseconds.
+    static constexpr int kMaxUpdateRate { 280 };    ///< Slowest refresh rate while the image is unchanged, in milliseconds.
+    static constexpr int kIdleUpdates { 10 };       ///< Unchanged refreshes before the refresh rate starts to slow.
     static constexpr int kBaseZoomHeight { 22 };    ///< Height of the zoom factor slider, in pixels.
     static constexpr int kBaseZoomSpace { 9 };      ///< Vertical separation between color info and zoom slider.
     static constexpr SIZE kBaseMargin { 5, 5 };     ///< Margin around the magnifier window.
@@ -281,14 +311,146 @@ private:
     static constexpr int kMinZoomIndex { 0 };       ///< Index of the minimum allowable zoom factor.
     static constexpr int kMinGridFactor { 6 };      ///< Minimum zoom factor below which the grid is not displayed.
 
+    /// Outcome of capturing the region around the cursor.
+    ///
+    enum class CaptureResult {
+        Changed,        ///< The captured image, position or zoom changed and the image must be redrawn.
+        Unchanged,      ///< The capture is the same as the previous one.
+        Failed          ///< The drawing surfaces could not be created so nothing was captured.
+    };
+
+
+    /// A 32 bit per pixel, top-down DIB section selected into a memory
+    /// device context. The pixels can be drawn using GDI and accessed
+    /// directly. Surfaces are kept between draws so that the GDI objects
+    /// do not need to be created and destroyed for each image.
+    ///
+    class Surface {
+
+    public:
+        Surface();
+        ~Surface();
+
+        Surface(const Surface&) = delete;
+        Surface& operator=(const Surface&) = delete;
+
+        /// Creates the surface, compatible with the screen, replacing any
+        /// existing bitmap.
+        ///
+        /// @param width    [in] Width of the surface, in pixels.
+        /// @param height   [in] Height of the surface, in pixels.
+        ///
+        /// @return <b>true</b> if the surface was created.
+        ///
+        bool Create(int width, int height);
+
+        /// Releases the GDI objects for the surface.
+        ///
+        void Destroy();
+
+        /// Returns the memory device context into which the surface bitmap is selected.
+        ///
+        /// @return Memory device context, or nullptr if the surface has not been created.
+        ///
+        HDC GetDC() const { return m_dc; }
+
+        /// Returns the surface pixels. Each pixel is stored as 0x00RRGGBB. Call
+        /// GdiFlush before accessing the pixels after drawing with GDI.
+        ///
+        /// @return Pointer to the first pixel of the top row.
+        ///
+        DWORD* GetBits() const { return m_bits; }
+
+        /// Returns the width of the surface.
+        ///
+        /// @return Width of the surface, in pixels.
+        ///
+        int GetWidth() const { return m_width; }
+
+        /// Returns the height of the surface.
+        ///
+        /// @return Height of the surface, in pixels.
+        ///
+        int GetHeight() const { return m_height; }
+
+    private:
+        HDC m_dc;                   ///< Memory device context.
+        HBITMAP m_bitmap;           ///< DIB section selected into m_dc.
+        HGDIOBJ m_oldBitmap;        ///< Bitmap originally selected into m_dc.
+        DWORD* m_bits;              ///< Pixels of the DIB section.
+        int m_width;                ///< Width of the surface, in pixels.
+        int m_height;               ///< Height of the surface, in pixels.
+    };
+
+
+
+    /// Captures and redraws the magnified image if it has changed, and
+    /// repaints the window.
+    ///
+    void Refresh();
+
+    /// Reads an appropriately sized region around the cursor into the
+    /// capture surface.
+    ///
+    /// @return Whether the image must be redrawn, or whether the capture
+    ///         failed. A failed capture is not reported to the change
+    ///         detector, so it does not slow the refresh rate.
+    ///
+    CaptureResult Capture();
+
+    /// Zooms the captured image into the back buffer and reports the color
+    /// of the pixel under the cursor.
+    ///
+    void Compose();
 
-    /// Reads an appropriately sized region around the cursor and
-    /// zooms it into the magnifier window.
+    /// Fills the color swatch with the most recently reported color.
+    ///
+    void PaintSwatch();
+
+    /// Paints the most recently composed image into the magnifier window.
     ///
     /// @param hDC      [in] Magnifier window device context.
     ///
     void Draw(HDC hDC);
 
+    /// Starts refreshing the magnifier periodically, beginning with an
+    /// immediate redraw.
+    ///
+    void StartRefresh();
+
+    /// Ensures the back buffer and capture surfaces exist and match the
+    /// size of the magnified image. The surfaces are only recreated when
+    /// the size changes (e.g. on a DPI change).
+    ///
+    /// @param width    [in] Width of the magnified image, in pixels.
+    /// @param height   [in] Height of the magnified image, in pixels.
+    ///
+    /// @return <b>true</b> if the surfaces are ready for drawing.
+    ///
+    bool PrepareSurfaces(int width, int height);
+
+    /// Finds the closest Web basic color, using the basic color match
+    /// table once it has been built.
+    ///
+    /// @param rgb      [in] Color to match.
+    /// @return Closest Web basic color.
+    ///
+    const MeaColors::ColorTableEntry* MatchBasicColor(COLORREF rgb) const {
+        const MeaColors::ColorTableEntry* color = m_basicMatchTable.Lookup(rgb);
+        return (color != nullptr) ? color : MeaColors::MatchBasicColor(rgb);
+    }
+
+    /// Finds the closest Web extended color, using the extended color
+    /// match table once it has been built.
+    ///
+    /// @param rgb      [in] Color to match.
+    /// @return Closest Web extended color.
+    ///
+    const MeaColors::ColorTableEntry* MatchExtendedColor(COLORREF rgb) const {
+        const MeaColors::ColorTableEntry* color = m_extendedMatchTable.Lookup(rgb);
+        return (color != nullptr) ? color : MeaColors::MatchExtendedColor(rgb);
+    }
+
     /// Performs the work of changing the display run mode.
     ///
     /// @param runState [in] Indicates the desired display run state.
@@ -303,6 +465,8 @@ private:
     MeaImageButton m_runStateBtn;   ///< Magnifier pause button.
     MeaTimer m_timer;               ///< Refresh timer.
     ColorFmt m_colorFmt;            ///< Pixel color display format.
+    MeaColorMatchTable m_basicMatchTable;       ///< Precomputed matches against the Web basic colors.
+    MeaColorMatchTable m_extendedMatchTable;    ///< Precomputed matches against the Web extended colors.
     MeaLabel m_swatchLabel;         ///< Label for the pixel color swatch.
     MeaTextField m_swatchField;     ///< Text field to display the pixel color.
     CWnd m_swatchWin;               ///< Window for the pixel color swatch.
@@ -312,4 +476,11 @@ private:
     int m_zoomIndex;                ///< Currently selected zoom factor index.
     bool m_showGrid;                ///< Indicates whether the grid should be displayed, if possible.
     int m_magHeight;                ///< Height of the magnifier, in pixels.
+    COLORREF m_swatchColor;         ///< Color most recently displayed in the swatch.
+    Surface m_backBuffer;           ///< Magnified image composed off screen before being drawn to the window.
+    Surface m_capture;              ///< Unmagnified pixels captured from the screen.
+    MeaPixelZoom::Layout m_layout;  ///< Placement of the captured pixels in the magnified image.
+    MeaChangeDetector m_changeDetector; ///< Determines whether the image must be redrawn and the refresh rate.
+    CBrush m_markerBrush;           ///< Brush for the center pixel marker.
+    DrawStats m_drawStats;          ///< Drawing statistics.
 };
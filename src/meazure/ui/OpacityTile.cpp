@@ -0,0 +1,42 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "OpacityTile.h"
+#include <algorithm>
+#include <cstddef>
+
+
+SIZE MeaOpacityTile::GetTileSize(const SIZE& dotSize) {
+    return { kPitch * std::max<LONG>(dotSize.cx, 1), kPitch * std::max<LONG>(dotSize.cy, 1) };
+}
+
+void MeaOpacityTile::Render(const SIZE& dotSize, std::vector<uint32_t>& pixels) {
+    const SIZE tileSize = GetTileSize(dotSize);
+    const std::size_t width = static_cast<std::size_t>(tileSize.cx);
+    const std::size_t dotWidth = width / kPitch;
+    const LONG dotHeight = tileSize.cy / kPitch;
+
+    pixels.assign(width * static_cast<std::size_t>(tileSize.cy), kBackColor);
+
+    for (LONG y = 0; y < dotHeight; y++) {
+        auto row = pixels.begin() + static_cast<std::ptrdiff_t>(static_cast<std::size_t>(y) * width);
+        std::fill(row, row + static_cast<std::ptrdiff_t>(dotWidth), kDotColor);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Tile of the dot pattern drawn behind translucent controls.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+
+/// Renders one tile of the dot pattern drawn by
+/// MeaLayout::DrawOpacityBackground. The pattern is a grid of square
+/// dots, with the dots separated by twice their size. The tile has a dot
+/// in its top left corner and repeats seamlessly, so that a pattern brush
+/// made from it reproduces the pattern over an area of any size.
+///
+namespace MeaOpacityTile {
+
+    constexpr uint32_t kDotColor = 0x00000000;      ///< Color of the dots, as stored in a 32 bit DIB.
+    constexpr uint32_t kBackColor = 0x00FFFFFF;     ///< Color between the dots, as stored in a 32 bit DIB.
+    constexpr int kPitch = 3;                       ///< Distance between the start of adjacent dots, in dot sizes.
+
+    /// Calculates the size of the tile for the specified dot size.
+    ///
+    /// @param dotSize  [in] Width and height of a dot, in pixels. Values less than 1 are treated as 1.
+    ///
+    /// @return Width and height of the tile, in pixels.
+    ///
+    SIZE GetTileSize(const SIZE& dotSize);
+
+    /// Renders the tile for the specified dot size.
+    ///
+    /// @param dotSize  [in] Width and height of a dot, in pixels. Values less than 1 are treated as 1.
+    /// @param pixels   [out] Tile pixels, stored top-down, row by row, with the tile width as the stride. Any
+    ///                 previous contents are replaced.
+    ///
+    void Render(const SIZE& dotSize, std::vector<uint32_t>& pixels);
+}
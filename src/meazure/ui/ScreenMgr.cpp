@@ -22,6 +22,7 @@
 #define COMPILE_MULTIMON_STUBS 1
 #include "ScreenMgr.h"
 #include <meazure/resource.h>
+#include <meazure/units/Units.h>
 #include <meazure/utilities/StringUtils.h>
 #include <cassert>
 
@@ -257,6 +258,8 @@ void MeaScreenMgr::LoadProfile(MeaProfile& profile) {
                 }
             }
         }
+
+        MeaLinearUnits::InvalidateConversions();
     }
 }
 
@@ -274,6 +277,8 @@ void MeaScreenMgr::MasterReset() const {
             screen->SetCalInInches(kDefCalInInches);
         }
     }
+
+    MeaLinearUnits::InvalidateConversions();
 }
 
 const CPoint& MeaScreenMgr::GetCenter() const {
@@ -389,6 +394,7 @@ const MeaFSize& MeaScreenMgr::GetScreenRes(const ScreenIter& iter) const {
 
 void MeaScreenMgr::SetScreenRes(const ScreenIter& iter, bool useManualRes, const MeaFSize* manualRes) const {
     (*iter).second->SetScreenRes(useManualRes, manualRes);
+    MeaLinearUnits::InvalidateConversions();
 }
 
 bool MeaScreenMgr::IsManualRes(const ScreenIter& iter) const { 
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "UpdateScheduler.h"
+
+
+MeaUpdateScheduler::MeaUpdateScheduler(Clock::duration frameInterval) :
+    m_frameInterval(frameInterval),
+    m_pending(false),
+    m_wParam(0),
+    m_lParam(0),
+    m_haveFrame(false) {
+    ResetStats();
+}
+
+MeaUpdateScheduler::Action MeaUpdateScheduler::AddEvent(WPARAM wParam, LPARAM lParam, Clock::time_point now) {
+    m_stats.eventsReceived++;
+
+    m_wParam = wParam;
+    m_lParam = lParam;
+
+    // A frame has already been requested for the event being replaced.
+    //
+    if (m_pending) {
+        m_stats.eventsCoalesced++;
+        return Coalesced;
+    }
+
+    m_pending = true;
+
+    return (GetFrameDelay(now) == Clock::duration::zero()) ? DispatchNow : ScheduleFrame;
+}
+
+MeaUpdateScheduler::Clock::duration MeaUpdateScheduler::GetFrameDelay(Clock::time_point now) const {
+    if (!m_haveFrame) {
+        return Clock::duration::zero();
+    }
+
+    Clock::time_point nextFrame = m_frameStart + m_frameInterval;
+    return (nextFrame > now) ? (nextFrame - now) : Clock::duration::zero();
+}
+
+bool MeaUpdateScheduler::BeginFrame(Clock::time_point now, WPARAM& wParam, LPARAM& lParam) {
+    if (!m_pending) {
+        return false;
+    }
+
+    wParam = m_wParam;
+    lParam = m_lParam;
+    m_pending = false;
+
+    m_haveFrame = true;
+    m_frameStart = now;
+
+    return true;
+}
+
+void MeaUpdateScheduler::EndFrame(Clock::time_point now) {
+    Clock::duration frameTime = now - m_frameStart;
+
+    m_stats.frames++;
+    m_stats.lastFrameTime = frameTime;
+    m_stats.totalFrameTime += frameTime;
+    if (frameTime > m_stats.maxFrameTime) {
+        m_stats.maxFrameTime = frameTime;
+    }
+}
+
+void MeaUpdateScheduler::ResetStats() {
+    m_stats.eventsReceived = 0;
+    m_stats.eventsCoalesced = 0;
+    m_stats.frames = 0;
+    m_stats.lastFrameTime = Clock::duration::zero();
+    m_stats.maxFrameTime = Clock::duration::zero();
+    m_stats.totalFrameTime = Clock::duration::zero();
+}
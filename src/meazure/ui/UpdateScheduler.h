@@ -0,0 +1,143 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the frame paced update scheduler.
+
+#pragma once
+
+#include <chrono>
+
+
+/// Paces updates driven by a high rate stream of events (e.g. mouse hook
+/// messages) to the display refresh rate. Events that arrive faster than
+/// a frame can be displayed are collapsed so that only the latest one is
+/// dispatched once per frame interval. The scheduler only makes decisions
+/// and keeps statistics. The caller supplies the current time, dispatches
+/// the event and arms a timer when asked to, which allows the coalescing
+/// logic to be exercised without a message loop.
+///
+class MeaUpdateScheduler {
+
+public:
+    typedef std::chrono::steady_clock Clock;    ///< Clock used to pace the frames.
+
+    /// Action the caller must take after adding an event.
+    ///
+    enum Action {
+        DispatchNow,        ///< A frame interval has elapsed since the last frame, dispatch the event immediately.
+        ScheduleFrame,      ///< Dispatch the event once the current frame interval has elapsed.
+        Coalesced           ///< The event replaced one already awaiting dispatch. No action is required.
+    };
+
+    /// Update statistics.
+    ///
+    struct Stats {
+        unsigned long eventsReceived;   ///< Number of events added.
+        unsigned long eventsCoalesced;  ///< Number of events replaced by a later event before dispatch.
+        unsigned long frames;           ///< Number of frames dispatched.
+        Clock::duration lastFrameTime;  ///< Time taken to process the most recent frame.
+        Clock::duration maxFrameTime;   ///< Longest time taken to process a frame.
+        Clock::duration totalFrameTime; ///< Total time spent processing frames.
+    };
+
+
+    /// Constructs a scheduler.
+    ///
+    /// @param frameInterval    [in] Minimum time between dispatched frames.
+    ///
+    explicit MeaUpdateScheduler(Clock::duration frameInterval = std::chrono::milliseconds(16));
+
+    /// Sets the minimum time between dispatched frames. Typically this is
+    /// the display refresh interval.
+    ///
+    /// @param frameInterval    [in] Minimum time between dispatched frames.
+    ///
+    void SetFrameInterval(Clock::duration frameInterval) { m_frameInterval = frameInterval; }
+
+    /// Returns the minimum time between dispatched frames.
+    ///
+    /// @return Frame interval.
+    ///
+    Clock::duration GetFrameInterval() const { return m_frameInterval; }
+
+    /// Records an event. The event replaces any event awaiting dispatch.
+    ///
+    /// @param wParam   [in] Event message parameter.
+    /// @param lParam   [in] Event message parameter.
+    /// @param now      [in] Time at which the event was received.
+    ///
+    /// @return Action the caller must take to have the event dispatched.
+    ///
+    Action AddEvent(WPARAM wParam, LPARAM lParam, Clock::time_point now);
+
+    /// Indicates whether an event is awaiting dispatch.
+    ///
+    /// @return <b>true</b> if an event is awaiting dispatch.
+    ///
+    bool HasPending() const { return m_pending; }
+
+    /// Returns the time remaining until the next frame may be dispatched.
+    ///
+    /// @param now      [in] Current time.
+    ///
+    /// @return Time until the next frame, zero if a frame may be dispatched now.
+    ///
+    Clock::duration GetFrameDelay(Clock::time_point now) const;
+
+    /// Starts a frame by taking the event awaiting dispatch.
+    ///
+    /// @param now      [in] Time at which the frame starts.
+    /// @param wParam   [out] Event message parameter.
+    /// @param lParam   [out] Event message parameter.
+    ///
+    /// @return <b>true</b> if there was an event to dispatch. If <b>false</b>
+    ///         is returned, EndFrame must not be called.
+    ///
+    bool BeginFrame(Clock::time_point now, WPARAM& wParam, LPARAM& lParam);
+
+    /// Completes the frame started by BeginFrame and records its duration.
+    ///
+    /// @param now      [in] Time at which the frame processing completed.
+    ///
+    void EndFrame(Clock::time_point now);
+
+    /// Discards any event awaiting dispatch.
+    ///
+    void Clear() { m_pending = false; }
+
+    /// Returns the update statistics.
+    ///
+    /// @return Statistics accumulated since construction or the last call to ResetStats.
+    ///
+    const Stats& GetStats() const { return m_stats; }
+
+    /// Zeroes the update statistics.
+    ///
+    void ResetStats();
+
+private:
+    Clock::duration m_frameInterval;    ///< Minimum time between dispatched frames.
+    bool m_pending;                     ///< Indicates whether an event is awaiting dispatch.
+    WPARAM m_wParam;                    ///< Message parameter of the event awaiting dispatch.
+    LPARAM m_lParam;                    ///< Message parameter of the event awaiting dispatch.
+    bool m_haveFrame;                   ///< Indicates whether a frame has been dispatched.
+    Clock::time_point m_frameStart;     ///< Time at which the last frame started.
+    Stats m_stats;                      ///< Update statistics.
+};
@@ -19,8 +19,16 @@
 
 #include <meazure/pch.h>
 #include "Units.h"
+#include <meazure/utilities/NumberFormat.h>
 #include <meazure/utilities/NumericUtils.h>
 #include <cmath>
+#include <algorithm>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+ /// SSE2 instructions are available for the batch coordinate conversions.
+#define MEA_UNITS_SSE2 1
+#include <emmintrin.h>
+#endif
 
 
 //*************************************************************************
@@ -90,9 +98,11 @@ MeaAngularUnits::MeaAngularUnits(MeaAngularUnitsId unitsId, PCTSTR unitsStr) :
 MeaAngularUnits::~MeaAngularUnits() {}
 
 CString MeaAngularUnits::Format(MeaAngularMeasurementId id, double value) const {
-    CString vstr;
-    vstr.Format(_T("%0.*f"), GetDisplayPrecisions()[id], value);
-    return vstr;
+    return FormatNumber(id, value).GetString();
+}
+
+MeaNumberString MeaAngularUnits::FormatNumber(MeaAngularMeasurementId id, double value) const {
+    return MeaNumberFormat::FormatFixed(value, GetDisplayPrecisions()[id]);
 }
 
 
@@ -133,10 +143,17 @@ double MeaRadianUnits::ConvertAngle(double angle) const {
 
 bool MeaLinearUnits::m_invertY = false;
 CPoint MeaLinearUnits::m_originOffset;
+unsigned int MeaLinearUnits::m_conversionEpoch = 0;
 
 
 MeaLinearUnits::MeaLinearUnits(MeaLinearUnitsId unitsId, PCTSTR unitsStr, const MeaScreenProvider& screenProvider) :
-    MeaUnits(unitsStr), m_unitsId(unitsId), m_screenProvider(screenProvider), m_majorTickCount(10) {
+    MeaUnits(unitsStr),
+    m_screenProvider(screenProvider),
+    m_unitsId(unitsId),
+    m_majorTickCount(10),
+    m_screenIndicesValid(false),
+    m_screenIndicesEpoch(0),
+    m_conversionCacheEpoch(0) {
     AddPrecisionName(_T("x"));      // MeaX
     AddPrecisionName(_T("y"));      // MeaY
     AddPrecisionName(_T("w"));      // MeaW
@@ -154,77 +171,43 @@ bool MeaLinearUnits::RequiresRes() const {
 }
 
 CString MeaLinearUnits::Format(MeaLinearMeasurementId id, double value) const {
-    CString vstr;
-    vstr.Format(_T("%0.*f"), GetDisplayPrecisions()[id], value);
-    return vstr;
+    return FormatNumber(id, value).GetString();
 }
 
-MeaFPoint MeaLinearUnits::ConvertCoord(const POINT& pos) const {
-    MeaFPoint fpos;
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(pos)));
-
-    fpos.x = fromPixels.cx * (pos.x - m_originOffset.x);
+MeaNumberString MeaLinearUnits::FormatNumber(MeaLinearMeasurementId id, double value) const {
+    return MeaNumberFormat::FormatFixed(value, GetDisplayPrecisions()[id]);
+}
 
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            fpos.y = fromPixels.cy * (m_screenProvider.GetVirtualRect().Height() - 1 - pos.y);
-        } else {
-            fpos.y = fromPixels.cy * (m_originOffset.y - pos.y);
-        }
-    } else {
-        fpos.y = fromPixels.cy * (pos.y - m_originOffset.y);
-    }
+MeaFPoint MeaLinearUnits::ConvertCoord(const POINT& pos) const {
+    const ConversionFactors& factors = GetConversionFactors(m_screenProvider.GetScreenIter(pos));
 
-    return fpos;
+    return MeaFPoint(factors.fromPixels.cx * (pos.x - m_originOffset.x), factors.yScale * (pos.y - factors.yOrigin));
 }
 
 double MeaLinearUnits::ConvertCoord(MeaConvertDir dir, const CWnd* wnd, int pos) const {
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(wnd)));
+    const ConversionFactors& factors = GetConversionFactors(m_screenProvider.GetScreenIter(wnd));
 
     if (dir == MeaConvertX) {
-        return fromPixels.cx * (pos - m_originOffset.x);
-    }
-
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            return fromPixels.cy * (m_screenProvider.GetVirtualRect().Height() - 1 - pos);
-        }
-        return fromPixels.cy * (m_originOffset.y - pos);
+        return factors.fromPixels.cx * (pos - m_originOffset.x);
     }
-    return fromPixels.cy * (pos - m_originOffset.y);
+    return factors.yScale * (pos - factors.yOrigin);
 }
 
 double MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double pos) const {
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(wnd)));
+    const ConversionFactors& factors = GetConversionFactors(m_screenProvider.GetScreenIter(wnd));
 
     if (dir == MeaConvertX) {
-        return pos / fromPixels.cx + m_originOffset.x;
+        return pos / factors.fromPixels.cx + m_originOffset.x;
     }
-
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            return  (m_screenProvider.GetVirtualRect().Height() - 1) - pos / fromPixels.cy;
-        }
-        return  m_originOffset.y - pos / fromPixels.cy;
-    }
-    return pos / fromPixels.cy + m_originOffset.y;
+    return pos / factors.yScale + factors.yOrigin;
 }
 
 POINT MeaLinearUnits::UnconvertCoord(const MeaFPoint& pos) const {
+    const ConversionFactors& factors = GetConversionFactors(FindScreenFromCoord(pos));
     POINT point;
-    MeaFSize fromPixels = FromPixels(FindResFromCoord(pos));
 
-    point.x = static_cast<long>(pos.x / fromPixels.cx + m_originOffset.x);
-
-    if (m_invertY) {
-        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
-            point.y = static_cast<long>((m_screenProvider.GetVirtualRect().Height() - 1) - pos.y / fromPixels.cy);
-        } else {
-            point.y = static_cast<long>(m_originOffset.y - pos.y / fromPixels.cy);
-        }
-    } else {
-        point.y = static_cast<long>(pos.y / fromPixels.cy + m_originOffset.y);
-    }
+    point.x = static_cast<long>(pos.x / factors.fromPixels.cx + m_originOffset.x);
+    point.y = static_cast<long>(pos.y / factors.yScale + factors.yOrigin);
 
     return point;
 }
@@ -269,15 +252,93 @@ bool MeaLinearUnits::UnconvertCoord(MeaConvertDir dir, const CWnd* wnd, double p
 }
 
 MeaFPoint MeaLinearUnits::ConvertPos(const POINT& pos) const {
-    MeaFSize fromPixels = FromPixels(m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter(pos)));
+    const MeaFSize& fromPixels = GetConversionFactors(m_screenProvider.GetScreenIter(pos)).fromPixels;
     return MeaFPoint(fromPixels.cx * pos.x, fromPixels.cy * pos.y);
 }
 
 POINT MeaLinearUnits::UnconvertPos(const MeaFPoint& pos) const {
-    MeaFSize fromPixels = FromPixels(FindResFromPos(pos));
+    const MeaFSize& fromPixels = GetConversionFactors(FindScreenFromPos(pos)).fromPixels;
     return CPoint(static_cast<long>(pos.x / fromPixels.cx), static_cast<long>(pos.y / fromPixels.cy));
 }
 
+void MeaLinearUnits::ConvertCoords(const POINT* coords, MeaFPoint* converted, size_t count) const {
+    size_t start = 0;
+
+    while (start < count) {
+        MeaScreenProvider::ScreenIter iter = m_screenProvider.GetScreenIter(coords[start]);
+        const CRect& srect = m_screenProvider.GetScreenRect(iter);
+        size_t end = start + 1;
+
+        while ((end < count) && srect.PtInRect(coords[end])) {
+            end++;
+        }
+
+        const ConversionFactors& factors = GetConversionFactors(iter);
+        POINT offset { m_originOffset.x, factors.yOrigin };
+        ScaleRun(coords + start, converted + start, end - start, offset,
+                 MeaFSize(factors.fromPixels.cx, factors.yScale));
+
+        start = end;
+    }
+}
+
+void MeaLinearUnits::ConvertPositions(const POINT* positions, MeaFPoint* converted, size_t count) const {
+    size_t start = 0;
+
+    while (start < count) {
+        MeaScreenProvider::ScreenIter iter = m_screenProvider.GetScreenIter(positions[start]);
+        const CRect& srect = m_screenProvider.GetScreenRect(iter);
+        size_t end = start + 1;
+
+        while ((end < count) && srect.PtInRect(positions[end])) {
+            end++;
+        }
+
+        POINT offset { 0, 0 };
+        ScaleRun(positions + start, converted + start, end - start, offset, GetConversionFactors(iter).fromPixels);
+
+        start = end;
+    }
+}
+
+void MeaLinearUnits::UnconvertCoords(const MeaFPoint* coords, POINT* converted, size_t count) const {
+    size_t start = 0;
+
+    while (start < count) {
+        MeaScreenProvider::ScreenIter iter = FindScreenFromCoord(coords[start]);
+        size_t end = start + 1;
+
+        while ((end < count) && (FindScreenFromCoord(coords[end]) == iter)) {
+            end++;
+        }
+
+        const ConversionFactors& factors = GetConversionFactors(iter);
+        POINT offset { m_originOffset.x, factors.yOrigin };
+        UnscaleRun(coords + start, converted + start, end - start, offset,
+                   MeaFSize(factors.fromPixels.cx, factors.yScale));
+
+        start = end;
+    }
+}
+
+void MeaLinearUnits::UnconvertPositions(const MeaFPoint* positions, POINT* converted, size_t count) const {
+    size_t start = 0;
+
+    while (start < count) {
+        MeaScreenProvider::ScreenIter iter = FindScreenFromPos(positions[start]);
+        size_t end = start + 1;
+
+        while ((end < count) && (FindScreenFromPos(positions[end]) == iter)) {
+            end++;
+        }
+
+        POINT offset { 0, 0 };
+        UnscaleRun(positions + start, converted + start, end - start, offset, GetConversionFactors(iter).fromPixels);
+
+        start = end;
+    }
+}
+
 MeaFSize MeaLinearUnits::ConvertRes(const MeaFSize& res) const {
     return MeaFSize(1.0 / GetResFromPixels(res).cx, 1.0 / GetResFromPixels(res).cy);
 }
@@ -287,39 +348,159 @@ MeaFSize MeaLinearUnits::GetResFromPixels(const MeaFSize& res) const {
 }
 
 const MeaFSize& MeaLinearUnits::FindResFromCoord(const MeaFPoint& pos) const {
+    return m_screenProvider.GetScreenRes(FindScreenFromCoord(pos));
+}
+
+const MeaFSize& MeaLinearUnits::FindResFromPos(const MeaFPoint& pos) const {
+    return m_screenProvider.GetScreenRes(FindScreenFromPos(pos));
+}
+
+MeaScreenProvider::ScreenIter MeaLinearUnits::FindScreenFromCoord(const MeaFPoint& pos) const {
     if (m_screenProvider.GetNumScreens() != 1) {
         MeaScreenProvider::ScreenIter iter;
 
-        for (iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter); ++iter) {
-            const CRect& srect = m_screenProvider.GetScreenRect(iter);
-            MeaFPoint tl = ConvertCoord(srect.TopLeft());
-            MeaFPoint br = ConvertCoord(srect.BottomRight());
-
-            if ((tl.x <= pos.x) && (br.x > pos.x) && (tl.y <= pos.y) && (br.y > pos.y)) {
-                return m_screenProvider.GetScreenRes(iter);
-            }
+        UpdateScreenIndices();
+        if (m_coordIndex.Find(pos, iter)) {
+            return iter;
         }
     }
 
-    return m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter());
+    return m_screenProvider.GetScreenIter();
 }
 
-const MeaFSize& MeaLinearUnits::FindResFromPos(const MeaFPoint& pos) const {
+MeaScreenProvider::ScreenIter MeaLinearUnits::FindScreenFromPos(const MeaFPoint& pos) const {
     if (m_screenProvider.GetNumScreens() != 1) {
         MeaScreenProvider::ScreenIter iter;
 
-        for (iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter); ++iter) {
-            const CRect& srect = m_screenProvider.GetScreenRect(iter);
-            MeaFPoint tl = ConvertPos(srect.TopLeft());
-            MeaFPoint br = ConvertPos(srect.BottomRight());
+        UpdateScreenIndices();
+        if (m_posIndex.Find(pos, iter)) {
+            return iter;
+        }
+    }
+
+    return m_screenProvider.GetScreenIter();
+}
 
-            if ((tl.x <= pos.x) && (br.x > pos.x) && (tl.y <= pos.y) && (br.y > pos.y)) {
-                return m_screenProvider.GetScreenRes(iter);
-            }
+void MeaLinearUnits::UpdateScreenIndices() const {
+    if (m_screenIndicesValid && (m_screenIndicesEpoch == m_conversionEpoch)) {
+        return;
+    }
+
+    m_coordIndex.Clear();
+    m_posIndex.Clear();
+
+    MeaScreenProvider::ScreenIter iter;
+
+    for (iter = m_screenProvider.GetScreenIter(); !m_screenProvider.AtEnd(iter); ++iter) {
+        const CRect& srect = m_screenProvider.GetScreenRect(iter);
+        m_coordIndex.Add(ConvertCoord(srect.TopLeft()), ConvertCoord(srect.BottomRight()), iter);
+        m_posIndex.Add(ConvertPos(srect.TopLeft()), ConvertPos(srect.BottomRight()), iter);
+    }
+
+    m_coordIndex.Build();
+    m_posIndex.Build();
+
+    m_screenIndicesValid = true;
+    m_screenIndicesEpoch = m_conversionEpoch;
+}
+
+void MeaLinearUnits::ScaleRun(const POINT* points, MeaFPoint* converted, size_t count, const POINT& offset,
+                              const MeaFSize& scale) {
+    size_t i = 0;
+
+#ifdef MEA_UNITS_SSE2
+    // A POINT is a pair of 32-bit integers and a MeaFPoint is a pair of doubles. Two points are loaded and
+    // offset together, and each is then converted to doubles and scaled as one packed pair.
+    //
+    static_assert(sizeof(POINT) == 2 * sizeof(int), "POINT must be a pair of 32-bit integers");
+    static_assert(sizeof(MeaFPoint) == 2 * sizeof(double), "MeaFPoint must be a pair of doubles");
+
+    const __m128i offsetVec = _mm_set_epi32(offset.y, offset.x, offset.y, offset.x);
+    const __m128d scaleVec = _mm_set_pd(scale.cy, scale.cx);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i pair = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(points + i)), offsetVec);
+        __m128d delta0 = _mm_cvtepi32_pd(pair);
+        __m128d delta1 = _mm_cvtepi32_pd(_mm_unpackhi_epi64(pair, pair));
+        _mm_storeu_pd(&converted[i].x, _mm_mul_pd(scaleVec, delta0));
+        _mm_storeu_pd(&converted[i + 1].x, _mm_mul_pd(scaleVec, delta1));
+    }
+
+    if (i < count) {
+        __m128i point = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(points + i));
+        __m128d delta = _mm_cvtepi32_pd(_mm_sub_epi32(point, offsetVec));
+        _mm_storeu_pd(&converted[i].x, _mm_mul_pd(scaleVec, delta));
+    }
+#else
+    for (; i < count; i++) {
+        converted[i].x = scale.cx * (points[i].x - offset.x);
+        converted[i].y = scale.cy * (points[i].y - offset.y);
+    }
+#endif
+}
+
+void MeaLinearUnits::UnscaleRun(const MeaFPoint* points, POINT* converted, size_t count, const POINT& offset,
+                                const MeaFSize& scale) {
+    size_t i = 0;
+
+#ifdef MEA_UNITS_SSE2
+    // Two points are converted per iteration and their truncated pixel values are combined into a single
+    // store. Dividing rather than multiplying by the reciprocal keeps the results identical to UnconvertCoord
+    // and UnconvertPos.
+    //
+    const __m128d offsetVec = _mm_set_pd(offset.y, offset.x);
+    const __m128d scaleVec = _mm_set_pd(scale.cy, scale.cx);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d pixels0 = _mm_add_pd(_mm_div_pd(_mm_loadu_pd(&points[i].x), scaleVec), offsetVec);
+        __m128d pixels1 = _mm_add_pd(_mm_div_pd(_mm_loadu_pd(&points[i + 1].x), scaleVec), offsetVec);
+        __m128i pair = _mm_unpacklo_epi64(_mm_cvttpd_epi32(pixels0), _mm_cvttpd_epi32(pixels1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(converted + i), pair);
+    }
+
+    if (i < count) {
+        __m128d pixels = _mm_add_pd(_mm_div_pd(_mm_loadu_pd(&points[i].x), scaleVec), offsetVec);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(converted + i), _mm_cvttpd_epi32(pixels));
+    }
+#else
+    for (; i < count; i++) {
+        converted[i].x = static_cast<long>(points[i].x / scale.cx + offset.x);
+        converted[i].y = static_cast<long>(points[i].y / scale.cy + offset.y);
+    }
+#endif
+}
+
+const MeaLinearUnits::ConversionFactors&
+MeaLinearUnits::GetConversionFactors(const MeaScreenProvider::ScreenIter& iter) const {
+    if (m_conversionCacheEpoch != m_conversionEpoch) {
+        m_conversionCache.clear();
+        m_conversionCacheEpoch = m_conversionEpoch;
+    }
+
+    auto cacheIter = m_conversionCache.find(iter);
+    if (cacheIter != m_conversionCache.end()) {
+        return (*cacheIter).second;
+    }
+
+    ConversionFactors factors;
+    factors.fromPixels = FromPixels(m_screenProvider.GetScreenRes(iter));
+
+    // With an inverted y-axis, y coordinates are measured upward from the bottom of the virtual screen
+    // unless the origin has been moved.
+    //
+    if (m_invertY) {
+        factors.yScale = -factors.fromPixels.cy;
+        if ((m_originOffset.x == 0) && (m_originOffset.y == 0)) {
+            factors.yOrigin = m_screenProvider.GetVirtualRect().Height() - 1;
+        } else {
+            factors.yOrigin = m_originOffset.y;
         }
+    } else {
+        factors.yScale = factors.fromPixels.cy;
+        factors.yOrigin = m_originOffset.y;
     }
 
-    return m_screenProvider.GetScreenRes(m_screenProvider.GetScreenIter());
+    return (*m_conversionCache.emplace(iter, factors).first).second;
 }
 
 SIZE MeaLinearUnits::ConvertToPixels(const MeaFSize& res, double value, int minPixels) const {
@@ -340,6 +521,90 @@ SIZE MeaLinearUnits::ConvertToPixels(const MeaFSize& res, double value, int minP
 }
 
 
+//*************************************************************************
+// MeaLinearUnits::ScreenIndex
+//*************************************************************************
+
+void MeaLinearUnits::ScreenIndex::Clear() {
+    m_bounds.clear();
+    m_xEdges.clear();
+    m_yEdges.clear();
+    m_cells.clear();
+}
+
+void MeaLinearUnits::ScreenIndex::Add(const MeaFPoint& topLeft, const MeaFPoint& bottomRight,
+                                      const MeaScreenProvider::ScreenIter& iter) {
+    m_bounds.push_back({ topLeft, bottomRight, iter });
+}
+
+void MeaLinearUnits::ScreenIndex::Build() {
+    m_xEdges.clear();
+    m_yEdges.clear();
+
+    for (const Bounds& bounds : m_bounds) {
+        m_xEdges.push_back(bounds.topLeft.x);
+        m_xEdges.push_back(bounds.bottomRight.x);
+        m_yEdges.push_back(bounds.topLeft.y);
+        m_yEdges.push_back(bounds.bottomRight.y);
+    }
+
+    std::sort(m_xEdges.begin(), m_xEdges.end());
+    m_xEdges.erase(std::unique(m_xEdges.begin(), m_xEdges.end()), m_xEdges.end());
+    std::sort(m_yEdges.begin(), m_yEdges.end());
+    m_yEdges.erase(std::unique(m_yEdges.begin(), m_yEdges.end()), m_yEdges.end());
+
+    // Every screen edge is a grid line so a screen either contains an entire cell or none of it.
+    // Testing the top left corner of a cell is therefore sufficient to determine the screen for
+    // any position within the cell.
+    //
+    const size_t numCols = m_xEdges.empty() ? 0 : m_xEdges.size() - 1;
+    const size_t numRows = m_yEdges.empty() ? 0 : m_yEdges.size() - 1;
+
+    m_cells.assign(numCols * numRows, -1);
+
+    for (size_t row = 0; row < numRows; row++) {
+        const double y = m_yEdges[row];
+
+        for (size_t col = 0; col < numCols; col++) {
+            const double x = m_xEdges[col];
+
+            for (size_t i = 0; i < m_bounds.size(); i++) {
+                const Bounds& bounds = m_bounds[i];
+
+                if ((bounds.topLeft.x <= x) && (bounds.bottomRight.x > x) &&
+                    (bounds.topLeft.y <= y) && (bounds.bottomRight.y > y)) {
+                    m_cells[row * numCols + col] = static_cast<int>(i);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool MeaLinearUnits::ScreenIndex::Find(const MeaFPoint& pos, MeaScreenProvider::ScreenIter& iter) const {
+    if (m_cells.empty()) {
+        return false;
+    }
+
+    const auto xIter = std::upper_bound(m_xEdges.begin(), m_xEdges.end(), pos.x);
+    const auto yIter = std::upper_bound(m_yEdges.begin(), m_yEdges.end(), pos.y);
+    if ((xIter == m_xEdges.begin()) || (xIter == m_xEdges.end()) ||
+        (yIter == m_yEdges.begin()) || (yIter == m_yEdges.end())) {
+        return false;
+    }
+
+    const size_t col = static_cast<size_t>(xIter - m_xEdges.begin()) - 1;
+    const size_t row = static_cast<size_t>(yIter - m_yEdges.begin()) - 1;
+    const int boundsIdx = m_cells[row * (m_xEdges.size() - 1) + col];
+    if (boundsIdx < 0) {
+        return false;
+    }
+
+    iter = m_bounds[boundsIdx].iter;
+    return true;
+}
+
+
 //*************************************************************************
 // MeaPixelUnits
 //*************************************************************************
@@ -23,9 +23,11 @@
 #pragma once
 
 #include <vector>
+#include <map>
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/profile/Profile.h>
 #include <meazure/utilities/Geometry.h>
+#include <meazure/utilities/NumberFormat.h>
 
 
 /// Identifiers for linear measurement units.
@@ -262,6 +264,18 @@ public:
     ///
     CString Format(MeaAngularMeasurementId id, double value) const;
 
+    /// Formats the specified angular measurement value using the precision
+    /// for the specified measurement ID. Unlike Format, the result is
+    /// returned in a fixed size buffer so no memory is allocated.
+    ///
+    /// @param id       [in] Identifier for the angular units whose precision
+    ///                 is to be used to format the specified value.
+    /// @param value    [in] Measurement value to be formatted.
+    ///
+    /// @return Measurement value formatted with the appropriate precision.
+    ///
+    MeaNumberString FormatNumber(MeaAngularMeasurementId id, double value) const;
+
     /// Converts the specified angle value from its native radians
     /// to the desired units.
     ///
@@ -366,7 +380,10 @@ public:
     ///                     display screen and making positive y pointing
     ///                     upward.
     ///
-    static void SetInvertY(bool invertY) { m_invertY = invertY; }
+    static void SetInvertY(bool invertY) {
+        m_invertY = invertY;
+        InvalidateConversions();
+    }
 
     /// Returns the orientation of the y-axis.
     ///
@@ -387,7 +404,10 @@ public:
     /// @param origin   [in] New location for the origin of the coordinate system.
     ///                 in pixels.
     ///
-    static void SetOrigin(const POINT& origin) { m_originOffset = origin; }
+    static void SetOrigin(const POINT& origin) {
+        m_originOffset = origin;
+        InvalidateConversions();
+    }
 
     /// Returns the location of the origin of the coordinate system.
     ///
@@ -395,6 +415,14 @@ public:
     ///
     static const POINT& GetOrigin() { return m_originOffset; }
 
+    /// Indicates that a parameter affecting the conversion between pixels and the
+    /// units has changed (e.g. the origin, the orientation of the y-axis, a screen
+    /// resolution calibration or the custom units scale). Any cached conversion
+    /// information held by the linear units is discarded and recomputed when next
+    /// needed.
+    ///
+    static void InvalidateConversions() { m_conversionEpoch++; }
+
     /// Internally all measurements are in pixels. Measurement units based
     /// solely on pixels do not require the use of the screen resolution for
     /// conversion. Measurement units such as inches, require the screen
@@ -420,6 +448,18 @@ public:
     ///
     CString Format(MeaLinearMeasurementId id, double value) const;
 
+    /// Formats the specified linear measurement value using the precision
+    /// for the specified measurement ID. Unlike Format, the result is
+    /// returned in a fixed size buffer so no memory is allocated.
+    ///
+    /// @param id       [in] Identifier for the linear units whose precision
+    ///                 is to be used to format the specified value.
+    /// @param value    [in] Measurement value to be formatted.
+    ///
+    /// @return Measurement value formatted with the appropriate precision.
+    ///
+    MeaNumberString FormatNumber(MeaLinearMeasurementId id, double value) const;
+
     /// Converts the specified coordinate from pixels to the desired units.
     /// This conversion takes into account the location of the origin and the
     /// orientation of the y-axis.
@@ -507,6 +547,48 @@ public:
     ///
     POINT UnconvertPos(const MeaFPoint& pos) const;
 
+    /// Converts the specified coordinates from pixels to the desired units. The
+    /// results are identical to calling ConvertCoord for each coordinate, however
+    /// the screen is only looked up when a coordinate leaves the screen containing
+    /// the previous coordinate.
+    ///
+    /// @param coords       [in] Coordinates in pixels to convert.
+    /// @param converted    [out] Receives the converted coordinates. Must have room
+    ///                     for count elements.
+    /// @param count        [in] Number of coordinates to convert.
+    ///
+    void ConvertCoords(const POINT* coords, MeaFPoint* converted, size_t count) const;
+
+    /// Converts the specified positions from pixels to the desired units. The
+    /// results are identical to calling ConvertPos for each position.
+    ///
+    /// @param positions    [in] Positions in pixels to convert.
+    /// @param converted    [out] Receives the converted positions. Must have room
+    ///                     for count elements.
+    /// @param count        [in] Number of positions to convert.
+    ///
+    void ConvertPositions(const POINT* positions, MeaFPoint* converted, size_t count) const;
+
+    /// Converts the specified coordinates from the current units to pixels. The
+    /// results are identical to calling UnconvertCoord for each coordinate.
+    ///
+    /// @param coords       [in] Coordinates in the current units to convert.
+    /// @param converted    [out] Receives the coordinates in pixels. Must have room
+    ///                     for count elements.
+    /// @param count        [in] Number of coordinates to convert.
+    ///
+    void UnconvertCoords(const MeaFPoint* coords, POINT* converted, size_t count) const;
+
+    /// Converts the specified positions from the current units to pixels. The
+    /// results are identical to calling UnconvertPos for each position.
+    ///
+    /// @param positions    [in] Positions in the current units to convert.
+    /// @param converted    [out] Receives the positions in pixels. Must have room
+    ///                     for count elements.
+    /// @param count        [in] Number of positions to convert.
+    ///
+    void UnconvertPositions(const MeaFPoint* positions, POINT* converted, size_t count) const;
+
     /// Converts the specified value from the current units to pixels. A minimum
     /// pixel value is specified in case the resolution is such that the conversion
     /// to pixels results in a value that is too small.
@@ -595,10 +677,143 @@ protected:
     const MeaScreenProvider& m_screenProvider;  ///< Screen information provider
 
 private:
+    /// Locates the screen containing a position expressed in the current units. The screen
+    /// rectangles are converted to the current units once and the distinct rectangle edges
+    /// are used to divide the plane into a grid of cells. Each cell records the first screen,
+    /// in screen iteration order, that contains it. Finding a screen therefore requires only
+    /// a binary search of the edges in each direction.
+    ///
+    class ScreenIndex {
+
+    public:
+        /// Removes all screens from the index.
+        ///
+        void Clear();
+
+        /// Adds a screen to the index. Screens must be added in screen iteration order.
+        ///
+        /// @param topLeft      [in] Top left corner of the screen, in the current units.
+        /// @param bottomRight  [in] Bottom right corner of the screen, in the current units.
+        /// @param iter         [in] Iterator pointing to the screen.
+        ///
+        void Add(const MeaFPoint& topLeft, const MeaFPoint& bottomRight, const MeaScreenProvider::ScreenIter& iter);
+
+        /// Constructs the lookup grid from the screens added to the index.
+        ///
+        void Build();
+
+        /// Finds the first screen containing the specified position. A screen contains a
+        /// position if the position is at or beyond the top left corner of the screen and
+        /// before its bottom right corner.
+        ///
+        /// @param pos      [in] Position to locate, in the current units.
+        /// @param iter     [out] Iterator pointing to the screen containing the position.
+        ///
+        /// @return <b>true</b> if a screen contains the position.
+        ///
+        bool Find(const MeaFPoint& pos, MeaScreenProvider::ScreenIter& iter) const;
+
+    private:
+        /// Screen rectangle in the current units.
+        ///
+        struct Bounds {
+            MeaFPoint topLeft;                      ///< Top left corner of the screen.
+            MeaFPoint bottomRight;                  ///< Bottom right corner of the screen.
+            MeaScreenProvider::ScreenIter iter;     ///< Screen occupying the rectangle.
+        };
+
+        std::vector<Bounds> m_bounds;       ///< Screen rectangles in screen iteration order.
+        std::vector<double> m_xEdges;       ///< Sorted distinct x coordinates of the screen rectangle edges.
+        std::vector<double> m_yEdges;       ///< Sorted distinct y coordinates of the screen rectangle edges.
+        std::vector<int> m_cells;           ///< Index into m_bounds for each grid cell, or -1 if no screen.
+    };
+
+
+    /// Factors for converting coordinates on a given screen between pixels and the units.
+    ///
+    struct ConversionFactors {
+        MeaFSize fromPixels;    ///< Factors to convert from pixels to the units (see FromPixels).
+        double yScale;          ///< Y conversion factor, negated if the y-axis is inverted.
+        LONG yOrigin;           ///< Pixel location from which y coordinates are measured.
+    };
+
+    /// Maps a screen to its conversion factors.
+    ///
+    typedef std::map<MeaScreenProvider::ScreenIter, ConversionFactors, MeaScreenProvider::less> ConversionCache;
+
+
+    /// Rebuilds the screen indices if a conversion parameter has changed since they were
+    /// last built.
+    ///
+    void UpdateScreenIndices() const;
+
+    /// Returns the factors for converting coordinates on the specified screen. The factors
+    /// are calculated the first time they are requested for a screen and cached until a
+    /// conversion parameter changes.
+    ///
+    /// @param iter     [in] Screen whose conversion factors are desired.
+    ///
+    /// @return Conversion factors for the screen.
+    ///
+    const ConversionFactors& GetConversionFactors(const MeaScreenProvider::ScreenIter& iter) const;
+
+    /// Locates the screen containing the specified coordinates. The method compensates for
+    /// the location of the origin and the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Coordinates in the current units.
+    ///
+    /// @return Screen containing the coordinates or the first screen if no screen contains them.
+    ///
+    MeaScreenProvider::ScreenIter FindScreenFromCoord(const MeaFPoint& pos) const;
+
+    /// Locates the screen containing the specified position. The method does not compensate
+    /// for the location of the origin nor the orientation of the y-axis.
+    ///
+    /// @param pos      [in] Position in the current units.
+    ///
+    /// @return Screen containing the position or the first screen if no screen contains it.
+    ///
+    MeaScreenProvider::ScreenIter FindScreenFromPos(const MeaFPoint& pos) const;
+
+    /// Converts a run of points from pixels using a single set of conversion factors. Each
+    /// converted point is calculated as:
+    /// \f[
+    ///     converted=scale \cdot (point-offset)
+    /// \f]
+    /// @param points       [in] Points in pixels.
+    /// @param converted    [out] Converted points.
+    /// @param count        [in] Number of points to convert.
+    /// @param offset       [in] Pixel offset subtracted from each point.
+    /// @param scale        [in] X and Y conversion factors.
+    ///
+    static void ScaleRun(const POINT* points, MeaFPoint* converted, size_t count, const POINT& offset,
+                         const MeaFSize& scale);
+
+    /// Converts a run of points to pixels using a single set of conversion factors. This is
+    /// the inverse of ScaleRun, with the result truncated to whole pixels:
+    /// \f[
+    ///     converted=\frac{point}{scale}+offset
+    /// \f]
+    /// @param points       [in] Points in the current units.
+    /// @param converted    [out] Converted points, in pixels.
+    /// @param count        [in] Number of points to convert.
+    /// @param offset       [in] Pixel offset added to each point.
+    /// @param scale        [in] X and Y conversion factors.
+    ///
+    static void UnscaleRun(const MeaFPoint* points, POINT* converted, size_t count, const POINT& offset,
+                           const MeaFSize& scale);
+
     static CPoint m_originOffset;               ///< Offset of the origin from the system origin, in pixels.
     static bool m_invertY;                      ///< Indicates if the y-axis direction is inverted.
+    static unsigned int m_conversionEpoch;      ///< Incremented whenever a conversion parameter changes.
     MeaLinearUnitsId m_unitsId;                 ///< Linear units identifier.
     int m_majorTickCount;                       ///< Number of minor ruler tick marks between major tick marks.
+    mutable ScreenIndex m_coordIndex;           ///< Screens located by coordinates (see FindResFromCoord).
+    mutable ScreenIndex m_posIndex;             ///< Screens located by position (see FindResFromPos).
+    mutable bool m_screenIndicesValid;          ///< Indicates if the screen indices have been built.
+    mutable unsigned int m_screenIndicesEpoch;  ///< Conversion epoch for which the screen indices were built.
+    mutable ConversionCache m_conversionCache;  ///< Conversion factors for each screen.
+    mutable unsigned int m_conversionCacheEpoch;    ///< Conversion epoch for which the cache is valid.
 };
 
 
@@ -931,7 +1146,10 @@ public:
     ///
     /// @param scaleBasis       [in] Conversion basis.
     ///
-    void SetScaleBasis(ScaleBasis scaleBasis) { m_scaleBasis = scaleBasis; }
+    void SetScaleBasis(ScaleBasis scaleBasis) {
+        m_scaleBasis = scaleBasis;
+        InvalidateConversions();
+    }
 
     /// Sets the conversion basis using a string identifier.
     ///
@@ -951,7 +1169,10 @@ public:
     /// @param scaleFactor  [in] Conversion factor from the conversion
     ///                     basis to the custom units.
     ///
-    void SetScaleFactor(double scaleFactor) { m_scaleFactor = scaleFactor; }
+    void SetScaleFactor(double scaleFactor) {
+        m_scaleFactor = scaleFactor;
+        InvalidateConversions();
+    }
 
     /// Returns the X and Y factors to convert from pixels to the
     /// custom units. In other words, multiplying the values returned
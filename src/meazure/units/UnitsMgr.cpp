@@ -287,6 +287,13 @@ MeaFSize MeaUnitsMgr::GetMinorIncr(const RECT& rect) const {
     //
     MeaFSize sepUnits = m_currentLinearUnits->FromPixels(res) * sepPixels;
 
+    // The increment only depends on the separation, which rarely changes between
+    // ruler paints, so reuse the previous result when possible.
+    //
+    if (sepUnits.cx == m_minorIncrSep.cx && sepUnits.cy == m_minorIncrSep.cy) {
+        return m_minorIncr;
+    }
+
     // The object is to find a standard minor increment (e.g. 10, 25)
     // that is the closest to the minimum increment but larger than
     // or equal to it. To achieve this, use the log of the separation
@@ -312,6 +319,9 @@ MeaFSize MeaUnitsMgr::GetMinorIncr(const RECT& rect) const {
     }
     increment.cy = kTickIncrements[idx] * pow(10.0, -delta.cy);
 
+    m_minorIncrSep = sepUnits;
+    m_minorIncr = increment;
+
     return increment;
 }
 
@@ -390,6 +390,28 @@ public:
         return m_currentAngularUnits->Format(id, value);
     }
 
+    /// Formats the specified linear measurement value for display
+    /// without allocating memory.
+    /// @param id       [in] Identifies the linear measurement for
+    ///                 use in determining the display precision.
+    /// @param value    [in] Linear measurement value to format,
+    ///                 in current units.
+    /// @return Formatted measurement data.
+    MeaNumberString FormatNumber(MeaLinearMeasurementId id, double value) const {
+        return m_currentLinearUnits->FormatNumber(id, value);
+    }
+
+    /// Formats the specified angular measurement value for display
+    /// without allocating memory.
+    /// @param id       [in] Identifies the angular measurement for
+    ///                 use in determining the display precision.
+    /// @param value    [in] Angular measurement value to format,
+    ///                 in current units.
+    /// @return Formatted measurement data.
+    MeaNumberString FormatNumber(MeaAngularMeasurementId id, double value) const {
+        return m_currentAngularUnits->FormatNumber(id, value);
+    }
+
     /// Converts the specified coordinate from pixels to the desired units.
     /// This conversion takes into account the location of the origin and the
     /// orientation of the y-axis.
@@ -444,6 +466,58 @@ public:
         return m_currentLinearUnits->UnconvertPos(pos);
     }
 
+    /// Converts the specified coordinates from pixels to the desired units.
+    /// This conversion takes into account the location of the origin and the
+    /// orientation of the y-axis.
+    ///
+    /// @param coords       [in] Coordinates in pixels to convert to the desired units.
+    /// @param converted    [out] Receives the converted coordinates. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of coordinates to convert.
+    ///
+    void ConvertCoords(const POINT* coords, MeaFPoint* converted, size_t count) const override {
+        m_currentLinearUnits->ConvertCoords(coords, converted, count);
+    }
+
+    /// Converts the specified coordinates from the current units to pixels. The
+    /// conversion takes into account the location of the origin and the orientation
+    /// of the y-axis.
+    ///
+    /// @param coords       [in] Coordinates to convert to pixels.
+    /// @param converted    [out] Receives the coordinates in pixels. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of coordinates to convert.
+    ///
+    void UnconvertCoords(const MeaFPoint* coords, POINT* converted, size_t count) const {
+        m_currentLinearUnits->UnconvertCoords(coords, converted, count);
+    }
+
+    /// Converts the specified positions from pixels to the desired units.
+    /// This conversion does not take into account the location of the origin
+    /// nor does it compensate for the orientation of the y-axis.
+    ///
+    /// @param positions    [in] Positions in pixels to convert to the desired units.
+    /// @param converted    [out] Receives the converted positions. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of positions to convert.
+    ///
+    void ConvertPositions(const POINT* positions, MeaFPoint* converted, size_t count) const override {
+        m_currentLinearUnits->ConvertPositions(positions, converted, count);
+    }
+
+    /// Converts the specified positions from the current units to pixels. The
+    /// conversion does not take into account the location of the origin nor the
+    /// orientation of the y-axis.
+    ///
+    /// @param positions    [in] Positions to convert to pixels.
+    /// @param converted    [out] Receives the positions in pixels. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of positions to convert.
+    ///
+    void UnconvertPositions(const MeaFPoint* positions, POINT* converted, size_t count) const override {
+        m_currentLinearUnits->UnconvertPositions(positions, converted, count);
+    }
+
     /// Converts the specified resolution in pixels/inch to the desired units.
     ///
     /// @param res      [in] Resolution in pixels/inch to convert to the desired units.
@@ -536,4 +610,6 @@ private:
     bool m_haveWarned;                          ///< Indicates whether the user has already been warned about using
                                                 ///< the operating system reported resolution.
     int m_majorTickCount;                       ///< Number of minor ruler tick marks between major tick marks.
+    mutable MeaFSize m_minorIncrSep;            ///< Minimum tick separation for which m_minorIncr was computed.
+    mutable MeaFSize m_minorIncr;               ///< Most recently computed minor tick increment.
 };
@@ -151,6 +151,37 @@ struct MeaUnitsProvider {
     ///
     virtual POINT UnconvertPos(const MeaFPoint& pos) const = 0;
 
+    /// Converts the specified coordinates from pixels to the desired units. This is
+    /// equivalent to calling ConvertCoord for each coordinate but avoids per
+    /// coordinate dispatch and screen lookups.
+    ///
+    /// @param coords       [in] Coordinates in pixels to convert to the desired units.
+    /// @param converted    [out] Receives the converted coordinates. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of coordinates to convert.
+    ///
+    virtual void ConvertCoords(const POINT* coords, MeaFPoint* converted, size_t count) const = 0;
+
+    /// Converts the specified positions from pixels to the desired units. This is
+    /// equivalent to calling ConvertPos for each position.
+    ///
+    /// @param positions    [in] Positions in pixels to convert to the desired units.
+    /// @param converted    [out] Receives the converted positions. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of positions to convert.
+    ///
+    virtual void ConvertPositions(const POINT* positions, MeaFPoint* converted, size_t count) const = 0;
+
+    /// Converts the specified positions from the current units to pixels. This is
+    /// equivalent to calling UnconvertPos for each position.
+    ///
+    /// @param positions    [in] Positions to convert to pixels.
+    /// @param converted    [out] Receives the positions in pixels. Must have room for
+    ///                     count elements.
+    /// @param count        [in] Number of positions to convert.
+    ///
+    virtual void UnconvertPositions(const MeaFPoint* positions, POINT* converted, size_t count) const = 0;
+
     /// Converts the specified resolution in pixels/inch to the desired units.
     ///
     /// @param res      [in] Resolution in pixels/inch to convert to the desired units.
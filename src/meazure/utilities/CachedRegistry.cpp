@@ -0,0 +1,178 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "CachedRegistry.h"
+#include <cassert>
+
+
+MeaCachedRegistry::MeaCachedRegistry(MeaRegistryProvider& registry) : m_registry(registry) {}
+
+MeaCachedRegistry::~MeaCachedRegistry() {
+    try {
+        Flush();
+    } catch (...) {
+        assert(false);
+    }
+}
+
+BOOL MeaCachedRegistry::WriteInt(PCTSTR section, PCTSTR entry, int value) {
+    Write(section, MeaRegistryValue(entry, value));
+    return TRUE;
+}
+
+BOOL MeaCachedRegistry::WriteString(PCTSTR section, PCTSTR entry, PCTSTR value) {
+    if (entry != nullptr && value != nullptr) {
+        Write(section, MeaRegistryValue(entry, value));
+        return TRUE;
+    }
+
+    // Deletion of an entry or the entire section.
+    BOOL result = TRUE;
+    auto iter = m_sections.find(MakeKey(section));
+    if (iter != m_sections.end()) {
+        result = FlushSection(iter->second);
+        if (entry == nullptr) {
+            m_sections.erase(iter);
+        } else {
+            iter->second.values.erase(MakeKey(entry));
+        }
+    }
+
+    return (m_registry.WriteString(section, entry, value) && result) ? TRUE : FALSE;
+}
+
+UINT MeaCachedRegistry::GetInt(PCTSTR section, PCTSTR entry, int defaultValue) {
+    const Section& cached = GetSection(section);
+    auto iter = cached.values.find(MakeKey(entry));
+    if (iter == cached.values.end() || iter->second.value.isString) {
+        return static_cast<UINT>(defaultValue);
+    }
+    return static_cast<UINT>(iter->second.value.intValue);
+}
+
+CString MeaCachedRegistry::GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue) {
+    const Section& cached = GetSection(section);
+    auto iter = cached.values.find(MakeKey(entry));
+    if (iter == cached.values.end() || !iter->second.value.isString) {
+        return CString(defaultValue);
+    }
+    return iter->second.value.strValue;
+}
+
+BOOL MeaCachedRegistry::GetValues(PCTSTR section, MeaRegistryValues& values) {
+    const Section& cached = GetSection(section);
+    for (const auto& entry : cached.values) {
+        values.push_back(entry.second.value);
+    }
+    return TRUE;
+}
+
+BOOL MeaCachedRegistry::WriteValues(PCTSTR section, const MeaRegistryValues& values) {
+    for (const MeaRegistryValue& value : values) {
+        Write(section, value);
+    }
+    return TRUE;
+}
+
+PCTSTR MeaCachedRegistry::GetKeyName() {
+    return m_registry.GetKeyName();
+}
+
+LSTATUS MeaCachedRegistry::OpenKey(HKEY key, PCTSTR subKey, DWORD options, REGSAM samDesired, PHKEY result) {
+    return m_registry.OpenKey(key, subKey, options, samDesired, result);
+}
+
+LSTATUS MeaCachedRegistry::CloseKey(HKEY key) {
+    return m_registry.CloseKey(key);
+}
+
+BOOL MeaCachedRegistry::Flush() {
+    BOOL result = TRUE;
+    for (auto& section : m_sections) {
+        if (!FlushSection(section.second)) {
+            result = FALSE;
+        }
+    }
+    return result;
+}
+
+MeaCachedRegistry::Section& MeaCachedRegistry::GetSection(PCTSTR section) {
+    auto inserted = m_sections.try_emplace(MakeKey(section));
+    Section& cached = inserted.first->second;
+
+    if (inserted.second) {
+        // A section that does not exist yet is cached as empty.
+        cached.name = section;
+
+        MeaRegistryValues values;
+        m_registry.GetValues(section, values);
+        for (MeaRegistryValue& value : values) {
+            CString key = MakeKey(value.entry);
+            cached.values.try_emplace(key, CachedValue { std::move(value), false });
+        }
+    }
+
+    return cached;
+}
+
+void MeaCachedRegistry::Write(PCTSTR section, const MeaRegistryValue& value) {
+    Section& cached = GetSection(section);
+    auto inserted = cached.values.try_emplace(MakeKey(value.entry), CachedValue { value, true });
+
+    if (!inserted.second) {
+        CachedValue& existing = inserted.first->second;
+        bool changed = (existing.value.isString != value.isString) ||
+            (value.isString ? (existing.value.strValue != value.strValue) : (existing.value.intValue != value.intValue));
+        if (!changed) {
+            return;
+        }
+
+        // Keep the entry name as first seen.
+        existing.value.isString = value.isString;
+        existing.value.intValue = value.intValue;
+        existing.value.strValue = value.strValue;
+        existing.dirty = true;
+    }
+
+    cached.dirty = true;
+}
+
+BOOL MeaCachedRegistry::FlushSection(Section& section) {
+    if (!section.dirty) {
+        return TRUE;
+    }
+
+    MeaRegistryValues values;
+    for (auto& entry : section.values) {
+        if (entry.second.dirty) {
+            values.push_back(entry.second.value);
+            entry.second.dirty = false;
+        }
+    }
+    section.dirty = false;
+
+    return m_registry.WriteValues(section.name, values);
+}
+
+CString MeaCachedRegistry::MakeKey(PCTSTR name) {
+    CString key(name);
+    key.MakeLower();
+    return key;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// @file
+/// @brief Write-behind cache of the Windows Registry.
+
+#pragma once
+
+#include "RegistryProvider.h"
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+
+
+/// Caches the values of the application's registry in memory in front of
+/// another registry provider. Each MFC profile read and write opens and
+/// closes the registry key, which adds up when the application state is
+/// loaded and saved one value at a time. Instead, the first access to a
+/// section reads all of its values with a single enumeration, reads are
+/// then served from memory, and writes are held in memory until Flush is
+/// called or the cache is destroyed. Only values that were changed are
+/// written, and the values of each section are written together.
+///
+/// Entry and section names are not case sensitive, as in the registry.
+/// As with MFC, reading an integer entry as a string, or a string entry as
+/// an integer, returns the default value.
+///
+class MeaCachedRegistry : public MeaRegistryProvider {
+
+public:
+    /// Constructs a cache in front of the specified registry provider.
+    /// No registry access is performed until a value is requested.
+    ///
+    /// @param registry     [in] Provider used to read and write the registry. Must remain valid for the life of
+    ///                     the cache.
+    ///
+    explicit MeaCachedRegistry(MeaRegistryProvider& registry);
+
+    /// Writes any changed values to the registry and destroys the cache.
+    ///
+    virtual ~MeaCachedRegistry();
+
+    MeaCachedRegistry(const MeaCachedRegistry&) = delete;
+    MeaCachedRegistry& operator=(const MeaCachedRegistry&) = delete;
+
+    BOOL WriteInt(PCTSTR section, PCTSTR entry, int value) override;
+
+    /// See MeaRegistryProvider::WriteString. Deleting an entry or section
+    /// (i.e. a nullptr entry or value) writes any changed values in the
+    /// section and then passes the deletion through to the registry.
+    ///
+    BOOL WriteString(PCTSTR section, PCTSTR entry, PCTSTR value) override;
+
+    UINT GetInt(PCTSTR section, PCTSTR entry, int defaultValue) override;
+
+    CString GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue) override;
+
+    BOOL GetValues(PCTSTR section, MeaRegistryValues& values) override;
+
+    BOOL WriteValues(PCTSTR section, const MeaRegistryValues& values) override;
+
+    PCTSTR GetKeyName() override;
+
+    LSTATUS OpenKey(HKEY key, PCTSTR subKey, DWORD options, REGSAM samDesired, PHKEY result) override;
+
+    LSTATUS CloseKey(HKEY key) override;
+
+    /// Writes the values that have changed since they were read or last
+    /// flushed. The changed values of each section are written with one
+    /// call to MeaRegistryProvider::WriteValues.
+    ///
+    /// @return TRUE if all changed values were written; otherwise FALSE.
+    ///
+    BOOL Flush();
+
+private:
+    /// Hashes names without regard to case. The names are stored in lower
+    /// case, so the standard string hash is used.
+    ///
+    struct NameHash {
+        std::size_t operator()(const CString& name) const {
+            return std::hash<std::basic_string_view<TCHAR>>()(std::basic_string_view<TCHAR>(name, name.GetLength()));
+        }
+    };
+
+    /// A cached registry value.
+    ///
+    struct CachedValue {
+        MeaRegistryValue value;     ///< Value, with the entry name as originally given.
+        bool dirty;                 ///< Indicates that the value has changed and has not been written.
+    };
+
+    /// The cached values of a registry section, keyed by lower case entry name.
+    ///
+    struct Section {
+        CString name;                                                   ///< Section name as originally given.
+        std::unordered_map<CString, CachedValue, NameHash> values;      ///< Values of the section.
+        bool dirty = false;                                             ///< Indicates that a value has changed.
+    };
+
+    /// Obtains the cached section with the specified name, reading its
+    /// values from the registry on first access.
+    ///
+    /// @param section      [in] Name of the section.
+    /// @return Cached section.
+    ///
+    Section& GetSection(PCTSTR section);
+
+    /// Caches a value written to the registry, if it differs from the value
+    /// already cached.
+    ///
+    /// @param section      [in] Name of the section.
+    /// @param value        [in] Value being written.
+    ///
+    void Write(PCTSTR section, const MeaRegistryValue& value);
+
+    /// Writes the changed values of a section.
+    ///
+    /// @param section      [in] Section to write.
+    /// @return TRUE if all changed values were written; otherwise FALSE.
+    ///
+    BOOL FlushSection(Section& section);
+
+    /// Converts a name to the key used to find it in the cache.
+    ///
+    /// @param name     [in] Section or entry name.
+    /// @return Lower case copy of the name.
+    ///
+    static CString MakeKey(PCTSTR name);
+
+
+    MeaRegistryProvider& m_registry;                            ///< Cached registry.
+    std::unordered_map<CString, Section, NameHash> m_sections;  ///< Sections, by lower case name.
+};
@@ -595,14 +595,18 @@ namespace MeaGeometry {
     /// </tr>
     /// </table>
     ///
+    /// The sector is determined using only sign and magnitude comparisons of the vector components rather than
+    /// by calculating the angle of the vector. Vectors lying exactly on a diagonal are placed in the same sectors
+    /// as indicated in the table above.
+    ///
     /// @param start        [in] Starting point for the vector.
     /// @param end          [in] Ending point for the vector.
     ///
     /// @return The circular sector corresponding to the vector in the range [-4.0, 4.0].
     ///
-    inline int CalcSector(const POINT& start, const POINT& end) {
-        int deltax = end.x - start.x;
-        int deltay = end.y - start.y;
+    constexpr int CalcSector(const POINT& start, const POINT& end) {
+        const long long deltax = static_cast<long long>(end.x) - start.x;
+        const long long deltay = static_cast<long long>(end.y) - start.y;
 
         if (deltax == 0 && deltay == 0) {
             return 0;
@@ -614,9 +618,13 @@ namespace MeaGeometry {
             return (deltax < 0) ? -4 : 1;
         }
 
-        // Note: 45 degrees == PI/4 radians
-        double result = atan2(static_cast<double>(deltay), static_cast<double>(deltax)) / MeaNumericUtils::PI4;
-        return static_cast<int>(result + std::copysign(1.0, result));
+        const long long absx = (deltax < 0) ? -deltax : deltax;
+        const long long absy = (deltay < 0) ? -deltay : deltay;
+
+        if (deltay > 0) {
+            return (deltax > 0) ? 1 + (absy >= absx) : 4 - (absy > absx);
+        }
+        return (deltax < 0) ? -4 + (absy > absx) : -1 - (absy >= absx);
     }
 
     /// Indicates whether the specified vector is oriented in a vertical direction. A vector is considered
@@ -627,7 +635,7 @@ namespace MeaGeometry {
     /// @return <b>true</b> if the specified vector is vertically oriented. Returns <b>false</b> if the
     ///     vector is horizontally oriented or is the empty vector.
     /// 
-    inline bool IsVerticallyOriented(const POINT& start, const POINT& end) {
+    constexpr bool IsVerticallyOriented(const POINT& start, const POINT& end) {
         switch (CalcSector(start, end)) {
         case 2:
         case -2:
@@ -647,7 +655,7 @@ namespace MeaGeometry {
     /// @return <b>true</b> if the specified vector is horizontally oriented. Returns <b>false</b> if the
     ///     vector is vertically oriented or is the empty vector.
     /// 
-    inline bool IsHorizontallyOriented(const POINT& start, const POINT& end) {
+    constexpr bool IsHorizontallyOriented(const POINT& start, const POINT& end) {
         switch (CalcSector(start, end)) {
         case 1:
         case -1:
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <meazure/pch.h>
+#include "NumberFormat.h"
+#include <cmath>
+#include <cstdint>
+#include <cfloat>
+
+
+namespace {
+    /// Powers of ten used to scale a value to an integer number of its least significant decimal place.
+    ///
+    constexpr double kPow10[MeaNumberFormat::kMaxPrecision + 1] = {
+        1.0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9
+    };
+
+    /// Scaled values below this limit are integers that are exactly representable by a double.
+    ///
+    constexpr double kMaxExact = 9007199254740992.0;       // 2^53
+}
+
+
+MeaNumberString MeaNumberFormat::FormatFixed(double value, int precision) {
+    MeaNumberString str;
+
+    double magnitude = std::fabs(value);
+    double scaled = (precision >= 0 && precision <= kMaxPrecision) ? magnitude * kPow10[precision] : 0.0;
+
+    if (precision < 0 || precision > kMaxPrecision || !(scaled < kMaxExact)) {
+        str.m_overflow.Format(_T("%0.*f"), precision, value);
+        return str;
+    }
+
+    // Split the scaled value into its integer and fractional parts. Both are
+    // exact because the scaled value is below 2^53. The product itself may
+    // have been rounded, so when the fraction is close enough to one half
+    // for that to matter, the rounding error is recovered exactly using a
+    // fused multiply-add and folded into the comparison.
+    //
+    double whole = std::floor(scaled);
+    double diff = (scaled - whole) - 0.5;
+    if (std::fabs(diff) <= scaled * DBL_EPSILON) {
+        diff += std::fma(magnitude, kPow10[precision], -scaled);
+    }
+
+    uint64_t digits = static_cast<uint64_t>(whole);
+    if (diff > 0.0 || (diff == 0.0 && (digits & 1) != 0)) {
+        digits++;
+    }
+
+    // Write the digits backwards from the end of a scratch buffer, inserting
+    // the decimal point after the fractional digits.
+    //
+    TCHAR scratch[MeaNumberString::kCapacity];
+    TCHAR* p = scratch + MeaNumberString::kCapacity;
+    int count = 0;
+
+    do {
+        *--p = static_cast<TCHAR>(_T('0') + digits % 10);
+        digits /= 10;
+        if (++count == precision) {
+            *--p = _T('.');
+        }
+    } while (digits != 0 || count <= precision);
+
+    if (std::signbit(value)) {
+        *--p = _T('-');
+    }
+
+    str.m_length = static_cast<int>(scratch + MeaNumberString::kCapacity - p);
+    for (int i = 0; i < str.m_length; i++) {
+        str.m_buffer[i] = p[i];
+    }
+    str.m_buffer[str.m_length] = _T('\0');
+
+    return str;
+}
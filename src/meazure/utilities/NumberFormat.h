@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for formatting numbers without heap allocation.
+
+#pragma once
+
+
+/// Small string holding a formatted number. The characters are stored in
+/// a fixed size buffer within the object so that formatting a number and
+/// passing it around does not allocate memory. Numbers too long for the
+/// buffer are held in a CString.
+///
+class MeaNumberString {
+
+public:
+    static constexpr int kCapacity = 32;        ///< Size of the character buffer, including the terminator.
+
+    MeaNumberString() : m_length(0) { m_buffer[0] = _T('\0'); }
+
+    /// Returns the formatted number.
+    ///
+    /// @return Null terminated string.
+    ///
+    PCTSTR GetString() const { return m_overflow.IsEmpty() ? m_buffer : static_cast<PCTSTR>(m_overflow); }
+
+    operator PCTSTR() const { return GetString(); }
+
+    /// Returns the number of characters in the formatted number.
+    ///
+    /// @return Length of the string, not including the terminator.
+    ///
+    int GetLength() const { return m_overflow.IsEmpty() ? m_length : m_overflow.GetLength(); }
+
+private:
+    friend class MeaNumberFormat;
+
+    TCHAR m_buffer[kCapacity];      ///< Formatted number, if it fits.
+    int m_length;                   ///< Number of characters in m_buffer.
+    CString m_overflow;             ///< Formatted number if it does not fit in m_buffer.
+};
+
+
+/// Formats floating point numbers for display. The formatting produces the
+/// same results as the C library printf function with the equivalent format
+/// specification but uses integer arithmetic and writes into a
+/// MeaNumberString rather than a heap allocated string.
+///
+class MeaNumberFormat {
+
+public:
+    static constexpr int kMaxPrecision = 9;     ///< Largest number of decimal places formatted by the fast path.
+
+    MeaNumberFormat() = delete;
+
+    /// Formats the specified value with a fixed number of decimal places.
+    /// Equivalent to printf("%0.*f", precision, value), including
+    /// rounding ties to even and the sign of negative values that round to
+    /// zero. Values that cannot be scaled to an exact integer (e.g. very
+    /// large values, infinities, NaN) or precisions outside the range
+    /// [0, kMaxPrecision] are formatted using the C library.
+    ///
+    /// @param value        [in] Value to format.
+    /// @param precision    [in] Number of decimal places.
+    ///
+    /// @return Formatted value.
+    ///
+    static MeaNumberString FormatFixed(double value, int precision);
+};
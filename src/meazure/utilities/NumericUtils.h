@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cmath>
+#include <limits>
 
 
 /// Constants and convenience methods for working with numbers.
@@ -81,4 +82,50 @@ namespace MeaNumericUtils {
     constexpr double RadToDeg(double rad) {
         return rad * 180.0 / PI;
     }
+
+    /// Raises the specified value to a non-negative integer power. Unlike std::pow, the calculation can be performed
+    /// at compile time.
+    ///
+    /// @param value    [in] Value to raise to the power
+    /// @param exponent [in] Power to raise the value to. Must not be negative.
+    /// @return value<sup>exponent</sup>
+    ///
+    constexpr double IntPow(double value, int exponent) {
+        double result = 1.0;
+        for (int i = 0; i < exponent; i++) {
+            result *= value;
+        }
+        return result;
+    }
+
+    /// Calculates the nth root of the specified value. Unlike std::pow and std::cbrt, the calculation can be
+    /// performed at compile time. The root is found using Newton's method starting from a value above the root, so
+    /// that the estimates decrease monotonically until they converge to within the precision of a double.
+    ///
+    /// @param value    [in] Value whose root is to be calculated. Values less than or equal to zero produce zero.
+    ///                 NaN and infinity are returned unchanged.
+    /// @param n        [in] Degree of the root (e.g. 3 for the cube root). Must be greater than zero.
+    /// @return The nth root of the value.
+    ///
+    constexpr double NthRoot(double value, int n) {
+        if (value <= 0.0) {
+            return 0.0;
+        }
+        if (!(value <= std::numeric_limits<double>::max())) {
+            return value;
+        }
+
+        // The step is arranged so that raising a large estimate to a power
+        // overflows to infinity, shrinking the estimate, rather than
+        // producing NaN.
+        //
+        double root = (value > 1.0) ? value : 1.0;
+        for (;;) {
+            double next = ((n - 1) * root + value / IntPow(root, n - 1)) / n;
+            if (next >= root) {
+                return root;
+            }
+            root = next;
+        }
+    }
 };
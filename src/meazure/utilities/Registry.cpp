@@ -19,6 +19,7 @@
 
 #include <meazure/pch.h>
 #include "Registry.h"
+#include <algorithm>
 
 
 BOOL MeaRegistry::WriteInt(PCTSTR section, PCTSTR entry, int value) {
@@ -37,6 +38,79 @@ CString MeaRegistry::GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue
     return AfxGetApp()->GetProfileString(section, entry, defaultValue);
 }
 
+BOOL MeaRegistry::GetValues(PCTSTR section, MeaRegistryValues& values) {
+    // Open the section without creating it, so that enumerating a missing section does not add it.
+    CString subKey;
+    subKey.Format(_T("Software\\%s\\%s\\%s"), GetKeyName(), AfxGetApp()->m_pszProfileName, section);
+
+    HKEY key;
+    if (OpenKey(HKEY_CURRENT_USER, subKey, 0, KEY_READ, &key) != ERROR_SUCCESS) {
+        return FALSE;
+    }
+
+    DWORD maxNameLength = 0;
+    DWORD maxDataSize = 0;
+    if (::RegQueryInfoKey(key, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &maxNameLength,
+                          &maxDataSize, nullptr, nullptr) != ERROR_SUCCESS) {
+        CloseKey(key);
+        return FALSE;
+    }
+
+    std::vector<TCHAR> name(maxNameLength + 1);
+    std::vector<BYTE> data(maxDataSize + sizeof(TCHAR));
+
+    for (DWORD index = 0; ; index++) {
+        DWORD nameLength = static_cast<DWORD>(name.size());
+        DWORD dataSize = static_cast<DWORD>(data.size()) - sizeof(TCHAR);
+        DWORD type;
+        LSTATUS status = ::RegEnumValue(key, index, name.data(), &nameLength, nullptr, &type, data.data(), &dataSize);
+        if (status == ERROR_NO_MORE_ITEMS) {
+            break;
+        }
+        if (status != ERROR_SUCCESS) {
+            continue;
+        }
+
+        if (type == REG_DWORD && dataSize == sizeof(DWORD)) {
+            values.emplace_back(name.data(), *reinterpret_cast<const int*>(data.data()));
+        } else if (type == REG_SZ) {
+            // Registry strings are not guaranteed to be terminated.
+            std::fill(data.begin() + dataSize, data.end(), static_cast<BYTE>(0));
+            values.emplace_back(name.data(), reinterpret_cast<PCTSTR>(data.data()));
+        }
+    }
+
+    CloseKey(key);
+    return TRUE;
+}
+
+BOOL MeaRegistry::WriteValues(PCTSTR section, const MeaRegistryValues& values) {
+    HKEY key = AfxGetApp()->GetSectionKey(section);
+    if (key == nullptr) {
+        return FALSE;
+    }
+
+    BOOL result = TRUE;
+    for (const MeaRegistryValue& value : values) {
+        LSTATUS status;
+        if (value.isString) {
+            PCTSTR str = value.strValue;
+            DWORD size = static_cast<DWORD>((value.strValue.GetLength() + 1) * sizeof(TCHAR));
+            status = ::RegSetValueEx(key, value.entry, 0, REG_SZ, reinterpret_cast<const BYTE*>(str), size);
+        } else {
+            DWORD data = static_cast<DWORD>(value.intValue);
+            status = ::RegSetValueEx(key, value.entry, 0, REG_DWORD, reinterpret_cast<const BYTE*>(&data),
+                                     sizeof(data));
+        }
+        if (status != ERROR_SUCCESS) {
+            result = FALSE;
+        }
+    }
+
+    CloseKey(key);
+    return result;
+}
+
 PCTSTR MeaRegistry::GetKeyName() {
     return AfxGetApp()->m_pszRegistryKey;
 }
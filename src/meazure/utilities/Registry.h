@@ -36,6 +36,10 @@ public:
 
     CString GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue) override;
 
+    BOOL GetValues(PCTSTR section, MeaRegistryValues& values) override;
+
+    BOOL WriteValues(PCTSTR section, const MeaRegistryValues& values) override;
+
     PCTSTR GetKeyName() override;
 
     LSTATUS OpenKey(HKEY key, PCTSTR subKey, DWORD options, REGSAM samDesired, PHKEY result) override;
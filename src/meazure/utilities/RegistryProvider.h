@@ -22,6 +22,26 @@
 
 #pragma once
 
+#include <vector>
+
+
+/// A named integer or string value in a section of the application's registry.
+///
+struct MeaRegistryValue {
+    CString entry;          ///< Name of the value within its section.
+    bool isString;          ///< true for a string value (REG_SZ), false for an integer value (REG_DWORD).
+    int intValue;           ///< Value of an integer entry.
+    CString strValue;       ///< Value of a string entry.
+
+    MeaRegistryValue() : isString(false), intValue(0) {}
+    MeaRegistryValue(PCTSTR name, int value) : entry(name), isString(false), intValue(value) {}
+    MeaRegistryValue(PCTSTR name, PCTSTR value) : entry(name), isString(true), intValue(0), strValue(value) {}
+};
+
+/// Values of a section of the application's registry.
+///
+typedef std::vector<MeaRegistryValue> MeaRegistryValues;
+
 
 /// Interface for Windows Registry interaction.
 ///
@@ -74,6 +94,25 @@ struct MeaRegistryProvider {
     /// 
     virtual CString GetString(PCTSTR section, PCTSTR entry, PCTSTR defaultValue) = 0;
 
+    /// Retrieves all integer and string values in the specified section of the application's registry using a
+    /// single enumeration of the section. Values of other types are skipped.
+    ///
+    /// @param section  [in] Points to a null-terminated string that specifies the section to enumerate.
+    /// @param values   [out] Values in the section, which are appended to the vector.
+    /// @return TRUE if successful; FALSE if the section does not exist or cannot be read.
+    ///
+    virtual BOOL GetValues(PCTSTR section, MeaRegistryValues& values) = 0;
+
+    /// Writes the specified values into the specified section of the application's registry, opening the section
+    /// only once for all of the values.
+    ///
+    /// @param section  [in] Points to a null-terminated string that specifies the section containing the entries.
+    ///     If the section does not exist, it is created.
+    /// @param values   [in] Values to write. Entries that do not exist in the section are created.
+    /// @return TRUE if all values were written; otherwise FALSE.
+    ///
+    virtual BOOL WriteValues(PCTSTR section, const MeaRegistryValues& values) = 0;
+
     /// Determines where, in the registry or INI file, application profile settings are stored
     ///
     /// @return Application registry key.
@@ -22,26 +22,17 @@
 
 
 MeaTimer::MeaTimer() :
-    m_timerThread(nullptr),
-    m_stopEvent(FALSE, TRUE),
-    m_exitEvent(FALSE, TRUE),
-    m_elapse(0),
+    m_timer([this] { Expire(); }),
     m_parent(nullptr),
-    m_userData(0) {
-    // The m_exitEvent indicates whether we are in the timer procedure. Since
-    // we are just starting, we are not in the timer thread.
-    //
-    m_exitEvent.SetEvent();
-}
+    m_userData(0) {}
 
 MeaTimer::~MeaTimer() {
     try {
-        // Don't leave the timer thread running or we will pull the object
-        // instance out from under it.
+        // Don't leave the timer pending or the service will call into
+        // the object after it has been destroyed.
         //
         Stop();
 
-        m_timerThread = nullptr;
         m_parent = nullptr;
     } catch (...) {
         assert(false);
@@ -53,62 +44,24 @@ void MeaTimer::Start(int elapse) {
     //
     assert(m_parent != nullptr);
 
-    // Only one thread at a time can set or read the timer thread ID.
-    //
-    m_critSect.Lock();
-
-    m_elapse = elapse;
-
-    // Only one timer thread is allowed to run at one time. In other
-    // words, multiple calls to Start will not cause multiple timer
-    // threads to pile up.
-    //
-    if (m_timerThread == nullptr) {
-        m_timerThread = AfxBeginThread(MeaTimer::TimerProc, this);
-    }
-
-    m_critSect.Unlock();
+    GetService().Start(m_timer, elapse);
 }
 
 void MeaTimer::Stop() {
-    // Stop the timer thread.
+    // Once stopped, the timer message is guaranteed not to be posted.
     //
-    m_stopEvent.PulseEvent();
-
-    // Wait for the signal that the timer thread is done.
-    //
-    ::WaitForSingleObject(m_exitEvent, INFINITE);
+    GetService().Stop(m_timer);
 }
 
-UINT MeaTimer::TimerProc() {
-    // Indicate that the timer thread has begun.
-    //
-    m_exitEvent.ResetEvent();
-
-    //
-    // Wait for the requested amount of time interruptible by stop event.
-    //
-    DWORD ret = ::WaitForSingleObject(m_stopEvent, m_elapse);
-
-    // Allow another timer thread to start. This must happen
-    // before posting the timer message in case the timer message
-    // handler calls the timer Start method.
-    //
-    m_critSect.Lock();
-    m_timerThread = nullptr;
-    m_critSect.Unlock();
-
-    // Tell the parent that the timer has expired if the wait
-    // exited due to the elapsed time expiring rather than the
-    // stop event being issued.
-    //
-    if (ret == WAIT_TIMEOUT) {        // Normal path
-        m_parent->PostMessage(MeaHPTimerMsg, m_userData);
-    }
+void MeaTimer::Shutdown() {
+    GetService().Shutdown();
+}
 
-    // Indicate that the timer thread is done.
-    //
-    m_exitEvent.SetEvent();
+void MeaTimer::Expire() {
+    m_parent->PostMessage(MeaHPTimerMsg, m_userData);
+}
 
-    return 0;
+MeaTimerService& MeaTimer::GetService() {
+    static MeaTimerService* service = new MeaTimerService();
+    return *service;
 }
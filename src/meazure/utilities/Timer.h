@@ -23,13 +23,15 @@
 #pragma once
 
 
-#include <afxmt.h>
+#include "TimerService.h"
 #include <meazure/Messages.h>
 #include <cassert>
 
 
 /// Implements a timer that issues timing messages at a higher priority
-/// than the standard windows timer that issues WM_TIMER messages.
+/// than the standard windows timer that issues WM_TIMER messages. All
+/// timers are scheduled by a single process-wide MeaTimerService so that
+/// starting a timer does not create a thread.
 ///
 class MeaTimer {
 
@@ -57,6 +59,8 @@ public:
     }
 
     /// Sets the timer to the specified interval and starts it running.
+    /// If the timer is already running, the call has no effect so that
+    /// multiple calls to Start do not pile up timer messages.
     ///
     /// @param elapse   [in] Time interval in milliseconds.
     ///
@@ -66,31 +70,29 @@ public:
     ///
     void Stop();
 
-private:
-    /// Called when the timer expires. Simply calls the instance
-    /// method of the same name.
-    ///
-    /// @param pParam   [i] Timer instance pointer.
+    /// Stops the timer service shared by all timers. Called when the
+    /// application exits so that no timer messages are posted to windows
+    /// that have been destroyed. Once shut down, timers can no longer be
+    /// started but may still be stopped and destroyed.
     ///
-    /// @return Zero indicating success.
+    static void Shutdown();
+
+private:
+    /// Called on the timer service thread when the timer expires. Posts
+    /// the MeaHPTimerMsg message to the parent window.
     ///
-    static UINT TimerProc(LPVOID pParam) {
-        return static_cast<MeaTimer*>(pParam)->TimerProc();
-    }
+    void Expire();
 
-    /// Called when the timer expires. Sends the MeaHPTimerMsg message
-    /// to the parent window.
+    /// Returns the timer service shared by all timers in the process.
+    /// The service is never destroyed so that it outlives any timer,
+    /// including those owned by static objects.
     ///
-    /// @return Zero indicating success.
+    /// @return Timer service.
     ///
-    UINT TimerProc();
+    static MeaTimerService& GetService();
 
 
-    CWinThread* m_timerThread;      ///< Thread in which the timer runs.
-    CCriticalSection m_critSect;    ///< Critical section guard.
-    CEvent m_stopEvent;             ///< Used internally to indicate the timer has been stopped.
-    CEvent m_exitEvent;             ///< Used internally to indicate the timer has completed all processing.
-    int m_elapse;                   ///< Timer period, in milliseconds.
+    MeaTimerService::Timer m_timer; ///< Timer scheduled with the timer service.
     CWnd* m_parent;                 ///< Window to receive the timer expire message.
     WPARAM m_userData;              ///< Caller defined data.
 };
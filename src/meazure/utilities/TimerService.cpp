@@ -0,0 +1,255 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <meazure/pch.h>
+#include "TimerService.h"
+#include <algorithm>
+#include <cassert>
+
+
+MeaTimerService::Timer::Timer(const Callback& callback) :
+    m_callback(callback),
+    m_prev(nullptr),
+    m_next(nullptr),
+    m_slot(nullptr) {}
+
+
+MeaTimerService::MeaTimerService() :
+    m_shutdown(false),
+    m_epoch(Clock::now()),
+    m_currentTick(0),
+    m_pendingCount(0),
+    m_expired(nullptr),
+    m_running(nullptr) {
+    std::fill(std::begin(m_slots), std::end(m_slots), nullptr);
+}
+
+MeaTimerService::~MeaTimerService() {
+    try {
+        Shutdown();
+    } catch (...) {
+        assert(false);
+    }
+}
+
+bool MeaTimerService::Start(Timer& timer, int elapse) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (timer.m_slot != nullptr || m_shutdown) {
+        return false;
+    }
+
+    Schedule(timer, elapse, lock);
+    return true;
+}
+
+void MeaTimerService::Restart(Timer& timer, int elapse) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_shutdown) {
+        return;
+    }
+
+    if (timer.m_slot != nullptr) {
+        Unlink(timer);
+        m_pendingCount--;
+    }
+
+    Schedule(timer, elapse, lock);
+}
+
+void MeaTimerService::Stop(Timer& timer) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (timer.m_slot != nullptr) {
+        Unlink(timer);
+        m_pendingCount--;
+    }
+
+    // A callback that stops its own timer must not wait for itself.
+    //
+    if (std::this_thread::get_id() != m_thread.get_id()) {
+        m_callbackDone.wait(lock, [this, &timer] { return m_running != &timer; });
+    }
+}
+
+void MeaTimerService::Shutdown() {
+    assert(std::this_thread::get_id() != m_thread.get_id());
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeup.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    // Discard the pending timers so that stopping them later finds
+    // nothing to cancel.
+    //
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (Timer*& slot : m_slots) {
+        while (slot != nullptr) {
+            Unlink(*slot);
+        }
+    }
+    while (m_expired != nullptr) {
+        Unlink(*m_expired);
+    }
+    m_pendingCount = 0;
+}
+
+void MeaTimerService::ThreadProc() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_shutdown) {
+        // Advance the wheel to the current time, moving expired timers
+        // to the expired list. If the thread has been idle for more than
+        // a full turn of the wheel, visiting each slot once is enough.
+        //
+        Clock::time_point now = Clock::now();
+        int64_t nowTick = ToTick(now);
+        int64_t numTicks = std::min<int64_t>(nowTick - m_currentTick, kWheelSize);
+
+        for (int64_t tick = m_currentTick + 1; tick <= m_currentTick + numTicks; tick++) {
+            Timer* timer = m_slots[tick & (kWheelSize - 1)];
+            while (timer != nullptr) {
+                Timer* next = timer->m_next;
+                if (timer->m_deadline <= now) {
+                    Unlink(*timer);
+                    Link(*timer, &m_expired);
+                }
+                timer = next;
+            }
+        }
+        m_currentTick = std::max(m_currentTick, nowTick);
+
+        // Run the callbacks of the expired timers in deadline order, even
+        // when the thread woke late and several timers expired together.
+        // The lock is released while a callback runs so that it can start
+        // or stop timers.
+        //
+        while (m_expired != nullptr && !m_shutdown) {
+            Timer* timer = m_expired;
+            for (Timer* next = timer->m_next; next != nullptr; next = next->m_next) {
+                if (next->m_deadline < timer->m_deadline) {
+                    timer = next;
+                }
+            }
+            Unlink(*timer);
+            m_pendingCount--;
+            m_running = timer;
+
+            lock.unlock();
+            timer->m_callback();
+            lock.lock();
+
+            m_running = nullptr;
+            m_callbackDone.notify_all();
+        }
+
+        if (m_shutdown) {
+            break;
+        }
+
+        // Callbacks may have started timers that are already due.
+        //
+        if (m_expired != nullptr) {
+            continue;
+        }
+
+        if (m_pendingCount == 0) {
+            m_wakeup.wait(lock);
+        } else {
+            // Sleep until the next occupied slot comes around. A timer in
+            // that slot might not be due until a later turn of the wheel,
+            // in which case the thread simply goes back to sleep.
+            //
+            int64_t wakeTick = m_currentTick + kWheelSize;
+            for (int64_t tick = m_currentTick + 1; tick < m_currentTick + kWheelSize; tick++) {
+                if (m_slots[tick & (kWheelSize - 1)] != nullptr) {
+                    wakeTick = tick;
+                    break;
+                }
+            }
+            m_wakeup.wait_until(lock, m_epoch + std::chrono::milliseconds(wakeTick));
+        }
+    }
+}
+
+void MeaTimerService::Schedule(Timer& timer, int elapse, std::unique_lock<std::mutex>& lock) {
+    Clock::time_point now = Clock::now();
+
+    if (elapse <= 0) {
+        timer.m_deadline = now;
+        Link(timer, &m_expired);
+    } else {
+        // Round the deadline up to the next tick so that a timer never
+        // expires early.
+        //
+        timer.m_deadline = now + std::chrono::milliseconds(elapse);
+        int64_t tick = std::chrono::ceil<std::chrono::milliseconds>(timer.m_deadline - m_epoch).count();
+        if (tick <= m_currentTick) {
+            Link(timer, &m_expired);
+        } else {
+            Link(timer, &m_slots[tick & (kWheelSize - 1)]);
+        }
+    }
+    m_pendingCount++;
+
+    if (!m_thread.joinable()) {
+        m_currentTick = ToTick(now);
+        m_thread = std::thread(&MeaTimerService::ThreadProc, this);
+    }
+
+    lock.unlock();
+    m_wakeup.notify_one();
+}
+
+void MeaTimerService::Link(Timer& timer, Timer** slot) {
+    assert(timer.m_slot == nullptr);
+
+    timer.m_slot = slot;
+    timer.m_prev = nullptr;
+    timer.m_next = *slot;
+    if (*slot != nullptr) {
+        (*slot)->m_prev = &timer;
+    }
+    *slot = &timer;
+}
+
+void MeaTimerService::Unlink(Timer& timer) {
+    assert(timer.m_slot != nullptr);
+
+    if (timer.m_prev != nullptr) {
+        timer.m_prev->m_next = timer.m_next;
+    } else {
+        *timer.m_slot = timer.m_next;
+    }
+    if (timer.m_next != nullptr) {
+        timer.m_next->m_prev = timer.m_prev;
+    }
+
+    timer.m_slot = nullptr;
+    timer.m_prev = nullptr;
+    timer.m_next = nullptr;
+}
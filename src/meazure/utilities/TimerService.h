@@ -0,0 +1,183 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// @file
+/// @brief Header file for the timer scheduling service.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+/// Schedules delayed callbacks on a single service thread. Rather than
+/// dedicating a thread to each pending timer, all timers are kept on a
+/// hashed timer wheel serviced by one thread. Starting and stopping a
+/// timer are constant time operations that never create a thread.
+///
+/// The wheel consists of kWheelSize slots, each one millisecond wide.
+/// A timer is placed in the slot corresponding to its expiration time
+/// modulo the wheel size. Timers with intervals longer than the wheel
+/// simply remain in their slot until the wheel has come around enough
+/// times for them to expire.
+///
+class MeaTimerService {
+
+public:
+    typedef std::function<void()> Callback;     ///< Function called when a timer expires.
+
+    /// A timer scheduled by the service. The timer is owned by the
+    /// caller and must be stopped before it is destroyed.
+    ///
+    class Timer {
+
+    public:
+        /// Constructs a timer.
+        ///
+        /// @param callback [in] Function called on the service thread when
+        ///                 the timer expires.
+        ///
+        explicit Timer(const Callback& callback);
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        friend class MeaTimerService;
+
+        Callback m_callback;                            ///< Function called when the timer expires.
+        Timer* m_prev;                                  ///< Previous timer in the wheel slot.
+        Timer* m_next;                                  ///< Next timer in the wheel slot.
+        Timer** m_slot;                                 ///< Wheel slot holding the timer, nullptr if not pending.
+        std::chrono::steady_clock::time_point m_deadline;   ///< Time at which the timer expires.
+    };
+
+
+    static constexpr int kWheelSize { 256 };    ///< Number of slots in the timer wheel. Must be a power of 2.
+
+
+    /// Constructs the service. The service thread is started when the
+    /// first timer is started.
+    ///
+    MeaTimerService();
+
+    /// Stops the service thread. Pending timers are discarded.
+    ///
+    ~MeaTimerService();
+
+    MeaTimerService(const MeaTimerService&) = delete;
+    MeaTimerService& operator=(const MeaTimerService&) = delete;
+
+    /// Starts the specified timer. If the timer is already pending, it
+    /// is left unchanged so that repeated calls do not pile up expirations.
+    ///
+    /// @param timer    [in] Timer to start.
+    /// @param elapse   [in] Time interval in milliseconds. An interval of
+    ///                 zero or less expires the timer as soon as possible.
+    ///
+    /// @return <b>true</b> if the timer was started, <b>false</b> if it
+    ///         was already pending or the service has been shut down.
+    ///
+    bool Start(Timer& timer, int elapse);
+
+    /// Starts the specified timer with a new interval. Unlike Start, a
+    /// pending timer is rescheduled to expire the new interval from now.
+    /// The method does not wait for the timer's callback if it is
+    /// executing, so it may be called from the callback itself. Has no
+    /// effect once the service has been shut down.
+    ///
+    /// @param timer    [in] Timer to restart.
+    /// @param elapse   [in] Time interval in milliseconds. An interval of
+    ///                 zero or less expires the timer as soon as possible.
+    ///
+    void Restart(Timer& timer, int elapse);
+
+    /// Cancels the specified timer if it is pending. If the timer's
+    /// callback is executing on the service thread, this method waits
+    /// for it to complete, unless called from the callback itself. Once
+    /// this method returns, the timer may safely be destroyed.
+    ///
+    /// @param timer    [in] Timer to stop.
+    ///
+    void Stop(Timer& timer);
+
+    /// Stops the service thread and discards all pending timers. Once
+    /// shut down, the service no longer starts timers but timers may
+    /// still be stopped. Must not be called from a timer callback.
+    ///
+    void Shutdown();
+
+private:
+    typedef std::chrono::steady_clock Clock;    ///< Clock used to time the timers.
+
+    /// Service thread procedure. Advances the wheel, runs the callbacks
+    /// of expired timers and sleeps until the next timer is due.
+    ///
+    void ThreadProc();
+
+    /// Places the timer on the wheel, or on the expired list if it is
+    /// already due, and wakes the service thread. The timer must not be
+    /// pending.
+    ///
+    /// @param timer    [in] Timer to schedule.
+    /// @param elapse   [in] Time interval in milliseconds.
+    /// @param lock     [in] Lock held on m_mutex. Released on return.
+    ///
+    void Schedule(Timer& timer, int elapse, std::unique_lock<std::mutex>& lock);
+
+    /// Converts the specified time to a wheel tick, rounding down.
+    ///
+    /// @param time     [in] Time to convert.
+    ///
+    /// @return Number of whole milliseconds between the service epoch and time.
+    ///
+    int64_t ToTick(const Clock::time_point& time) const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(time - m_epoch).count();
+    }
+
+    /// Adds the timer to the front of the specified list.
+    ///
+    /// @param timer    [in] Timer to add.
+    /// @param slot     [in] Head of the list.
+    ///
+    static void Link(Timer& timer, Timer** slot);
+
+    /// Removes the timer from the list it is in.
+    ///
+    /// @param timer    [in] Timer to remove.
+    ///
+    static void Unlink(Timer& timer);
+
+
+    std::mutex m_mutex;                         ///< Guards all service state.
+    std::condition_variable m_wakeup;           ///< Wakes the service thread when a timer is started or on shutdown.
+    std::condition_variable m_callbackDone;     ///< Signaled when a callback has finished executing.
+    std::thread m_thread;                       ///< Service thread, started on first use.
+    bool m_shutdown;                            ///< Indicates that the service thread should exit.
+    Clock::time_point m_epoch;                  ///< Time corresponding to wheel tick 0.
+    int64_t m_currentTick;                      ///< Last wheel tick processed by the service thread.
+    int m_pendingCount;                         ///< Number of pending timers.
+    Timer* m_slots[kWheelSize];                 ///< Timer wheel slots.
+    Timer* m_expired;                           ///< Timers that have expired but whose callbacks have not yet run.
+    Timer* m_running;                           ///< Timer whose callback is currently executing.
+};
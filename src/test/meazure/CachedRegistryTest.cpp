@@ -0,0 +1,306 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE CachedRegistryTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include "mocks/MockRegistry.h"
+#include <meazure/utilities/CachedRegistry.h>
+#include <meazure/profile/RegistryProfile.h>
+#include <map>
+
+
+/// Mock registry backed by an in-memory store of sections, so that values written can be read back.
+///
+struct TestFixture {
+    TestFixture() {
+        mock.m_openKey = mock.m_openKeyNoop;
+        mock.m_closeKey = mock.m_closeKeyNoop;
+
+        mock.m_writeInt = [this](PCTSTR section, PCTSTR entry, int value) {
+            store[CString(section)][CString(entry)] = MeaRegistryValue(entry, value);
+            return TRUE;
+        };
+        mock.m_writeString = [this](PCTSTR section, PCTSTR entry, PCTSTR value) {
+            if (entry == nullptr) {
+                store.erase(CString(section));
+            } else if (value == nullptr) {
+                store[CString(section)].erase(CString(entry));
+            } else {
+                store[CString(section)][CString(entry)] = MeaRegistryValue(entry, value);
+            }
+            return TRUE;
+        };
+        mock.m_getInt = [this](PCTSTR section, PCTSTR entry, int defaultValue) {
+            auto& values = store[CString(section)];
+            auto iter = values.find(CString(entry));
+            return (iter == values.end() || iter->second.isString) ? defaultValue : iter->second.intValue;
+        };
+        mock.m_getString = [this](PCTSTR section, PCTSTR entry, PCTSTR defaultValue) {
+            auto& values = store[CString(section)];
+            auto iter = values.find(CString(entry));
+            return (iter == values.end() || !iter->second.isString) ? CString(defaultValue) : iter->second.strValue;
+        };
+        mock.m_getValues = [this](PCTSTR section, MeaRegistryValues& values) {
+            auto iter = store.find(CString(section));
+            if (iter == store.end()) {
+                return FALSE;
+            }
+            for (const auto& value : iter->second) {
+                values.push_back(value.second);
+            }
+            return TRUE;
+        };
+        mock.m_writeValues = [this](PCTSTR section, const MeaRegistryValues& values) {
+            for (const MeaRegistryValue& value : values) {
+                store[CString(section)][value.entry] = value;
+            }
+            lastWritten = values;
+            return TRUE;
+        };
+    }
+
+    /// Number of calls made to the mock registry to read or write values.
+    ///
+    int CallCount() const {
+        return mock.m_writeIntCount + mock.m_writeStringCount + mock.m_getIntCount + mock.m_getStringCount +
+            mock.m_getValuesCount + mock.m_writeValuesCount;
+    }
+
+    MockRegistry mock;
+    std::map<CString, std::map<CString, MeaRegistryValue>> store;
+    MeaRegistryValues lastWritten;
+};
+
+/// Number of values saved and loaded by SaveProfile and LoadProfile.
+static constexpr int kNumProfileValues = 200;
+
+/// Saves a profile with many values of each type, as the application does at shutdown.
+///
+static void SaveProfile(MeaProfile& profile) {
+    for (int i = 0; i < kNumProfileValues; i++) {
+        CString key;
+        key.Format(_T("Key%d"), i);
+        switch (i % 4) {
+        case 0:
+            profile.WriteBool(key, i % 3 == 0);
+            break;
+        case 1:
+            profile.WriteInt(key, i);
+            break;
+        case 2:
+            profile.WriteDbl(key, i / 8.0);
+            break;
+        default:
+            key.Format(_T("Value %d"), i);
+            profile.WriteStr(CString(_T("StrKey")) + key, key);
+            break;
+        }
+    }
+}
+
+/// Loads the values saved by SaveProfile, as the application does at startup.
+///
+/// @return true if all values were read as saved.
+///
+static bool LoadProfile(MeaProfile& profile) {
+    bool ok = true;
+    for (int i = 0; i < kNumProfileValues; i++) {
+        CString key;
+        key.Format(_T("Key%d"), i);
+        switch (i % 4) {
+        case 0:
+            ok = ok && (profile.ReadBool(key, false) == (i % 3 == 0));
+            break;
+        case 1:
+            ok = ok && (profile.ReadInt(key, -1) == static_cast<UINT>(i));
+            break;
+        case 2:
+            ok = ok && (profile.ReadDbl(key, -1.0) == i / 8.0);
+            break;
+        default:
+            key.Format(_T("Value %d"), i);
+            ok = ok && (profile.ReadStr(CString(_T("StrKey")) + key, _T("")) == key);
+            break;
+        }
+    }
+    return ok;
+}
+
+
+BOOST_FIXTURE_TEST_CASE(TestReadPreloadsSection, TestFixture) {
+    store[CString(_T("2.0"))][CString(_T("a"))] = MeaRegistryValue(_T("a"), 17);
+    store[CString(_T("2.0"))][CString(_T("b"))] = MeaRegistryValue(_T("b"), _T("text"));
+
+    MeaCachedRegistry cache(mock);
+    BOOST_TEST(mock.m_getValuesCount == 0);
+
+    BOOST_TEST(cache.GetInt(_T("2.0"), _T("a"), 3) == 17U);
+    BOOST_TEST(cache.GetString(_T("2.0"), _T("b"), _T("def")) == CString(_T("text")));
+    BOOST_TEST(cache.GetInt(_T("2.0"), _T("missing"), 3) == 3U);
+    BOOST_TEST(cache.GetString(_T("2.0"), _T("missing"), _T("def")) == CString(_T("def")));
+
+    BOOST_TEST(mock.m_getValuesCount == 1);
+    BOOST_TEST(mock.m_getIntCount == 0);
+    BOOST_TEST(mock.m_getStringCount == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestTypeMismatch, TestFixture) {
+    store[CString(_T("2.0"))][CString(_T("a"))] = MeaRegistryValue(_T("a"), 17);
+    store[CString(_T("2.0"))][CString(_T("b"))] = MeaRegistryValue(_T("b"), _T("text"));
+
+    MeaCachedRegistry cache(mock);
+    BOOST_TEST(cache.GetString(_T("2.0"), _T("a"), _T("def")) == CString(_T("def")));
+    BOOST_TEST(cache.GetInt(_T("2.0"), _T("b"), 3) == 3U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestCaseInsensitive, TestFixture) {
+    store[CString(_T("Section"))][CString(_T("MixedCase"))] = MeaRegistryValue(_T("MixedCase"), 5);
+
+    // The mock registry is case sensitive, so the section is first read using its stored name.
+    MeaCachedRegistry cache(mock);
+    BOOST_TEST(cache.GetInt(_T("Section"), _T("mixedcase"), 0) == 5U);
+    BOOST_TEST(cache.GetInt(_T("SECTION"), _T("MIXEDCASE"), 0) == 5U);
+    BOOST_TEST(cache.WriteInt(_T("section"), _T("MIXEDCASE"), 6));
+    BOOST_TEST(cache.GetInt(_T("Section"), _T("MixedCase"), 0) == 6U);
+    BOOST_TEST(cache.Flush());
+
+    // The value is written under the section and entry names as first seen.
+    BOOST_TEST(mock.m_getValuesCount == 1);
+    BOOST_TEST(mock.m_writeValuesCount == 1);
+    BOOST_TEST(store[CString(_T("Section"))][CString(_T("MixedCase"))].intValue == 6);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestWriteBehind, TestFixture) {
+    {
+        MeaCachedRegistry cache(mock);
+        BOOST_TEST(cache.WriteInt(_T("2.0"), _T("a"), 1));
+        BOOST_TEST(cache.WriteString(_T("2.0"), _T("b"), _T("x")));
+        BOOST_TEST(cache.WriteInt(_T("2.0"), _T("a"), 2));
+
+        // Writes are served from the cache and are not yet in the registry.
+        BOOST_TEST(cache.GetInt(_T("2.0"), _T("a"), 0) == 2U);
+        BOOST_TEST(cache.GetString(_T("2.0"), _T("b"), _T("")) == CString(_T("x")));
+        BOOST_TEST(store[CString(_T("2.0"))].empty());
+        BOOST_TEST(mock.m_writeIntCount == 0);
+        BOOST_TEST(mock.m_writeStringCount == 0);
+        BOOST_TEST(mock.m_writeValuesCount == 0);
+    }
+
+    // Destroying the cache flushes it.
+    BOOST_TEST(mock.m_writeValuesCount == 1);
+    BOOST_TEST(lastWritten.size() == 2U);
+    BOOST_TEST(store[CString(_T("2.0"))][CString(_T("a"))].intValue == 2);
+    BOOST_TEST(store[CString(_T("2.0"))][CString(_T("b"))].strValue == CString(_T("x")));
+}
+
+BOOST_FIXTURE_TEST_CASE(TestFlushOnlyChanged, TestFixture) {
+    store[CString(_T("2.0"))][CString(_T("a"))] = MeaRegistryValue(_T("a"), 1);
+    store[CString(_T("2.0"))][CString(_T("b"))] = MeaRegistryValue(_T("b"), _T("x"));
+
+    MeaCachedRegistry cache(mock);
+    BOOST_TEST(cache.WriteInt(_T("2.0"), _T("a"), 1));
+    BOOST_TEST(cache.WriteString(_T("2.0"), _T("b"), _T("x")));
+    BOOST_TEST(cache.Flush());
+    BOOST_TEST(mock.m_writeValuesCount == 0);
+
+    BOOST_TEST(cache.WriteString(_T("2.0"), _T("b"), _T("y")));
+    BOOST_TEST(cache.WriteString(_T("3.0"), _T("c"), _T("z")));
+    BOOST_TEST(cache.Flush());
+    BOOST_TEST(mock.m_writeValuesCount == 2);
+    BOOST_TEST(store[CString(_T("2.0"))][CString(_T("b"))].strValue == CString(_T("y")));
+    BOOST_TEST(store[CString(_T("3.0"))][CString(_T("c"))].strValue == CString(_T("z")));
+
+    // Nothing has changed since the last flush.
+    BOOST_TEST(cache.Flush());
+    BOOST_TEST(mock.m_writeValuesCount == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestDelete, TestFixture) {
+    store[CString(_T("2.0"))][CString(_T("a"))] = MeaRegistryValue(_T("a"), 1);
+    store[CString(_T("2.0"))][CString(_T("b"))] = MeaRegistryValue(_T("b"), 2);
+
+    MeaCachedRegistry cache(mock);
+    BOOST_TEST(cache.WriteInt(_T("2.0"), _T("b"), 3));
+    BOOST_TEST(cache.WriteString(_T("2.0"), _T("a"), nullptr));
+
+    // The pending write is flushed before the deletion is passed through.
+    BOOST_TEST(mock.m_writeValuesCount == 1);
+    BOOST_TEST(mock.m_writeStringCount == 1);
+    BOOST_TEST(store[CString(_T("2.0"))].count(CString(_T("a"))) == 0U);
+    BOOST_TEST(store[CString(_T("2.0"))][CString(_T("b"))].intValue == 3);
+    BOOST_TEST(cache.GetInt(_T("2.0"), _T("a"), 7) == 7U);
+
+    BOOST_TEST(cache.WriteString(_T("2.0"), nullptr, nullptr));
+    BOOST_TEST(store.count(CString(_T("2.0"))) == 0U);
+    BOOST_TEST(cache.GetInt(_T("2.0"), _T("b"), 7) == 7U);
+}
+
+BOOST_FIXTURE_TEST_CASE(TestProfileCallCounts, TestFixture) {
+    // Uncached profile, which makes one registry call per value.
+    {
+        MeaRegistryProfile profile(mock);
+        SaveProfile(profile);
+        BOOST_TEST(CallCount() == kNumProfileValues);
+        BOOST_TEST(LoadProfile(profile));
+        BOOST_TEST(CallCount() == 2 * kNumProfileValues);
+    }
+
+    store.clear();
+    int callCount = CallCount();
+
+    // Cached profile, which makes one registry call to read and one to write each section.
+    {
+        MeaCachedRegistry cache(mock);
+        MeaRegistryProfile profile(cache);
+        SaveProfile(profile);
+    }
+    BOOST_TEST(CallCount() - callCount == 2);
+    BOOST_TEST(lastWritten.size() == static_cast<size_t>(kNumProfileValues));
+
+    // Loading reads the section once.
+    callCount = CallCount();
+    {
+        MeaCachedRegistry cache(mock);
+        MeaRegistryProfile profile(cache);
+        BOOST_TEST(LoadProfile(profile));
+    }
+    BOOST_TEST(CallCount() - callCount == 1);
+
+    // Saving again with a few changed values only writes those values.
+    callCount = CallCount();
+    {
+        MeaCachedRegistry cache(mock);
+        MeaRegistryProfile profile(cache);
+        SaveProfile(profile);
+        profile.WriteInt(_T("Key1"), 1000);
+        profile.WriteStr(_T("StrKeyValue 3"), _T("changed"));
+    }
+    BOOST_TEST(CallCount() - callCount == 2);
+    BOOST_TEST(lastWritten.size() == 2U);
+
+    // The uncached profile reads the values written through the cache.
+    {
+        MeaRegistryProfile profile(mock);
+        BOOST_TEST(profile.ReadInt(_T("Key1"), 0) == 1000U);
+        BOOST_TEST(profile.ReadStr(_T("StrKeyValue 3"), _T("")) == CString(_T("changed")));
+        BOOST_TEST(profile.ReadDbl(_T("Key2"), 0.0) == 2.0 / 8.0);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ChangeDetectorTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/ChangeDetector.h>
+#include <set>
+#include <vector>
+
+
+namespace {
+    constexpr int kBase = 70;
+    constexpr int kMax = 560;
+    constexpr int kIdle = 3;
+}
+
+
+BOOST_AUTO_TEST_CASE(TestHashSinglePixelChanges) {
+    const int width = 13;
+    const int height = 7;
+    const int stride = 16;
+    std::vector<uint32_t> pixels(stride * height, 0x00204060);
+    MeaPixelBuffer buffer { pixels.data(), width, height, stride };
+
+    std::set<uint64_t> hashes;
+    uint64_t original = MeaChangeDetector::Hash(buffer);
+    hashes.insert(original);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint32_t& pixel = pixels[y * stride + x];
+            pixel ^= 0x00000001;
+            hashes.insert(MeaChangeDetector::Hash(buffer));
+            pixel ^= 0x00000001;
+        }
+    }
+    BOOST_TEST(hashes.size() == static_cast<size_t>(width * height + 1));
+    BOOST_TEST(MeaChangeDetector::Hash(buffer) == original);
+
+    // Row padding is not part of the image.
+    pixels[width] = 0x00FFFFFF;
+    BOOST_TEST(MeaChangeDetector::Hash(buffer) == original);
+
+    // The dimensions are part of the hash.
+    MeaPixelBuffer narrower { pixels.data(), width - 1, height, stride };
+    BOOST_TEST(MeaChangeDetector::Hash(narrower) != original);
+}
+
+BOOST_AUTO_TEST_CASE(TestDetectChanges) {
+    MeaChangeDetector detector(kBase, kMax, kIdle);
+    POINT pos = { 10, 20 };
+
+    BOOST_TEST(detector.Check(pos, 1, 100));
+    BOOST_TEST(!detector.Check(pos, 1, 100));
+
+    pos.x++;
+    BOOST_TEST(detector.Check(pos, 1, 100));
+    BOOST_TEST(!detector.Check(pos, 1, 100));
+    pos.y++;
+    BOOST_TEST(detector.Check(pos, 1, 100));
+    BOOST_TEST(detector.Check(pos, 2, 100));
+    BOOST_TEST(detector.Check(pos, 2, 101));
+    BOOST_TEST(!detector.Check(pos, 2, 101));
+
+    detector.Invalidate();
+    BOOST_TEST(detector.Check(pos, 2, 101));
+
+    BOOST_TEST(detector.GetStats().checks == 9U);
+    BOOST_TEST(detector.GetStats().unchanged == 3U);
+}
+
+BOOST_AUTO_TEST_CASE(TestBackoff) {
+    MeaChangeDetector detector(kBase, kMax, kIdle);
+    POINT pos = { 0, 0 };
+
+    BOOST_TEST(detector.GetInterval() == kBase);
+    BOOST_TEST(detector.Check(pos, 0, 1));
+    BOOST_TEST(detector.GetInterval() == kBase);
+
+    // The interval stays at the base until the idle threshold is reached, then doubles up to the maximum.
+    const int expected[] = { kBase, kBase, 2 * kBase, 4 * kBase, 8 * kBase, kMax, kMax };
+    for (int interval : expected) {
+        BOOST_TEST(!detector.Check(pos, 0, 1));
+        BOOST_TEST(detector.GetInterval() == interval);
+    }
+
+    // Any change returns to the base interval immediately.
+    BOOST_TEST(detector.Check(pos, 0, 2));
+    BOOST_TEST(detector.GetInterval() == kBase);
+    BOOST_TEST(!detector.Check(pos, 0, 2));
+    BOOST_TEST(detector.GetInterval() == kBase);
+
+    for (int i = 0; i < 10; i++) {
+        detector.Check(pos, 0, 2);
+    }
+    BOOST_TEST(detector.GetInterval() == kMax);
+    detector.Invalidate();
+    BOOST_TEST(detector.GetInterval() == kBase);
+}
+
+BOOST_AUTO_TEST_CASE(TestMaxBelowBase) {
+    MeaChangeDetector detector(kBase, kBase / 2, 1);
+    POINT pos = { 0, 0 };
+
+    detector.Check(pos, 0, 0);
+    detector.Check(pos, 0, 0);
+    detector.Check(pos, 0, 0);
+    BOOST_TEST(detector.GetInterval() == kBase);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ColorBatchTest
+#include "GlobalFixture.h"
+#define COMPILE_LAYERED_WINDOW_STUBS
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/LayeredWindows.h>
+#include <meazure/graphics/ColorBatch.h>
+#include <meazure/graphics/Colors.h>
+#include <cmath>
+#include <vector>
+
+
+namespace {
+    /// Pixels covering the RGB cube, including the extremes. The count is deliberately not a multiple of four so
+    /// that the scalar conversion of the remaining pixels is exercised.
+    ///
+    std::vector<uint32_t> MakePixels() {
+        std::vector<uint32_t> pixels;
+        for (int red = 0; red < 256; red += 15) {
+            for (int green = 0; green < 256; green += 15) {
+                for (int blue = 0; blue < 256; blue += 15) {
+                    pixels.push_back(0xFF000000 | (red << 16) | (green << 8) | blue);
+                }
+            }
+        }
+        pixels.push_back(0x00FFFFFF);
+        pixels.push_back(0x00808080);
+        pixels.push_back(0x000A141E);
+        return pixels;
+    }
+
+    typedef void (*Conversion)(const uint32_t* pixels, size_t count, float* out0, float* out1, float* out2);
+
+    /// Converts the pixels as a batch and one pixel at a time, which uses the scalar conversion.
+    ///
+    void Convert(Conversion conversion, const std::vector<uint32_t>& pixels, std::vector<float> batch[3],
+                 std::vector<float> single[3]) {
+        for (int n = 0; n < 3; n++) {
+            batch[n].resize(pixels.size());
+            single[n].resize(pixels.size());
+        }
+        conversion(pixels.data(), pixels.size(), batch[0].data(), batch[1].data(), batch[2].data());
+        for (size_t i = 0; i < pixels.size(); i++) {
+            conversion(&pixels[i], 1, &single[0][i], &single[1][i], &single[2][i]);
+        }
+    }
+
+    /// Rounded conversions are within half of one of the batch conversions, allowing for the tolerance.
+    constexpr double kRoundedTolerance = 0.5 + MeaColorBatch::kTolerance;
+}
+
+
+BOOST_AUTO_TEST_CASE(TestPixelToCOLORREF) {
+    BOOST_TEST(MeaColorBatch::PixelToCOLORREF(0xFF102030) == RGB(0x10, 0x20, 0x30));
+    BOOST_TEST(MeaColorBatch::PixelToCOLORREF(0x00000000) == RGB(0, 0, 0));
+    BOOST_TEST(MeaColorBatch::PixelToCOLORREF(0x00FFFFFF) == RGB(0xFF, 0xFF, 0xFF));
+}
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    MeaColorBatch::ToHSL(nullptr, 0, nullptr, nullptr, nullptr);
+    MeaColorBatch::ToCMYK(nullptr, 0, nullptr, nullptr, nullptr, nullptr);
+    MeaColorBatch::ToYCbCr(nullptr, 0, nullptr, nullptr, nullptr);
+    MeaColorBatch::ToYIQ(nullptr, 0, nullptr, nullptr, nullptr);
+    MeaColorBatch::ToXYZ(nullptr, 0, nullptr, nullptr, nullptr);
+    MeaColorBatch::ToLab(nullptr, 0, nullptr, nullptr, nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(TestHSL) {
+    std::vector<uint32_t> pixels = MakePixels();
+    std::vector<float> batch[3];
+    std::vector<float> single[3];
+    Convert(MeaColorBatch::ToHSL, pixels, batch, single);
+
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColors::HSL hsl = MeaColors::RGBtoHSL(MeaColorBatch::PixelToCOLORREF(pixels[i]));
+        for (const std::vector<float>* values : { batch, single }) {
+            // A hue of 360 is equivalent to 0.
+            double hueDiff = std::fabs(values[0][i] - hsl.hue);
+            BOOST_TEST((hueDiff <= kRoundedTolerance || std::fabs(hueDiff - 360.0) <= kRoundedTolerance));
+            BOOST_TEST(std::fabs(values[1][i] - hsl.saturation) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[2][i] - hsl.lightness) <= kRoundedTolerance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestCMYK) {
+    std::vector<uint32_t> pixels = MakePixels();
+    std::vector<float> batch[4];
+    std::vector<float> single[4];
+    for (int n = 0; n < 4; n++) {
+        batch[n].resize(pixels.size());
+        single[n].resize(pixels.size());
+    }
+    MeaColorBatch::ToCMYK(pixels.data(), pixels.size(), batch[0].data(), batch[1].data(), batch[2].data(),
+                          batch[3].data());
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColorBatch::ToCMYK(&pixels[i], 1, &single[0][i], &single[1][i], &single[2][i], &single[3][i]);
+    }
+
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColors::CMYK cmyk = MeaColors::RGBtoCMYK(MeaColorBatch::PixelToCOLORREF(pixels[i]));
+        for (const std::vector<float>* values : { batch, single }) {
+            BOOST_TEST(std::fabs(values[0][i] - cmyk.cyan) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[1][i] - cmyk.magenta) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[2][i] - cmyk.yellow) <= kRoundedTolerance);
+            BOOST_TEST(values[3][i] == cmyk.black);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestYCbCr) {
+    std::vector<uint32_t> pixels = MakePixels();
+    std::vector<float> batch[3];
+    std::vector<float> single[3];
+    Convert(MeaColorBatch::ToYCbCr, pixels, batch, single);
+
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColors::YCbCr ycbcr = MeaColors::RGBtoYCbCr(MeaColorBatch::PixelToCOLORREF(pixels[i]));
+        for (const std::vector<float>* values : { batch, single }) {
+            BOOST_TEST(std::fabs(values[0][i] - ycbcr.y) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[1][i] - ycbcr.cb) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[2][i] - ycbcr.cr) <= kRoundedTolerance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestYIQ) {
+    std::vector<uint32_t> pixels = MakePixels();
+    std::vector<float> batch[3];
+    std::vector<float> single[3];
+    Convert(MeaColorBatch::ToYIQ, pixels, batch, single);
+
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColors::YIQ yiq = MeaColors::RGBtoYIQ(MeaColorBatch::PixelToCOLORREF(pixels[i]));
+        for (const std::vector<float>* values : { batch, single }) {
+            BOOST_TEST(std::fabs(values[0][i] - yiq.y) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[1][i] - yiq.i) <= kRoundedTolerance);
+            BOOST_TEST(std::fabs(values[2][i] - yiq.q) <= kRoundedTolerance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestXYZ) {
+    std::vector<uint32_t> pixels = MakePixels();
+    std::vector<float> batch[3];
+    std::vector<float> single[3];
+    Convert(MeaColorBatch::ToXYZ, pixels, batch, single);
+
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColors::XYZ xyz = MeaColors::RGBtoXYZ(MeaColorBatch::PixelToCOLORREF(pixels[i]));
+        for (const std::vector<float>* values : { batch, single }) {
+            BOOST_TEST(std::fabs(values[0][i] - xyz.x) <= MeaColorBatch::kTolerance);
+            BOOST_TEST(std::fabs(values[1][i] - xyz.y) <= MeaColorBatch::kTolerance);
+            BOOST_TEST(std::fabs(values[2][i] - xyz.z) <= MeaColorBatch::kTolerance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestLab) {
+    std::vector<uint32_t> pixels = MakePixels();
+    std::vector<float> batch[3];
+    std::vector<float> single[3];
+    Convert(MeaColorBatch::ToLab, pixels, batch, single);
+
+    for (size_t i = 0; i < pixels.size(); i++) {
+        MeaColors::Lab lab = MeaColors::RGBtoLab(MeaColorBatch::PixelToCOLORREF(pixels[i]));
+        for (const std::vector<float>* values : { batch, single }) {
+            BOOST_TEST(std::fabs(values[0][i] - lab.l) <= MeaColorBatch::kTolerance);
+            BOOST_TEST(std::fabs(values[1][i] - lab.a) <= MeaColorBatch::kTolerance);
+            BOOST_TEST(std::fabs(values[2][i] - lab.b) <= MeaColorBatch::kTolerance);
+        }
+    }
+}
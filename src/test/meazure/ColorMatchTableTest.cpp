@@ -0,0 +1,110 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ColorMatchTableTest
+#include "GlobalFixture.h"
+#define COMPILE_LAYERED_WINDOW_STUBS
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/LayeredWindows.h>
+#include <meazure/graphics/ColorMatchTable.h>
+#include <meazure/graphics/Colors.h>
+#include <atomic>
+
+
+namespace {
+    MeaColors::ColorTableEntry testColors[] = {
+        { "black", RGB(0, 0, 0),       MeaColors::Lab() },
+        { "gray",  RGB(128, 128, 128), MeaColors::Lab() },
+        { "white", RGB(255, 255, 255), MeaColors::Lab() },
+        { nullptr, 0,                  MeaColors::Lab() }
+    };
+
+    MeaColors::ColorTableEntry emptyColors[] = {
+        { nullptr, 0, MeaColors::Lab() }
+    };
+
+    std::atomic<int> matchCount(0);
+
+    // Inexpensive stand in for MeaColors::MatchColor that picks an entry based on the sum of the components.
+    const MeaColors::ColorTableEntry* SumMatcher(const MeaColors::ColorTableEntry* table, COLORREF rgb) {
+        matchCount++;
+        return &table[(GetRValue(rgb) + GetGValue(rgb) + GetBValue(rgb)) % 3];
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestLookup) {
+    matchCount = 0;
+    MeaColorMatchTable table(testColors, SumMatcher);
+
+    BOOST_TEST(!table.IsReady());
+    BOOST_TEST(table.Lookup(RGB(1, 2, 3)) == nullptr);
+    BOOST_TEST(table.GetMemorySize() == 0U);
+
+    table.Build();
+
+    BOOST_TEST(table.IsReady());
+    BOOST_TEST(table.GetMemorySize() == static_cast<std::size_t>(MeaColorMatchTable::kNumColors));
+    BOOST_TEST(matchCount == static_cast<int>(MeaColorMatchTable::kNumColors));
+
+    for (uint32_t rgb = 0; rgb < MeaColorMatchTable::kNumColors; rgb++) {
+        if (table.Lookup(rgb) != SumMatcher(testColors, rgb)) {
+            BOOST_FAIL("Mismatch for color " << rgb);
+        }
+    }
+
+    // Only the RGB components are used for the lookup.
+    BOOST_TEST(table.Lookup(0xFF000000 | RGB(1, 0, 0)) == &testColors[1]);
+
+    // Building again does nothing.
+    matchCount = 0;
+    table.Build();
+    table.BuildAsync();
+    BOOST_TEST(matchCount == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestBuildAsync) {
+    MeaColorMatchTable table(testColors, SumMatcher);
+
+    table.BuildAsync();
+    table.Build();      // Waits for the background build
+
+    BOOST_TEST(table.IsReady());
+    BOOST_TEST(table.Lookup(RGB(0, 0, 0)) == &testColors[0]);
+    BOOST_TEST(table.Lookup(RGB(0, 1, 0)) == &testColors[1]);
+    BOOST_TEST(table.Lookup(RGB(0, 1, 1)) == &testColors[2]);
+    BOOST_TEST(table.Lookup(RGB(255, 255, 255)) == &testColors[0]);
+}
+
+BOOST_AUTO_TEST_CASE(TestCancel) {
+    MeaColorMatchTable* table = new MeaColorMatchTable(testColors, SumMatcher);
+    table->BuildAsync();
+    delete table;       // Must stop the background build without waiting for it to complete
+}
+
+BOOST_AUTO_TEST_CASE(TestEmptyTable) {
+    MeaColorMatchTable table(emptyColors, SumMatcher);
+
+    table.Build();
+
+    BOOST_TEST(!table.IsReady());
+    BOOST_TEST(table.Lookup(RGB(1, 2, 3)) == nullptr);
+    BOOST_TEST(table.GetMemorySize() == 0U);
+}
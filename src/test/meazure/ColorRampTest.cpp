@@ -0,0 +1,165 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ColorRampTest
+#include "GlobalFixture.h"
+#define COMPILE_LAYERED_WINDOW_STUBS
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/LayeredWindows.h>
+#include <meazure/graphics/ColorRamp.h>
+#include <meazure/graphics/Colors.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+    /// Pairs of ramp endpoints, including grays, which have no hue, and hues on either side of red.
+    ///
+    const std::vector<std::pair<COLORREF, COLORREF>> kEndpoints = {
+        { RGB(0, 0, 0), RGB(255, 255, 255) },
+        { RGB(255, 255, 255), RGB(0, 0, 0) },
+        { RGB(10, 20, 30), RGB(200, 150, 100) },
+        { RGB(255, 0, 0), RGB(0, 0, 255) },
+        { RGB(255, 0, 40), RGB(255, 40, 0) },
+        { RGB(0, 128, 0), RGB(128, 128, 128) },
+        { RGB(12, 34, 56), RGB(12, 34, 56) },
+        { RGB(0, 255, 255), RGB(255, 255, 0) }
+    };
+
+    /// Interpolates in HSL space the way MeaColors::InterpolateColor does, but for an arbitrary fraction i / last.
+    ///
+    COLORREF InterpolateHSL(COLORREF startRGB, COLORREF endRGB, size_t i, size_t last) {
+        if (i == 0) {
+            return startRGB;
+        }
+        if (i == last) {
+            return endRGB;
+        }
+
+        auto interpolate = [i, last](int start, int end) {
+            return start + static_cast<int>(std::round(static_cast<double>(end - start) * i / last));
+        };
+
+        MeaColors::HSL startHSL = MeaColors::RGBtoHSL(startRGB);
+        MeaColors::HSL endHSL = MeaColors::RGBtoHSL(endRGB);
+        return MeaColors::HSLtoRGB(MeaColors::HSL(interpolate(startHSL.hue, endHSL.hue),
+                                                  interpolate(startHSL.saturation, endHSL.saturation),
+                                                  interpolate(startHSL.lightness, endHSL.lightness)));
+    }
+
+    /// Indicates whether each component of the two colors differs by at most one.
+    ///
+    bool IsClose(COLORREF color1, COLORREF color2) {
+        return std::abs(GetRValue(color1) - GetRValue(color2)) <= 1 &&
+            std::abs(GetGValue(color1) - GetGValue(color2)) <= 1 &&
+            std::abs(GetBValue(color1) - GetBValue(color2)) <= 1;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    MeaColorRamp::Generate(RGB(0, 0, 0), RGB(255, 255, 255), nullptr, 0);
+    MeaColorRamp::Generate(RGB(0, 0, 0), RGB(255, 255, 255), nullptr, 0, MeaColorRamp::Interpolation::Lab);
+}
+
+BOOST_AUTO_TEST_CASE(TestEndpoints) {
+    for (MeaColorRamp::Interpolation interpolation : { MeaColorRamp::Interpolation::HSL,
+                                                       MeaColorRamp::Interpolation::Lab }) {
+        COLORREF one;
+        MeaColorRamp::Generate(RGB(10, 20, 30), RGB(200, 150, 100), &one, 1, interpolation);
+        BOOST_TEST(one == RGB(10, 20, 30));
+
+        COLORREF two[2];
+        MeaColorRamp::Generate(RGB(10, 20, 30), RGB(200, 150, 100), two, 2, interpolation);
+        BOOST_TEST(two[0] == RGB(10, 20, 30));
+        BOOST_TEST(two[1] == RGB(200, 150, 100));
+
+        std::vector<COLORREF> colors(37);
+        MeaColorRamp::Generate(RGB(1, 2, 3), RGB(4, 5, 6), colors.data(), colors.size(), interpolation);
+        BOOST_TEST(colors.front() == RGB(1, 2, 3));
+        BOOST_TEST(colors.back() == RGB(4, 5, 6));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestHSLSameAsInterpolateColor) {
+    std::vector<COLORREF> colors(101);
+
+    for (const auto& endpoints : kEndpoints) {
+        MeaColorRamp::Generate(endpoints.first, endpoints.second, colors.data(), colors.size());
+        for (int percent = 0; percent <= 100; percent++) {
+            BOOST_TEST(colors[percent] == MeaColors::InterpolateColor(endpoints.first, endpoints.second, percent));
+        }
+    }
+
+    // Ramps whose steps are whole percentages
+    for (size_t count : { 3, 5, 11, 21, 26, 51 }) {
+        colors.resize(count);
+        size_t percentStep = 100 / (count - 1);
+        for (const auto& endpoints : kEndpoints) {
+            MeaColorRamp::Generate(endpoints.first, endpoints.second, colors.data(), count);
+            for (size_t i = 0; i < count; i++) {
+                int percent = static_cast<int>(i * percentStep);
+                BOOST_TEST(colors[i] == MeaColors::InterpolateColor(endpoints.first, endpoints.second, percent));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestHSLArbitraryCount) {
+    for (size_t count : { 3, 7, 64, 255, 1000, 4099 }) {
+        std::vector<COLORREF> colors(count);
+        for (const auto& endpoints : kEndpoints) {
+            MeaColorRamp::Generate(endpoints.first, endpoints.second, colors.data(), count);
+            for (size_t i = 0; i < count; i++) {
+                BOOST_TEST_REQUIRE(colors[i] == InterpolateHSL(endpoints.first, endpoints.second, i, count - 1));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestLab) {
+    // Counts that are and are not multiples of four, so that the SSE2 and scalar conversions are both exercised.
+    for (size_t count : { 3, 4, 9, 64, 255, 1000, 4099 }) {
+        std::vector<COLORREF> colors(count);
+        for (const auto& endpoints : kEndpoints) {
+            MeaColorRamp::Generate(endpoints.first, endpoints.second, colors.data(), count,
+                                   MeaColorRamp::Interpolation::Lab);
+
+            MeaColors::Lab startLab = MeaColors::RGBtoLab(endpoints.first);
+            MeaColors::Lab endLab = MeaColors::RGBtoLab(endpoints.second);
+            for (size_t i = 1; i + 1 < count; i++) {
+                double t = static_cast<double>(i) / (count - 1);
+                MeaColors::Lab lab(startLab.l + (endLab.l - startLab.l) * t,
+                                   startLab.a + (endLab.a - startLab.a) * t,
+                                   startLab.b + (endLab.b - startLab.b) * t);
+                BOOST_TEST_REQUIRE(IsClose(colors[i], MeaColors::LabtoRGB(lab)));
+            }
+        }
+    }
+
+    // A ramp between identical colors is that color throughout.
+    std::vector<COLORREF> colors(17);
+    MeaColorRamp::Generate(RGB(12, 34, 56), RGB(12, 34, 56), colors.data(), colors.size(),
+                           MeaColorRamp::Interpolation::Lab);
+    for (COLORREF color : colors) {
+        BOOST_TEST(color == RGB(12, 34, 56));
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ColorStatsTest
+#include "GlobalFixture.h"
+#define COMPILE_LAYERED_WINDOW_STUBS
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/LayeredWindows.h>
+#include <meazure/graphics/ColorStats.h>
+#include <float.h>
+#include <random>
+#include <vector>
+
+namespace bt = boost::unit_test;
+
+
+namespace {
+    /// Test image backed by a vector.
+    ///
+    struct Image {
+        std::vector<uint32_t> pixels;
+        MeaPixelBuffer buffer;
+
+        Image(int width, int height, int stride, uint32_t fill) : pixels(static_cast<size_t>(stride) * height, fill) {
+            buffer = { pixels.data(), width, height, stride };
+        }
+
+        void Fill(int left, int top, int right, int bottom, uint32_t pixel) {
+            for (int y = top; y < bottom; y++) {
+                for (int x = left; x < right; x++) {
+                    pixels[static_cast<size_t>(y) * buffer.stride + x] = pixel;
+                }
+            }
+        }
+    };
+}
+
+
+BOOST_AUTO_TEST_CASE(TestHistogramIndex) {
+    BOOST_TEST(MeaColorStats::HistogramIndex(0, 0, 0) == 0);
+    BOOST_TEST(MeaColorStats::HistogramIndex(255, 255, 255) == MeaColorStats::kHistogramSize - 1);
+    BOOST_TEST(MeaColorStats::HistogramIndex(0, 0, 8) == 1);
+    BOOST_TEST(MeaColorStats::HistogramIndex(0, 0, 7) == 0);
+    BOOST_TEST(MeaColorStats::HistogramIndex(0, 8, 0) == MeaColorStats::kHistogramSide);
+    BOOST_TEST(MeaColorStats::HistogramIndex(8, 0, 0) == MeaColorStats::kHistogramSide * MeaColorStats::kHistogramSide);
+}
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    Image image(0, 0, 0, 0);
+    MeaColorStats::Stats stats = MeaColorStats::Calculate(image.buffer, 5);
+
+    BOOST_TEST(stats.pixelCount == 0U);
+    BOOST_TEST(stats.red.mean == 0.0);
+    BOOST_TEST(stats.red.stddev == 0.0);
+    BOOST_TEST(stats.meanName == nullptr);
+    BOOST_TEST(stats.histogram.size() == static_cast<size_t>(MeaColorStats::kHistogramSize));
+    BOOST_TEST(stats.dominant.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestSolid) {
+    Image image(100, 70, 100, 0x00FF8000);
+    MeaColorStats::Stats stats = MeaColorStats::Calculate(image.buffer, 4);
+
+    BOOST_TEST(stats.pixelCount == 7000U);
+    BOOST_TEST(stats.red.mean == 255.0);
+    BOOST_TEST(stats.green.mean == 128.0);
+    BOOST_TEST(stats.blue.mean == 0.0);
+    BOOST_TEST(stats.red.stddev == 0.0);
+    BOOST_TEST(stats.green.stddev == 0.0);
+    BOOST_TEST(stats.blue.stddev == 0.0);
+    BOOST_TEST(stats.meanColor == RGB(255, 128, 0));
+    BOOST_TEST(stats.meanName == MeaColors::MatchExtendedColor(RGB(255, 128, 0)));
+    BOOST_TEST(stats.histogram[MeaColorStats::HistogramIndex(255, 128, 0)] == 7000U);
+
+    BOOST_TEST_REQUIRE(stats.dominant.size() == 1U);
+    BOOST_TEST(stats.dominant[0].rgb == RGB(255, 128, 0));
+    BOOST_TEST(stats.dominant[0].count == 7000U);
+    BOOST_TEST(stats.dominant[0].fraction == 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestMeanAndStddev, *bt::tolerance(DBL_EPSILON)) {
+    Image image(10, 10, 10, 0x00000000);
+    image.Fill(0, 0, 10, 5, 0x00FFFFFF);
+    MeaColorStats::Stats stats = MeaColorStats::Calculate(image.buffer, 2);
+
+    BOOST_TEST(stats.red.mean == 127.5);
+    BOOST_TEST(stats.green.mean == 127.5);
+    BOOST_TEST(stats.blue.mean == 127.5);
+    BOOST_TEST(stats.red.stddev == 127.5);
+    BOOST_TEST(stats.green.stddev == 127.5);
+    BOOST_TEST(stats.blue.stddev == 127.5);
+}
+
+BOOST_AUTO_TEST_CASE(TestDominant) {
+    // Regions of decreasing size: red 40%, blue 30%, white 20%, black 10%.
+    Image image(100, 100, 100, 0x00000000);
+    image.Fill(0, 0, 100, 40, 0x00FF0000);
+    image.Fill(0, 40, 100, 70, 0x000000FF);
+    image.Fill(0, 70, 100, 90, 0x00FFFFFF);
+    MeaColorStats::Stats stats = MeaColorStats::Calculate(image.buffer, 4);
+
+    BOOST_TEST_REQUIRE(stats.dominant.size() == 4U);
+    BOOST_TEST(stats.dominant[0].rgb == RGB(255, 0, 0));
+    BOOST_TEST(stats.dominant[0].count == 4000U);
+    BOOST_TEST(stats.dominant[0].name->name == _T("red"));
+    BOOST_TEST(stats.dominant[1].rgb == RGB(0, 0, 255));
+    BOOST_TEST(stats.dominant[1].name->name == _T("blue"));
+    BOOST_TEST(stats.dominant[2].rgb == RGB(255, 255, 255));
+    BOOST_TEST(stats.dominant[2].name->name == _T("white"));
+    BOOST_TEST(stats.dominant[3].rgb == RGB(0, 0, 0));
+    BOOST_TEST(stats.dominant[3].fraction == 0.1);
+    BOOST_TEST(stats.dominant[3].name->name == _T("black"));
+
+    // Asking for more colors than there are only returns the distinct colors.
+    stats = MeaColorStats::Calculate(image.buffer, 10);
+    BOOST_TEST(stats.dominant.size() == 4U);
+
+    // Asking for fewer merges colors.
+    stats = MeaColorStats::Calculate(image.buffer, 2);
+    BOOST_TEST_REQUIRE(stats.dominant.size() == 2U);
+    BOOST_TEST(stats.dominant[0].count + stats.dominant[1].count == 10000U);
+}
+
+BOOST_AUTO_TEST_CASE(TestStride) {
+    // Pixels beyond the width of each row are padding and must be ignored.
+    Image image(30, 200, 32, 0x00FFFFFF);
+    image.Fill(0, 0, 30, 200, 0x00102030);
+    MeaColorStats::Stats stats = MeaColorStats::Calculate(image.buffer, 3);
+
+    BOOST_TEST(stats.pixelCount == 6000U);
+    BOOST_TEST(stats.meanColor == RGB(0x10, 0x20, 0x30));
+    BOOST_TEST_REQUIRE(stats.dominant.size() == 1U);
+    BOOST_TEST(stats.dominant[0].rgb == RGB(0x10, 0x20, 0x30));
+}
+
+BOOST_AUTO_TEST_CASE(TestWorkerIndependence) {
+    std::mt19937 rng(46);
+    std::uniform_int_distribution<uint32_t> pixel(0, 0xFFFFFF);
+    Image image(257, 301, 260, 0);
+    for (uint32_t& value : image.pixels) {
+        value = pixel(rng);
+    }
+
+    MeaColorStats::Stats expected = MeaColorStats::Calculate(image.buffer, 8, 1);
+    BOOST_TEST(expected.dominant.size() == 8U);
+
+    for (int workers : { 2, 3, 8, 0 }) {
+        MeaColorStats::Stats stats = MeaColorStats::Calculate(image.buffer, 8, workers);
+        BOOST_TEST(stats.pixelCount == expected.pixelCount);
+        BOOST_TEST(stats.red.mean == expected.red.mean);
+        BOOST_TEST(stats.green.stddev == expected.green.stddev);
+        BOOST_TEST(stats.meanColor == expected.meanColor);
+        BOOST_TEST((stats.histogram == expected.histogram));
+        BOOST_TEST_REQUIRE(stats.dominant.size() == expected.dominant.size());
+        for (size_t i = 0; i < stats.dominant.size(); i++) {
+            BOOST_TEST(stats.dominant[i].rgb == expected.dominant[i].rgb);
+            BOOST_TEST(stats.dominant[i].count == expected.dominant[i].count);
+        }
+    }
+}
@@ -26,12 +26,144 @@
 #include <meazure/ui/LayeredWindows.h>
 #include <meazure/graphics/Colors.h>
 #include <float.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace bdata = boost::unit_test::data;
 namespace bt = boost::unit_test;
 namespace tt = boost::test_tools;
 
 
+/// Matches a color by computing the CIEDE2000 difference to every table entry. This is the reference for the
+/// pruned search performed by MeaColors::MatchColor.
+///
+static const MeaColors::ColorTableEntry* LinearMatchColor(const MeaColors::ColorTableEntry* table, COLORREF rgb) {
+    MeaColors::PreparedLab prepared = MeaColors::PrepareLab(MeaColors::RGBtoLab(rgb));
+
+    double minDiff = DBL_MAX;
+    const MeaColors::ColorTableEntry* bestEntry = nullptr;
+
+    for (const MeaColors::ColorTableEntry* entry = table; entry->name != nullptr; entry++) {
+        if (entry->rgb == rgb) {
+            return entry;
+        }
+
+        double diff = MeaColors::ColorDifference(entry->prepared, prepared);
+        if (diff < minDiff) {
+            minDiff = diff;
+            bestEntry = entry;
+        }
+    }
+
+    return bestEntry;
+}
+
+/// Verifies that MatchColor agrees with the linear search for the specified color in both color tables.
+///
+static bool CheckMatchColor(COLORREF rgb) {
+    return MeaColors::MatchColor(MeaColors::GetBasicColors(), rgb) == LinearMatchColor(MeaColors::GetBasicColors(), rgb)
+        && MeaColors::MatchColor(MeaColors::GetExtendedColors(), rgb) == LinearMatchColor(MeaColors::GetExtendedColors(), rgb);
+}
+
+/// Converts a color to L*a*b* using std::pow and std::cbrt. This is the reference for the constexpr conversion
+/// performed by MeaColors::RGBtoLab.
+///
+static MeaColors::Lab StdRGBtoLab(COLORREF rgb) {
+    auto inverseCompanding = [](double value) {
+        return 100.0 * ((value > 0.04045) ? std::pow((value + 0.055) / 1.055, 2.4) : value / 12.92);
+    };
+
+    double r = inverseCompanding(GetRValue(rgb) / 255.0);
+    double g = inverseCompanding(GetGValue(rgb) / 255.0);
+    double b = inverseCompanding(GetBValue(rgb) / 255.0);
+
+    auto func = [](double value) {
+        return (value > 0.008856) ? std::cbrt(value) : (903.3 / 116.0) * value + (16.0 / 116.0);
+    };
+
+    double x = func((r * 0.4124564 + g * 0.3575761 + b * 0.1804375) / 95.047);
+    double y = func((r * 0.2126729 + g * 0.7151522 + b * 0.0721750) / 100.000);
+    double z = func((r * 0.0193339 + g * 0.1191920 + b * 0.9503041) / 108.883);
+
+    return MeaColors::Lab((116.0 * y) - 16.0, 500.0 * (x - y), 200.0 * (y - z));
+}
+
+
+/// Calculates the CIEDE2000 difference directly from the equations, using std::pow and evaluating each cosine of
+/// the average hue separately. This is the reference for the optimized MeaColors::ColorDifference.
+///
+static double StdColorDifference(const MeaColors::Lab& color1, const MeaColors::Lab& color2) {
+    const double pow25To7 = std::pow(25.0, 7.0);
+    const double deg360Rad = MeaNumericUtils::DegToRad(360.0);
+    const double deg180Rad = MeaNumericUtils::DegToRad(180.0);
+
+    double c1 = std::sqrt(std::pow(color1.a, 2.0) + std::pow(color1.b, 2.0));
+    double c2 = std::sqrt(std::pow(color2.a, 2.0) + std::pow(color2.b, 2.0));
+    double cAvePow7 = std::pow((c1 + c2) / 2.0, 7.0);
+    double g = 0.5 * (1.0 - std::sqrt(cAvePow7 / (cAvePow7 + pow25To7)));
+
+    double aPrime1 = (1.0 + g) * color1.a;
+    double aPrime2 = (1.0 + g) * color2.a;
+    double cPrime1 = std::sqrt(std::pow(aPrime1, 2.0) + std::pow(color1.b, 2.0));
+    double cPrime2 = std::sqrt(std::pow(aPrime2, 2.0) + std::pow(color2.b, 2.0));
+
+    auto hueAngle = [deg360Rad](double b, double aPrime) {
+        if (MeaNumericUtils::IsZeroF(b) && MeaNumericUtils::IsZeroF(aPrime)) {
+            return 0.0;
+        }
+        double hPrime = std::atan2(b, aPrime);
+        return (hPrime < 0.0) ? hPrime + deg360Rad : hPrime;
+    };
+    double hPrime1 = hueAngle(color1.b, aPrime1);
+    double hPrime2 = hueAngle(color2.b, aPrime2);
+
+    double cPrimeProduct = cPrime1 * cPrime2;
+    double deltahPrime = 0.0;
+    double hPrimeAve = hPrime1 + hPrime2;
+    if (!MeaNumericUtils::IsZeroF(cPrimeProduct)) {
+        deltahPrime = hPrime2 - hPrime1;
+        if (deltahPrime > deg180Rad) {
+            deltahPrime -= deg360Rad;
+        } else if (deltahPrime < -deg180Rad) {
+            deltahPrime += deg360Rad;
+        }
+
+        if (std::fabs(hPrime1 - hPrime2) <= deg180Rad) {
+            hPrimeAve /= 2.0;
+        } else if (hPrimeAve < deg360Rad) {
+            hPrimeAve = (hPrimeAve + deg360Rad) / 2.0;
+        } else {
+            hPrimeAve = (hPrimeAve - deg360Rad) / 2.0;
+        }
+    }
+
+    double deltaLPrime = color2.l - color1.l;
+    double deltaCPrime = cPrime2 - cPrime1;
+    double deltaHPrime = 2.0 * std::sqrt(cPrimeProduct) * std::sin(deltahPrime / 2.0);
+
+    double lPrimeAve = (color1.l + color2.l) / 2.0;
+    double cPrimeAve = (cPrime1 + cPrime2) / 2.0;
+    double t = 1.0
+        - 0.17 * std::cos(hPrimeAve - MeaNumericUtils::DegToRad(30.0))
+        + 0.24 * std::cos(2.0 * hPrimeAve)
+        + 0.32 * std::cos(3.0 * hPrimeAve + MeaNumericUtils::DegToRad(6.0))
+        - 0.20 * std::cos(4.0 * hPrimeAve - MeaNumericUtils::DegToRad(63.0));
+    double deltaTheta = MeaNumericUtils::DegToRad(30.0)
+        * std::exp(-std::pow((hPrimeAve - MeaNumericUtils::DegToRad(275.0)) / MeaNumericUtils::DegToRad(25.0), 2.0));
+    double cPrimeAvePow7 = std::pow(cPrimeAve, 7.0);
+    double rc = 2.0 * std::sqrt(cPrimeAvePow7 / (cPrimeAvePow7 + pow25To7));
+    double sl = 1.0 + 0.015 * std::pow(lPrimeAve - 50.0, 2.0) / std::sqrt(20.0 + std::pow(lPrimeAve - 50.0, 2.0));
+    double sc = 1.0 + 0.045 * cPrimeAve;
+    double sh = 1.0 + 0.015 * cPrimeAve * t;
+    double rt = -std::sin(2.0 * deltaTheta) * rc;
+
+    return std::sqrt(std::pow(deltaLPrime / sl, 2.0) + std::pow(deltaCPrime / sc, 2.0)
+                     + std::pow(deltaHPrime / sh, 2.0) + rt * (deltaCPrime / sc) * (deltaHPrime / sh));
+}
+
+
 struct CMYTestData {
     int cyan;
     int magenta;
@@ -423,6 +555,57 @@ BOOST_DATA_TEST_CASE(TestRGBtoLab,
     BOOST_TEST(std::round(10000.0 * lab.b) / 10000.0 == colorData.b, tt::tolerance(DBL_EPSILON));
 }
 
+BOOST_AUTO_TEST_CASE(TestRGBtoLabConstexpr) {
+    constexpr MeaColors::Lab red = MeaColors::RGBtoLab(RGB(255, 0, 0));
+    static_assert(red.l > 53.2407 && red.l < 53.2409, "Compile time conversion of red");
+
+    auto check = [](COLORREF rgb, const MeaColors::Lab& lab) {
+        MeaColors::Lab expected = StdRGBtoLab(rgb);
+        return std::fabs(lab.l - expected.l) < 1e-9
+            && std::fabs(lab.a - expected.a) < 1e-9
+            && std::fabs(lab.b - expected.b) < 1e-9;
+    };
+
+    for (const MeaColors::ColorTableEntry* entry = MeaColors::GetBasicColors(); entry->name != nullptr; entry++) {
+        BOOST_TEST(check(entry->rgb, entry->lab), entry->name);
+    }
+    for (const MeaColors::ColorTableEntry* entry = MeaColors::GetExtendedColors(); entry->name != nullptr; entry++) {
+        BOOST_TEST(check(entry->rgb, entry->lab), entry->name);
+    }
+
+    for (int red = 0; red < 256; red += 3) {
+        for (int green = 0; green < 256; green += 3) {
+            for (int blue = 0; blue < 256; blue += 3) {
+                COLORREF rgb = RGB(red, green, blue);
+                if (!check(rgb, MeaColors::RGBtoLab(rgb))) {
+                    BOOST_FAIL("Lab mismatch for " << red << ',' << green << ',' << blue);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestLabtoRGB) {
+    for (int red = 0; red < 256; red += 5) {
+        for (int green = 0; green < 256; green += 5) {
+            for (int blue = 0; blue < 256; blue += 5) {
+                COLORREF rgb = RGB(red, green, blue);
+                if (MeaColors::LabtoRGB(MeaColors::RGBtoLab(rgb)) != rgb) {
+                    BOOST_FAIL("Lab round trip mismatch for " << red << ',' << green << ',' << blue);
+                }
+            }
+        }
+    }
+
+    // Out of gamut colors are clamped.
+    BOOST_TEST(MeaColors::LabtoRGB(MeaColors::Lab(100.0, 0.0, 0.0)) == RGB(255, 255, 255));
+    BOOST_TEST(MeaColors::LabtoRGB(MeaColors::Lab(0.0, 0.0, 0.0)) == RGB(0, 0, 0));
+    BOOST_TEST(MeaColors::LabtoRGB(MeaColors::Lab(120.0, 0.0, 0.0)) == RGB(255, 255, 255));
+    COLORREF saturated = MeaColors::LabtoRGB(MeaColors::Lab(50.0, 150.0, 0.0));
+    BOOST_TEST(GetRValue(saturated) == 255);
+    BOOST_TEST(GetGValue(saturated) == 0);
+}
+
 BOOST_AUTO_TEST_CASE(TestInterpolateColor) {
     COLORREF color = MeaColors::InterpolateColor(RGB(0, 0, 0), RGB(255, 255, 255), 50);
     BOOST_TEST(color == RGB(128, 128, 128));
@@ -507,6 +690,140 @@ BOOST_AUTO_TEST_CASE(TestMatchExtendedColor) {
     BOOST_TEST(MeaColors::MatchExtendedColor(RGB(70, 210, 200))->name == _T("mediumturquoise"));
 }
 
+BOOST_AUTO_TEST_CASE(TestMatchColorConcurrent) {
+    // Each thread matches its own stream of colors, revisiting a small set of colors so that the match caches are
+    // both hit and overwritten.
+    constexpr int numThreads = 8;
+    constexpr int numMatches = 20000;
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([t, &mismatches]() {
+            std::mt19937 rng(t);
+            std::uniform_int_distribution<int> component(0, 255);
+            std::vector<COLORREF> palette(300);
+            for (COLORREF& rgb : palette) {
+                rgb = RGB(component(rng), component(rng), component(rng));
+            }
+            std::uniform_int_distribution<std::size_t> pick(0, palette.size() - 1);
+
+            for (int i = 0; i < numMatches; i++) {
+                COLORREF rgb = palette[pick(rng)];
+                if (MeaColors::MatchBasicColor(rgb) != MeaColors::MatchColor(MeaColors::GetBasicColors(), rgb) ||
+                    MeaColors::MatchExtendedColor(rgb) != MeaColors::MatchColor(MeaColors::GetExtendedColors(), rgb)) {
+                    mismatches++;
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    BOOST_TEST(mismatches == 0);
+}
+
+BOOST_AUTO_TEST_CASE(TestColorDifferenceOptimized) {
+    std::mt19937 rng(2047);
+    std::uniform_real_distribution<double> lightness(0.0, 100.0);
+    std::uniform_real_distribution<double> chroma(-130.0, 130.0);
+    std::uniform_real_distribution<double> nearby(-3.0, 3.0);
+
+    for (int i = 0; i < 200000; i++) {
+        MeaColors::Lab lab1(lightness(rng), chroma(rng), chroma(rng));
+        MeaColors::Lab lab2 = ((i % 2) == 0)
+            ? MeaColors::Lab(lightness(rng), chroma(rng), chroma(rng))
+            : MeaColors::Lab(lab1.l + nearby(rng), lab1.a + nearby(rng), lab1.b + nearby(rng));
+
+        double expected = StdColorDifference(lab1, lab2);
+        BOOST_REQUIRE_SMALL(MeaColors::ColorDifference(lab1, lab2) - expected, 1e-9);
+        BOOST_REQUIRE_SMALL(MeaColors::ColorDifference(MeaColors::PrepareLab(lab1), MeaColors::PrepareLab(lab2))
+                            - expected, 1e-9);
+    }
+
+    // Colors on the achromatic axis and on the a* and b* axes, where the hue angles are special cases.
+    for (double l : { 0.0, 50.0, 100.0 }) {
+        for (double v : { -100.0, -1.0, 0.0, 1.0, 100.0 }) {
+            MeaColors::Lab onA(l, v, 0.0);
+            MeaColors::Lab onB(l, 0.0, v);
+            BOOST_TEST(MeaColors::ColorDifference(onA, onB) == StdColorDifference(onA, onB), tt::tolerance(1e-9));
+            BOOST_TEST(MeaColors::ColorDifference(onB, onA) == StdColorDifference(onB, onA), tt::tolerance(1e-9));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestPreparedLab) {
+    for (const MeaColors::ColorTableEntry* table : { MeaColors::GetBasicColors(), MeaColors::GetExtendedColors() }) {
+        for (const MeaColors::ColorTableEntry* entry = table; entry->name != nullptr; entry++) {
+            MeaColors::PreparedLab prepared = MeaColors::PrepareLab(entry->lab);
+            BOOST_TEST(entry->prepared.bSquared == prepared.bSquared);
+            BOOST_TEST(entry->prepared.chroma == prepared.chroma, tt::tolerance(1e-12));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestColorDifferenceLowerBound) {
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> lightness(0.0, 100.0);
+    std::uniform_real_distribution<double> chroma(-130.0, 130.0);
+    std::uniform_real_distribution<double> nearby(-2.0, 2.0);
+
+    for (int i = 0; i < 200000; i++) {
+        MeaColors::Lab lab1(lightness(rng), chroma(rng), chroma(rng));
+        MeaColors::Lab lab2 = ((i % 2) == 0)
+            ? MeaColors::Lab(lightness(rng), chroma(rng), chroma(rng))
+            : MeaColors::Lab(lab1.l + nearby(rng), lab1.a + nearby(rng), lab1.b + nearby(rng));
+
+        double bound = MeaColors::ColorDifferenceLowerBound(lab1, lab2);
+        BOOST_REQUIRE(bound >= 0.0);
+        BOOST_REQUIRE(bound <= MeaColors::ColorDifference(lab1, lab2));
+    }
+
+    // Identical and achromatic colors
+    MeaColors::Lab gray(50.0, 0.0, 0.0);
+    BOOST_TEST(MeaColors::ColorDifferenceLowerBound(gray, gray) == 0.0);
+    BOOST_TEST(MeaColors::ColorDifferenceLowerBound(gray, MeaColors::Lab(60.0, 0.0, 0.0)) <=
+               MeaColors::ColorDifference(gray, MeaColors::Lab(60.0, 0.0, 0.0)));
+}
+
+BOOST_AUTO_TEST_CASE(TestMatchColorSameAsLinear) {
+    const MeaColors::ColorTableEntry emptyTable[] = { { nullptr, 0, MeaColors::Lab() } };
+    BOOST_TEST(MeaColors::MatchColor(emptyTable, RGB(1, 2, 3)) == nullptr);
+
+    // Every table color and its immediate neighbors.
+    for (const MeaColors::ColorTableEntry* table : { MeaColors::GetBasicColors(), MeaColors::GetExtendedColors() }) {
+        for (const MeaColors::ColorTableEntry* entry = table; entry->name != nullptr; entry++) {
+            BOOST_TEST(CheckMatchColor(entry->rgb));
+            for (int delta : { -1, 1 }) {
+                int r = std::clamp(GetRValue(entry->rgb) + delta, 0, 255);
+                int g = std::clamp(GetGValue(entry->rgb) + delta, 0, 255);
+                int b = std::clamp(GetBValue(entry->rgb) + delta, 0, 255);
+                BOOST_TEST(CheckMatchColor(RGB(r, g, b)));
+            }
+        }
+    }
+
+    // A coarse grid over the RGB cube.
+    for (int r = 0; r < 256; r += 15) {
+        for (int g = 0; g < 256; g += 15) {
+            for (int b = 0; b < 256; b += 15) {
+                BOOST_TEST_REQUIRE(CheckMatchColor(RGB(r, g, b)), "RGB(" << r << ", " << g << ", " << b << ")");
+            }
+        }
+    }
+}
+
+/// Compares MatchColor to the linear search over all 2^24 colors. This takes several minutes, so it is disabled by
+/// default. Run it with --run_test=TestMatchColorExhaustive.
+///
+BOOST_AUTO_TEST_CASE(TestMatchColorExhaustive, *bt::disabled()) {
+    for (COLORREF rgb = 0; rgb < 0x1000000; rgb++) {
+        BOOST_TEST_REQUIRE(CheckMatchColor(rgb), "rgb = " << rgb);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(TestColorItem) {
     MeaColors::Set(MeaColors::LineFore, RGB(10, 20, 30));
     BOOST_TEST(MeaColors::Get(MeaColors::LineFore) == RGB(10, 20, 30));
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE CrossHairShapeTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/CrossHairShape.h>
+#include <meazure/graphics/Plotter.h>
+#include <vector>
+
+
+namespace {
+    std::vector<POINT> Plot(const SIZE& size, const SIZE& spread, int layers) {
+        std::vector<POINT> points;
+        MeaPlotter::PlotCrosshair(size, spread, layers, [&](int x, int y) { points.push_back({ x, y }); });
+        return points;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestShape) {
+    SIZE size { 25, 25 };
+    SIZE spread { 4, 4 };
+
+    MeaCrossHairShape shape(size, spread, 5);
+    std::vector<POINT> expected = Plot(size, spread, 5);
+
+    BOOST_REQUIRE_EQUAL(shape.GetPolyCount(), 20);
+    for (int i = 0; i < shape.GetPolyCount(); i++) {
+        BOOST_CHECK_EQUAL(shape.GetPolyCounts()[i], 4);
+    }
+    for (size_t i = 0; i < expected.size(); i++) {
+        BOOST_CHECK_EQUAL(shape.GetPoints()[i].x, expected[i].x);
+        BOOST_CHECK_EQUAL(shape.GetPoints()[i].y, expected[i].y);
+    }
+
+    BOOST_CHECK(shape.IsShape(size, spread, 5));
+    BOOST_CHECK(!shape.IsShape(size, spread, 4));
+    BOOST_CHECK(!shape.IsShape(size, { 4, 2 }, 5));
+    BOOST_CHECK(!shape.IsShape({ 25, 27 }, spread, 5));
+}
+
+BOOST_AUTO_TEST_CASE(TestShortSpread) {
+    // The petals stop once the spread runs out, so there are fewer polygons than layers.
+    MeaCrossHairShape shape({ 25, 25 }, { 2, 2 }, 5);
+
+    BOOST_CHECK_EQUAL(shape.GetPolyCount(), 12);
+    BOOST_CHECK_EQUAL(Plot({ 25, 25 }, { 2, 2 }, 5).size(), 48U);
+}
+
+BOOST_AUTO_TEST_CASE(TestGetShared) {
+    unsigned int plots = MeaCrossHairShape::GetPlotCount();
+
+    const MeaCrossHairShape& shape1 = MeaCrossHairShape::Get({ 25, 25 }, { 4, 4 }, 5);
+    const MeaCrossHairShape& shape2 = MeaCrossHairShape::Get({ 25, 25 }, { 4, 4 }, 5);
+    BOOST_CHECK_EQUAL(&shape1, &shape2);
+    BOOST_CHECK_EQUAL(MeaCrossHairShape::GetPlotCount(), plots + 1);
+
+    // A different geometry (e.g. a different DPI scale) gets its own shape, and the first remains valid.
+    const MeaCrossHairShape& shape3 = MeaCrossHairShape::Get({ 37, 37 }, { 6, 6 }, 5);
+    BOOST_CHECK_NE(&shape1, &shape3);
+    BOOST_CHECK_EQUAL(MeaCrossHairShape::GetPlotCount(), plots + 2);
+    BOOST_CHECK(shape1.IsShape({ 25, 25 }, { 4, 4 }, 5));
+    BOOST_CHECK(shape3.IsShape({ 37, 37 }, { 6, 6 }, 5));
+
+    BOOST_CHECK_EQUAL(&MeaCrossHairShape::Get({ 25, 25 }, { 4, 4 }, 5), &shape1);
+    BOOST_CHECK_EQUAL(MeaCrossHairShape::GetPlotCount(), plots + 2);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE FieldTextCacheTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/FieldTextCache.h>
+
+
+namespace {
+    /// Formats values the way the units do and counts the number of times it is called.
+    ///
+    struct CountingFormatter {
+        int count = 0;
+
+        CString Format(double value, int precision) {
+            count++;
+            CString str;
+            str.Format(_T("%0.*f"), precision, value);
+            return str;
+        }
+    };
+}
+
+
+BOOST_AUTO_TEST_CASE(TestSameValueSkipped) {
+    MeaFieldTextCache cache;
+    CountingFormatter formatter;
+    auto format = [&formatter](double value, int precision) {
+        return [&formatter, value, precision]() { return formatter.Format(value, precision); };
+    };
+
+    BOOST_CHECK(cache.Update(1.5, 2, format(1.5, 2)));
+    BOOST_CHECK_EQUAL(CString(_T("1.50")), cache.GetText());
+    BOOST_CHECK_EQUAL(1, formatter.count);
+
+    BOOST_CHECK(!cache.Update(1.5, 2, format(1.5, 2)));
+    BOOST_CHECK_EQUAL(1, formatter.count);
+
+    BOOST_CHECK(cache.Update(1.5, 3, format(1.5, 3)));
+    BOOST_CHECK_EQUAL(CString(_T("1.500")), cache.GetText());
+    BOOST_CHECK_EQUAL(2, formatter.count);
+
+    BOOST_CHECK(cache.Update(2.0, 3, format(2.0, 3)));
+    BOOST_CHECK_EQUAL(CString(_T("2.000")), cache.GetText());
+    BOOST_CHECK_EQUAL(3, formatter.count);
+
+    const MeaFieldTextCache::Stats& stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(4U, stats.updates);
+    BOOST_CHECK_EQUAL(1U, stats.formatsSkipped);
+    BOOST_CHECK_EQUAL(1U, stats.textsSkipped);
+}
+
+BOOST_AUTO_TEST_CASE(TestSameTextSkipped) {
+    MeaFieldTextCache cache;
+    CountingFormatter formatter;
+
+    BOOST_CHECK(cache.Update(1.001, 1, [&formatter]() { return formatter.Format(1.001, 1); }));
+    BOOST_CHECK(!cache.Update(1.002, 1, [&formatter]() { return formatter.Format(1.002, 1); }));
+    BOOST_CHECK_EQUAL(2, formatter.count);
+    BOOST_CHECK_EQUAL(CString(_T("1.0")), cache.GetText());
+
+    const MeaFieldTextCache::Stats& stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(2U, stats.updates);
+    BOOST_CHECK_EQUAL(0U, stats.formatsSkipped);
+    BOOST_CHECK_EQUAL(1U, stats.textsSkipped);
+}
+
+BOOST_AUTO_TEST_CASE(TestTextUpdate) {
+    MeaFieldTextCache cache;
+    CountingFormatter formatter;
+    auto format = [&formatter]() { return formatter.Format(3.0, 0); };
+
+    BOOST_CHECK(cache.Update(3.0, 0, format));
+    BOOST_CHECK(cache.Update(CString()));
+    BOOST_CHECK(cache.GetText().IsEmpty());
+    BOOST_CHECK(!cache.Update(CString()));
+
+    // Clearing the field forgets the value so showing it again must restore the text.
+    BOOST_CHECK(cache.Update(3.0, 0, format));
+    BOOST_CHECK_EQUAL(CString(_T("3")), cache.GetText());
+    BOOST_CHECK_EQUAL(2, formatter.count);
+}
+
+BOOST_AUTO_TEST_CASE(TestInvalidate) {
+    MeaFieldTextCache cache;
+    CountingFormatter formatter;
+    auto format = [&formatter]() { return formatter.Format(4.25, 2); };
+
+    BOOST_CHECK(cache.Update(4.25, 2, format));
+    cache.Invalidate();
+    BOOST_CHECK(cache.Update(4.25, 2, format));
+    BOOST_CHECK_EQUAL(2, formatter.count);
+    BOOST_CHECK(!cache.Update(4.25, 2, format));
+    BOOST_CHECK_EQUAL(2, formatter.count);
+}
@@ -355,6 +355,52 @@ BOOST_DATA_TEST_CASE(TestCalcSector,
     BOOST_TEST(MeaGeometry::IsVerticallyOriented(p0, p1) == sectorData.isVertical);
 }
 
+// Exact diagonals and axis-aligned vectors are the boundary cases for the sector classification.
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { 1, 2 }) == 0, "Zero vector");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { 5, 2 }) == 1, "0 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { 5, 6 }) == 2, "45 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { 1, 6 }) == 3, "90 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { -3, 6 }) == 4, "135 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { -3, 2 }) == -4, "180 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { -3, -2 }) == -4, "225 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { 1, -2 }) == -3, "270 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 1, 2 }, POINT { 5, -2 }) == -2, "315 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { 1000000, 999999 }) == 1, "Just below 45 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { 999999, 1000000 }) == 2, "Just above 45 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { -999999, 1000000 }) == 3, "Just below 135 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { -1000000, 999999 }) == 4, "Just above 135 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { -1000000, -999999 }) == -4, "Just below 225 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { -999999, -1000000 }) == -3, "Just above 225 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { 999999, -1000000 }) == -2, "Just below 315 degrees");
+static_assert(MeaGeometry::CalcSector(POINT { 0, 0 }, POINT { 1000000, -999999 }) == -1, "Just above 315 degrees");
+static_assert(MeaGeometry::IsHorizontallyOriented(POINT { 0, 0 }, POINT { -7, 7 }), "135 degrees is horizontal");
+static_assert(MeaGeometry::IsVerticallyOriented(POINT { 0, 0 }, POINT { 7, 7 }), "45 degrees is vertical");
+
+BOOST_AUTO_TEST_CASE(TestCalcSectorMatchesAngle) {
+    // The sector must match the one obtained by dividing the angle of the vector into 45 degree sectors.
+    auto angleSector = [](int deltax, int deltay) {
+        if (deltax == 0 && deltay == 0) {
+            return 0;
+        }
+        if (deltax == 0) {
+            return (deltay < 0) ? -3 : 3;
+        }
+        if (deltay == 0) {
+            return (deltax < 0) ? -4 : 1;
+        }
+        double result = atan2(static_cast<double>(deltay), static_cast<double>(deltax)) / MeaNumericUtils::PI4;
+        return static_cast<int>(result + std::copysign(1.0, result));
+    };
+
+    POINT p0 { 1, 2 };
+    for (int x = -100; x <= 100; x++) {
+        for (int y = -100; y <= 100; y++) {
+            POINT p1 { p0.x + x, p0.y + y };
+            BOOST_TEST(MeaGeometry::CalcSector(p0, p1) == angleSector(x, y), "vector (" << x << ',' << y << ')');
+        }
+    }
+}
+
 
 struct AngleTestData {
     double x;
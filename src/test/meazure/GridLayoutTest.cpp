@@ -0,0 +1,163 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE GridLayoutTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/GridLayout.h>
+#include <vector>
+
+
+namespace {
+    /// Rasterizes the grid lines over a screen the way the grid was drawn with a window per line, i.e.
+    /// one pixel thick lines every spacing pixels from the virtual screen top left corner, up to and
+    /// including its bottom and right edges.
+    ///
+    std::vector<bool> ExpectedPixels(const RECT& virtualRect, const SIZE& spacing, const RECT& screenRect) {
+        const int width = screenRect.right - screenRect.left;
+        const int height = screenRect.bottom - screenRect.top;
+        std::vector<bool> pixels(static_cast<size_t>(width * height), false);
+
+        for (int y = screenRect.top; y < screenRect.bottom; y++) {
+            for (int x = screenRect.left; x < screenRect.right; x++) {
+                bool row = (y - virtualRect.top) % spacing.cy == 0 && y <= virtualRect.bottom;
+                bool column = (x - virtualRect.left) % spacing.cx == 0 && x <= virtualRect.right;
+                pixels[static_cast<size_t>((y - screenRect.top) * width + (x - screenRect.left))] = row || column;
+            }
+        }
+        return pixels;
+    }
+
+    /// Verifies that the rectangles are in the banded form required by ExtCreateRegion and exactly
+    /// cover the expected grid pixels.
+    ///
+    void CheckRects(const RECT& virtualRect, const SIZE& spacing, const RECT& screenRect) {
+        std::vector<RECT> rects;
+        MeaGridLayout::CalcRects(virtualRect, spacing, screenRect, rects);
+
+        const int width = screenRect.right - screenRect.left;
+        const int height = screenRect.bottom - screenRect.top;
+        std::vector<int> coverage(static_cast<size_t>(width * height), 0);
+
+        for (size_t i = 0; i < rects.size(); i++) {
+            const RECT& r = rects[i];
+            BOOST_REQUIRE(r.left >= 0 && r.left < r.right && r.right <= width);
+            BOOST_REQUIRE(r.top >= 0 && r.top < r.bottom && r.bottom <= height);
+
+            if (i > 0) {
+                const RECT& prev = rects[i - 1];
+                if (prev.top == r.top) {
+                    BOOST_CHECK_EQUAL(prev.bottom, r.bottom);
+                    BOOST_CHECK(prev.right <= r.left);
+                } else {
+                    BOOST_CHECK(prev.bottom <= r.top);
+                }
+            }
+
+            for (LONG y = r.top; y < r.bottom; y++) {
+                for (LONG x = r.left; x < r.right; x++) {
+                    coverage[static_cast<size_t>(y * width + x)]++;
+                }
+            }
+        }
+
+        std::vector<bool> expected = ExpectedPixels(virtualRect, spacing, screenRect);
+        for (size_t i = 0; i < coverage.size(); i++) {
+            BOOST_REQUIRE_EQUAL(coverage[i], expected[i] ? 1 : 0);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestCalcLines) {
+    std::vector<int> lines { 99 };
+
+    MeaGridLayout::CalcLines(0, 100, 25, 0, 101, lines);
+    BOOST_CHECK_EQUAL(lines.size(), 5U);
+    BOOST_CHECK_EQUAL(lines[0], 0);
+    BOOST_CHECK_EQUAL(lines[4], 100);
+
+    // A line on the limit that is outside the span is dropped.
+    MeaGridLayout::CalcLines(0, 100, 25, 0, 100, lines);
+    BOOST_CHECK_EQUAL(lines.size(), 4U);
+    BOOST_CHECK_EQUAL(lines[3], 75);
+
+    // Positions are relative to the start of the span.
+    MeaGridLayout::CalcLines(0, 1000, 25, 60, 130, lines);
+    BOOST_REQUIRE_EQUAL(lines.size(), 3U);
+    BOOST_CHECK_EQUAL(lines[0], 15);
+    BOOST_CHECK_EQUAL(lines[1], 40);
+    BOOST_CHECK_EQUAL(lines[2], 65);
+
+    // Span starting exactly on a line.
+    MeaGridLayout::CalcLines(-100, 1000, 50, 0, 10, lines);
+    BOOST_REQUIRE_EQUAL(lines.size(), 1U);
+    BOOST_CHECK_EQUAL(lines[0], 0);
+
+    // Span starting before the origin.
+    MeaGridLayout::CalcLines(20, 1000, 50, 0, 100, lines);
+    BOOST_REQUIRE_EQUAL(lines.size(), 2U);
+    BOOST_CHECK_EQUAL(lines[0], 20);
+    BOOST_CHECK_EQUAL(lines[1], 70);
+
+    // Span past the limit.
+    MeaGridLayout::CalcLines(0, 100, 10, 200, 300, lines);
+    BOOST_CHECK(lines.empty());
+}
+
+BOOST_AUTO_TEST_CASE(TestCalcRectsSingleScreen) {
+    RECT screen { 0, 0, 200, 150 };
+    CheckRects(screen, { 10, 10 }, screen);
+    CheckRects(screen, { 50, 30 }, screen);
+    CheckRects(screen, { 37, 23 }, screen);
+    CheckRects(screen, { 4000, 4000 }, screen);
+
+    std::vector<RECT> rects;
+    MeaGridLayout::CalcRects(screen, { 50, 50 }, screen, rects);
+    // 3 horizontal lines, and 4 vertical lines in each of 3 bands between them.
+    BOOST_CHECK_EQUAL(rects.size(), 3U + 3U * 4U);
+}
+
+BOOST_AUTO_TEST_CASE(TestCalcRectsMultipleScreens) {
+    // Secondary screen to the left of and lower than the primary screen.
+    RECT virtualRect { -170, 0, 200, 190 };
+    RECT primary { 0, 0, 200, 150 };
+    RECT secondary { -170, 40, 0, 190 };
+
+    CheckRects(virtualRect, { 10, 10 }, primary);
+    CheckRects(virtualRect, { 10, 10 }, secondary);
+    CheckRects(virtualRect, { 33, 17 }, primary);
+    CheckRects(virtualRect, { 33, 17 }, secondary);
+    CheckRects(virtualRect, { 300, 300 }, secondary);
+}
+
+BOOST_AUTO_TEST_CASE(TestCalcRectsReplacesContents) {
+    RECT screen { 0, 0, 100, 100 };
+    std::vector<RECT> rects(5, RECT { 1, 2, 3, 4 });
+
+    MeaGridLayout::CalcRects(screen, { 100, 100 }, screen, rects);
+    BOOST_REQUIRE_EQUAL(rects.size(), 2U);
+    BOOST_CHECK_EQUAL(rects[0].left, 0);
+    BOOST_CHECK_EQUAL(rects[0].right, 100);
+    BOOST_CHECK_EQUAL(rects[0].bottom, 1);
+    BOOST_CHECK_EQUAL(rects[1].left, 0);
+    BOOST_CHECK_EQUAL(rects[1].top, 1);
+    BOOST_CHECK_EQUAL(rects[1].bottom, 100);
+}
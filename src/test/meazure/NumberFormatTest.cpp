@@ -0,0 +1,132 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE NumberFormatTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/NumberFormat.h>
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+namespace {
+    /// Formats the value using the C library as the reference for the expected result.
+    ///
+    CString Printf(double value, int precision) {
+        CString str;
+        str.Format(_T("%0.*f"), precision, value);
+        return str;
+    }
+
+    /// Tests that the value is formatted identically to printf for precisions 0 through 6.
+    ///
+    void CheckAllPrecisions(double value) {
+        for (int precision = 0; precision <= 6; precision++) {
+            MeaNumberString str = MeaNumberFormat::FormatFixed(value, precision);
+            CString expected = Printf(value, precision);
+
+            BOOST_TEST_INFO("value: " << value << " precision: " << precision);
+            BOOST_TEST(CString(str.GetString()) == expected);
+            BOOST_TEST(str.GetLength() == expected.GetLength());
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestSimpleValues) {
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(0.0, 0)) == _T("0"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(0.0, 2)) == _T("0.00"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(1.0, 1)) == _T("1.0"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(123.456, 2)) == _T("123.46"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(-123.456, 1)) == _T("-123.5"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(0.05, 3)) == _T("0.050"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(9.9999, 2)) == _T("10.00"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(1920.0, 0)) == _T("1920"));
+}
+
+BOOST_AUTO_TEST_CASE(TestSigns) {
+    CheckAllPrecisions(-0.0);
+    CheckAllPrecisions(-0.0001);
+    CheckAllPrecisions(-0.4);
+    CheckAllPrecisions(-0.5);
+    CheckAllPrecisions(-1.5);
+    CheckAllPrecisions(-1000000.25);
+}
+
+BOOST_AUTO_TEST_CASE(TestTies) {
+    // Values exactly halfway between two outputs round to even.
+    for (int i = -4096; i <= 4096; i++) {
+        CheckAllPrecisions(i / 2.0);
+        CheckAllPrecisions(i / 8.0);
+        CheckAllPrecisions(i / 64.0);
+    }
+    CheckAllPrecisions(0.5);
+    CheckAllPrecisions(2.5);
+    CheckAllPrecisions(0.125);
+    CheckAllPrecisions(0.375);
+    CheckAllPrecisions(1.0 / 1024.0);
+}
+
+BOOST_AUTO_TEST_CASE(TestNearTies) {
+    // Decimal ties that are not exactly representable and whose scaled
+    // product rounds onto or across the halfway point.
+    const double values[] = {
+        0.05, 0.15, 0.25, 0.35, 1.005, 1.015, 1.025, 2.675, 1.0005, 1.00005, 1.000005, 0.0000005, 8.345,
+        1234.5675, 4.35, 0.285, 1.45, 5.015, 10.005, 999999.5, 7.0000005
+    };
+    for (double value : values) {
+        CheckAllPrecisions(value);
+        CheckAllPrecisions(-value);
+        CheckAllPrecisions(std::nextafter(value, 0.0));
+        CheckAllPrecisions(std::nextafter(value, 1e300));
+    }
+
+    for (int i = 0; i < 100000; i++) {
+        CheckAllPrecisions(i / 1000.0 + 0.0005);
+        CheckAllPrecisions(i / 100.0 + 0.005);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRandomValues) {
+    std::mt19937_64 generator(20240601);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-8, 9);
+
+    for (int i = 0; i < 200000; i++) {
+        CheckAllPrecisions(mantissa(generator) * std::pow(10.0, exponent(generator)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestOverflow) {
+    // Values that cannot be scaled exactly are formatted by the C library.
+    CheckAllPrecisions(9007199254740992.0);
+    CheckAllPrecisions(1.0e20);
+    CheckAllPrecisions(-1.0e300);
+    CheckAllPrecisions(std::numeric_limits<double>::max());
+    CheckAllPrecisions(std::numeric_limits<double>::infinity());
+    CheckAllPrecisions(-std::numeric_limits<double>::infinity());
+    CheckAllPrecisions(std::numeric_limits<double>::quiet_NaN());
+    CheckAllPrecisions(9007199254.740991);
+
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(1.0e20, 0)) == _T("100000000000000000000"));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(1.5, 12)) == Printf(1.5, 12));
+    BOOST_TEST(CString(MeaNumberFormat::FormatFixed(1.5, -1)) == Printf(1.5, -1));
+}
@@ -23,6 +23,8 @@
 #include <boost/test/unit_test.hpp>
 #include <meazure/utilities/NumericUtils.h>
 #include <float.h>
+#include <cmath>
+#include <limits>
 
 namespace bt = boost::unit_test;
 
@@ -66,3 +68,31 @@ BOOST_AUTO_TEST_CASE(TestRadToDeg, *bt::tolerance(DBL_EPSILON)) {
     BOOST_TEST(MeaNumericUtils::RadToDeg(2.0 * MeaNumericUtils::PI) == 360.0);
     BOOST_TEST(MeaNumericUtils::RadToDeg(2.1816615649929116) == 125.0);
 }
+
+BOOST_AUTO_TEST_CASE(TestIntPow, *bt::tolerance(DBL_EPSILON)) {
+    static_assert(MeaNumericUtils::IntPow(2.0, 10) == 1024.0, "Compile time power");
+
+    BOOST_TEST(MeaNumericUtils::IntPow(3.0, 0) == 1.0);
+    BOOST_TEST(MeaNumericUtils::IntPow(3.0, 1) == 3.0);
+    BOOST_TEST(MeaNumericUtils::IntPow(-2.0, 3) == -8.0);
+    BOOST_TEST(MeaNumericUtils::IntPow(0.5, 4) == 0.0625);
+}
+
+BOOST_AUTO_TEST_CASE(TestNthRoot, *bt::tolerance(4.0 * DBL_EPSILON)) {
+    static_assert(MeaNumericUtils::NthRoot(1.0, 3) == 1.0, "Compile time root");
+
+    BOOST_TEST(MeaNumericUtils::NthRoot(0.0, 3) == 0.0);
+    BOOST_TEST(MeaNumericUtils::NthRoot(-1.0, 3) == 0.0);
+    BOOST_TEST(MeaNumericUtils::NthRoot(27.0, 3) == 3.0);
+    BOOST_TEST(MeaNumericUtils::NthRoot(0.03125, 5) == 0.5);
+    BOOST_TEST(MeaNumericUtils::NthRoot(1e300, 3) == 1e100);
+    BOOST_TEST(MeaNumericUtils::NthRoot(DBL_MAX, 2) == std::sqrt(DBL_MAX));
+    BOOST_TEST(std::isinf(MeaNumericUtils::NthRoot(std::numeric_limits<double>::infinity(), 3)));
+    BOOST_TEST(std::isnan(MeaNumericUtils::NthRoot(std::numeric_limits<double>::quiet_NaN(), 3)));
+
+    for (double value = 0.0001; value < 2.0; value *= 1.1) {
+        BOOST_TEST(MeaNumericUtils::NthRoot(value, 2) == std::sqrt(value));
+        BOOST_TEST(MeaNumericUtils::NthRoot(value, 3) == std::cbrt(value));
+        BOOST_TEST(MeaNumericUtils::NthRoot(value, 5) == std::pow(value, 0.2));
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE OpacityTileTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/OpacityTile.h>
+#include <vector>
+
+
+namespace {
+    /// Determines the color of a pixel in the dot pattern the way it was drawn one dot at a time: a dot every
+    /// three dot sizes starting at the origin.
+    ///
+    uint32_t PatternPixel(const SIZE& dotSize, int x, int y) {
+        bool inDot = (x % (3 * dotSize.cx)) < dotSize.cx && (y % (3 * dotSize.cy)) < dotSize.cy;
+        return inDot ? MeaOpacityTile::kDotColor : MeaOpacityTile::kBackColor;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestTileSize) {
+    SIZE size = MeaOpacityTile::GetTileSize({ 3, 4 });
+    BOOST_CHECK_EQUAL(size.cx, 9);
+    BOOST_CHECK_EQUAL(size.cy, 12);
+
+    size = MeaOpacityTile::GetTileSize({ 0, -2 });
+    BOOST_CHECK_EQUAL(size.cx, 3);
+    BOOST_CHECK_EQUAL(size.cy, 3);
+}
+
+BOOST_AUTO_TEST_CASE(TestRender) {
+    for (SIZE dotSize : { SIZE { 1, 1 }, SIZE { 3, 3 }, SIZE { 4, 6 }, SIZE { 7, 2 } }) {
+        std::vector<uint32_t> tile(5, 0x12345678);
+        MeaOpacityTile::Render(dotSize, tile);
+
+        SIZE tileSize = MeaOpacityTile::GetTileSize(dotSize);
+        BOOST_REQUIRE_EQUAL(tile.size(), static_cast<size_t>(tileSize.cx * tileSize.cy));
+
+        // Repeating the tile over an area reproduces the dot pattern.
+        for (int y = 0; y < 5 * tileSize.cy; y++) {
+            for (int x = 0; x < 5 * tileSize.cx; x++) {
+                uint32_t tilePixel = tile[static_cast<size_t>((y % tileSize.cy) * tileSize.cx + (x % tileSize.cx))];
+                BOOST_REQUIRE_EQUAL(tilePixel, PatternPixel(dotSize, x, y));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestDotCount) {
+    std::vector<uint32_t> tile;
+    MeaOpacityTile::Render({ 3, 3 }, tile);
+
+    size_t dots = 0;
+    for (uint32_t pixel : tile) {
+        dots += (pixel == MeaOpacityTile::kDotColor) ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(dots, 9U);
+    BOOST_CHECK_EQUAL(tile.front(), MeaOpacityTile::kDotColor);
+    BOOST_CHECK_EQUAL(tile.back(), MeaOpacityTile::kBackColor);
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE PixelZoomTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/graphics/PixelZoom.h>
+#include <vector>
+
+
+namespace {
+    constexpr uint32_t kGrid = 0x00808080;
+    constexpr uint32_t kFill = 0xDEADBEEF;
+
+    /// Pixel storage with a stride wider than the image, to catch writes outside of the image.
+    ///
+    struct Image {
+        Image(int width, int height, int padding = 3) :
+            pixels(static_cast<size_t>((width + padding) * height), kFill),
+            buffer { pixels.data(), width, height, width + padding } {}
+
+        uint32_t At(int x, int y) const { return pixels[static_cast<size_t>(y * buffer.stride + x)]; }
+
+        std::vector<uint32_t> pixels;
+        MeaPixelBuffer buffer;
+    };
+
+    /// Creates a source image in which every pixel is distinct.
+    ///
+    Image MakeSource(int width, int height) {
+        Image image(width, height);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                image.pixels[static_cast<size_t>(y * image.buffer.stride + x)] = 0x00010000 * (y + 1) + (x + 1);
+            }
+        }
+        return image;
+    }
+
+    int FloorDiv(int a, int b) {
+        int q = a / b;
+        return (a % b != 0 && a < 0) ? q - 1 : q;
+    }
+
+    /// Straightforward per pixel implementation of the zoom used as the reference.
+    ///
+    uint32_t Reference(const Image& src, int x, int y, int factor, int offsetX, int offsetY, bool showGrid) {
+        int rx = x - offsetX;
+        int ry = y - offsetY;
+        if (showGrid && (rx - FloorDiv(rx, factor) * factor == 0 || ry - FloorDiv(ry, factor) * factor == 0)) {
+            return kGrid;
+        }
+        int sx = FloorDiv(rx, factor);
+        int sy = FloorDiv(ry, factor);
+        if (sx < 0 || sy < 0 || sx >= src.buffer.width || sy >= src.buffer.height) {
+            return MeaPixelZoom::kBlack;
+        }
+        return src.At(sx, sy);
+    }
+
+    /// Zooms the source and compares every destination pixel with the reference. The padding to the right of
+    /// each destination row must not be touched.
+    ///
+    void CheckZoom(const Image& src, int dstWidth, int dstHeight, int factor, int offsetX, int offsetY,
+                   bool showGrid) {
+        Image dst(dstWidth, dstHeight);
+        MeaPixelZoom::Zoom(src.buffer, dst.buffer, factor, offsetX, offsetY, showGrid, kGrid);
+
+        int mismatches = 0;
+        for (int y = 0; y < dstHeight; y++) {
+            for (int x = 0; x < dst.buffer.stride; x++) {
+                uint32_t expected = (x < dstWidth) ? Reference(src, x, y, factor, offsetX, offsetY, showGrid) : kFill;
+                if (dst.At(x, y) != expected) {
+                    mismatches++;
+                }
+            }
+        }
+
+        BOOST_TEST_INFO("factor: " << factor << " offset: " << offsetX << "," << offsetY << " dst: " << dstWidth
+                        << "x" << dstHeight << " grid: " << showGrid);
+        BOOST_TEST(mismatches == 0);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestGoldenImage) {
+    Image src = MakeSource(2, 2);
+    Image dst(7, 5);
+
+    // Source pixel 0 starts one pixel left of and above the destination, so the first cells are clipped.
+    MeaPixelZoom::Zoom(src.buffer, dst.buffer, 3, -1, -1, false);
+
+    const uint32_t a = 0x00010001, b = 0x00010002, c = 0x00020001, d = 0x00020002, k = MeaPixelZoom::kBlack;
+    const uint32_t expected[5][7] = {
+        { a, a, b, b, b, k, k },
+        { a, a, b, b, b, k, k },
+        { c, c, d, d, d, k, k },
+        { c, c, d, d, d, k, k },
+        { c, c, d, d, d, k, k },
+    };
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 7; x++) {
+            BOOST_TEST_INFO("x: " << x << " y: " << y);
+            BOOST_TEST(dst.At(x, y) == expected[y][x]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestGoldenGridImage) {
+    Image src = MakeSource(2, 1);
+    Image dst(8, 5);
+
+    MeaPixelZoom::Zoom(src.buffer, dst.buffer, 3, 1, 1, true, kGrid);
+
+    const uint32_t a = 0x00010001, b = 0x00010002, g = kGrid, k = MeaPixelZoom::kBlack;
+    const uint32_t expected[5][8] = {
+        { k, g, k, k, g, k, k, g },
+        { g, g, g, g, g, g, g, g },
+        { k, g, a, a, g, b, b, g },
+        { k, g, a, a, g, b, b, g },
+        { g, g, g, g, g, g, g, g },
+    };
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 8; x++) {
+            BOOST_TEST_INFO("x: " << x << " y: " << y);
+            BOOST_TEST(dst.At(x, y) == expected[y][x]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestMagnifierFactors) {
+    const int factors[] = { 1, 2, 3, 4, 5, 6, 8, 16, 32 };
+    const int offsets[] = { -37, -31, -5, -1, 0, 1, 3, 20 };
+    Image src = MakeSource(19, 13);
+
+    for (int factor : factors) {
+        for (int offset : offsets) {
+            CheckZoom(src, 101, 37, factor, offset, -offset, false);
+            CheckZoom(src, 101, 37, factor, offset, offset / 2, true);
+            CheckZoom(src, 7, 9, factor, offset, offset, false);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestEdgeCases) {
+    Image src = MakeSource(5, 4);
+
+    // Zoomed image entirely outside of the destination.
+    CheckZoom(src, 16, 16, 4, 100, 0, false);
+    CheckZoom(src, 16, 16, 4, -100, 0, true);
+    CheckZoom(src, 16, 16, 4, 0, 100, false);
+    CheckZoom(src, 16, 16, 4, 0, -100, false);
+
+    // Single source pixel and tiny destinations.
+    Image one = MakeSource(1, 1);
+    CheckZoom(one, 1, 1, 1, 0, 0, false);
+    CheckZoom(one, 1, 1, 32, -16, -16, false);
+    CheckZoom(one, 3, 2, 2, 1, 0, true);
+}
+
+BOOST_AUTO_TEST_CASE(TestCenterLayout) {
+    const int factors[] = { 1, 2, 3, 4, 6, 8, 16, 32 };
+    const int sizes[] = { 1, 2, 15, 100, 101, 203, 256 };
+
+    for (int factor : factors) {
+        for (int size : sizes) {
+            MeaPixelZoom::Layout layout = MeaPixelZoom::CenterLayout(size, size + 1, factor);
+
+            BOOST_TEST_INFO("factor: " << factor << " size: " << size);
+
+            // The center cell is centered.
+            BOOST_TEST(layout.cellX == FloorDiv(size - factor, 2));
+            BOOST_TEST(layout.cellY == FloorDiv(size + 1 - factor, 2));
+            BOOST_TEST(layout.cellX == layout.offsetX + layout.centerX * factor);
+            BOOST_TEST(layout.cellY == layout.offsetY + layout.centerY * factor);
+
+            // The source covers the destination with no more than a partial cell to spare at each edge.
+            BOOST_TEST(layout.offsetX <= 0);
+            BOOST_TEST(layout.offsetX > -factor);
+            BOOST_TEST(layout.offsetY <= 0);
+            BOOST_TEST(layout.offsetY > -factor);
+            int right = layout.offsetX + layout.srcWidth * factor;
+            int bottom = layout.offsetY + layout.srcHeight * factor;
+            BOOST_TEST(right >= size);
+            BOOST_TEST(bottom >= size + 1);
+            if (layout.centerX + 1 < layout.srcWidth) {
+                BOOST_TEST(right - factor < size);
+            }
+            if (layout.centerY + 1 < layout.srcHeight) {
+                BOOST_TEST(bottom - factor < size + 1);
+            }
+
+            // The source is largest at the 1X zoom factor, so the magnifier can size its capture surface from
+            // the 1X layout.
+            MeaPixelZoom::Layout maxLayout = MeaPixelZoom::CenterLayout(size, size + 1, 1);
+            BOOST_TEST(layout.srcWidth <= maxLayout.srcWidth);
+            BOOST_TEST(layout.srcHeight <= maxLayout.srcHeight);
+            BOOST_TEST(maxLayout.srcWidth <= size + 1);
+        }
+    }
+
+    MeaPixelZoom::Layout layout = MeaPixelZoom::CenterLayout(200, 200, 6);
+    BOOST_TEST(layout.cellX == 97);
+    BOOST_TEST(layout.centerX == 17);
+    BOOST_TEST(layout.srcWidth == 35);
+    BOOST_TEST(layout.offsetX == -5);
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE ProfileValueMapTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/profile/ProfileValueMap.h>
+#include <map>
+
+
+BOOST_AUTO_TEST_CASE(TestEmpty) {
+    MeaProfileValueMap map;
+    BOOST_CHECK_EQUAL(0U, map.GetSize());
+
+    bool boolValue = true;
+    int intValue = 7;
+    double dblValue = 1.5;
+    CString strValue(_T("default"));
+    BOOST_CHECK(!map.GetBool(_T("Key"), boolValue));
+    BOOST_CHECK(!map.GetInt(_T("Key"), intValue));
+    BOOST_CHECK(!map.GetDbl(_T("Key"), dblValue));
+    BOOST_CHECK(!map.GetStr(_T("Key"), strValue));
+    BOOST_CHECK(boolValue);
+    BOOST_CHECK_EQUAL(7, intValue);
+    BOOST_CHECK_EQUAL(1.5, dblValue);
+    BOOST_CHECK(strValue == _T("default"));
+}
+
+BOOST_AUTO_TEST_CASE(TestTypedReads) {
+    MeaProfileValueMap map;
+    map.Set(_T("Bool1"), _T("TRUE"));
+    map.Set(_T("Bool2"), _T("yes"));
+    map.Set(_T("Bool3"), _T("1"));
+    map.Set(_T("Bool4"), _T("no"));
+    map.Set(_T("Int"), _T("-42"));
+    map.Set(_T("Dbl"), _T("3.25"));
+    map.Set(_T("Str"), _T("Hello"));
+    map.Set(_T("Empty"), _T(""));
+    BOOST_CHECK_EQUAL(8U, map.GetSize());
+
+    bool boolValue = false;
+    BOOST_CHECK(map.GetBool(_T("Bool1"), boolValue));
+    BOOST_CHECK(boolValue);
+    boolValue = false;
+    BOOST_CHECK(map.GetBool(_T("Bool2"), boolValue));
+    BOOST_CHECK(boolValue);
+    boolValue = false;
+    BOOST_CHECK(map.GetBool(_T("Bool3"), boolValue));
+    BOOST_CHECK(boolValue);
+    BOOST_CHECK(map.GetBool(_T("Bool4"), boolValue));
+    BOOST_CHECK(!boolValue);
+
+    int intValue = 0;
+    BOOST_CHECK(map.GetInt(_T("Int"), intValue));
+    BOOST_CHECK_EQUAL(-42, intValue);
+    BOOST_CHECK(map.GetInt(_T("Empty"), intValue));
+    BOOST_CHECK_EQUAL(0, intValue);
+
+    double dblValue = 0.0;
+    BOOST_CHECK(map.GetDbl(_T("Dbl"), dblValue));
+    BOOST_CHECK_EQUAL(3.25, dblValue);
+
+    CString strValue;
+    BOOST_CHECK(map.GetStr(_T("Str"), strValue));
+    BOOST_CHECK(strValue == _T("Hello"));
+    BOOST_CHECK(map.GetStr(_T("Empty"), strValue));
+    BOOST_CHECK(strValue.IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(TestRepeatedReads) {
+    MeaProfileValueMap map;
+    map.Set(_T("Value"), _T("12.75"));
+
+    // Reading the same key as different types must convert the original
+    // text each time rather than reusing the previous conversion.
+    for (int i = 0; i < 3; i++) {
+        int intValue = 0;
+        BOOST_CHECK(map.GetInt(_T("Value"), intValue));
+        BOOST_CHECK_EQUAL(12, intValue);
+        BOOST_CHECK(map.GetInt(_T("Value"), intValue));
+        BOOST_CHECK_EQUAL(12, intValue);
+
+        double dblValue = 0.0;
+        BOOST_CHECK(map.GetDbl(_T("Value"), dblValue));
+        BOOST_CHECK_EQUAL(12.75, dblValue);
+
+        bool boolValue = true;
+        BOOST_CHECK(map.GetBool(_T("Value"), boolValue));
+        BOOST_CHECK(!boolValue);
+
+        CString strValue;
+        BOOST_CHECK(map.GetStr(_T("Value"), strValue));
+        BOOST_CHECK(strValue == _T("12.75"));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestOverwrite) {
+    MeaProfileValueMap map;
+    map.Set(_T("Value"), _T("10"));
+
+    int intValue = 0;
+    BOOST_CHECK(map.GetInt(_T("Value"), intValue));
+    BOOST_CHECK_EQUAL(10, intValue);
+
+    map.Set(_T("Value"), _T("20"));
+    BOOST_CHECK_EQUAL(1U, map.GetSize());
+    BOOST_CHECK(map.GetInt(_T("Value"), intValue));
+    BOOST_CHECK_EQUAL(20, intValue);
+}
+
+BOOST_AUTO_TEST_CASE(TestCaseSensitive) {
+    MeaProfileValueMap map;
+    map.Set(_T("Value"), _T("1"));
+    map.Set(_T("value"), _T("2"));
+    BOOST_CHECK_EQUAL(2U, map.GetSize());
+
+    int intValue = 0;
+    BOOST_CHECK(map.GetInt(_T("Value"), intValue));
+    BOOST_CHECK_EQUAL(1, intValue);
+    BOOST_CHECK(map.GetInt(_T("value"), intValue));
+    BOOST_CHECK_EQUAL(2, intValue);
+    BOOST_CHECK(!map.GetInt(_T("VALUE"), intValue));
+    BOOST_CHECK(!map.GetInt(_T("Valu"), intValue));
+    BOOST_CHECK(!map.GetInt(_T("Values"), intValue));
+}
+
+BOOST_AUTO_TEST_CASE(TestGrowth) {
+    MeaProfileValueMap map;
+    std::map<CString, int> expected;
+
+    // Enough keys to grow the table several times, with names sharing long
+    // prefixes as profile keys do.
+    for (int i = 0; i < 2000; i++) {
+        CString key;
+        key.Format(_T("Position%dPoint%d"), i / 10, i % 10);
+        CString value;
+        value.Format(_T("%d"), i * 3);
+        map.Set(key, value);
+        expected[key] = i * 3;
+    }
+    BOOST_CHECK_EQUAL(expected.size(), map.GetSize());
+
+    for (const auto& item : expected) {
+        int intValue = -1;
+        BOOST_CHECK(map.GetInt(item.first, intValue));
+        BOOST_CHECK_EQUAL(item.second, intValue);
+    }
+
+    int intValue = -1;
+    BOOST_CHECK(!map.GetInt(_T("Position200Point0"), intValue));
+    BOOST_CHECK_EQUAL(-1, intValue);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE RulerTicksTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include "mocks/MockScreenProvider.h"
+#include "mocks/MockUnitsProvider.h"
+#include <meazure/graphics/RulerTicks.h>
+#include <meazure/units/Units.h>
+#include <algorithm>
+#include <vector>
+
+
+namespace {
+    /// Units provider that uses inches rather than pixels so that ticks do not land on integral pixels.
+    ///
+    class InchUnitsProvider : public MockUnitsProvider {
+
+    public:
+        explicit InchUnitsProvider(const MockScreenProvider& screenProvider) :
+            MockUnitsProvider(screenProvider),
+            m_inchUnits(screenProvider) {}
+
+        MeaLinearUnits* GetLinearUnits() const override { return const_cast<MeaInchUnits*>(&m_inchUnits); }
+
+        CString Format(MeaLinearMeasurementId id, double value) const override {
+            return m_inchUnits.Format(id, value);
+        }
+
+        using MockUnitsProvider::Format;
+
+    private:
+        MeaInchUnits m_inchUnits;
+    };
+
+
+    /// Lays out the ticks in the specified window the way the ruler did before the layout was cached: by walking
+    /// outward from the origin in both directions until the extent is exceeded.
+    ///
+    std::vector<MeaRulerTicks::Tick> ReferenceTicks(const MeaUnitsProvider& unitsProvider, MeaConvertDir dir,
+                                                    double minorIncr, int majorTickCount, int extentMin,
+                                                    int extentMax, int winMin, int winMax) {
+        const MeaLinearUnits* units = unitsProvider.GetLinearUnits();
+        std::vector<MeaRulerTicks::Tick> ticks;
+
+        for (int step = -1; step <= 1; step += 2) {
+            for (int index = (step < 0) ? -1 : 0; ; index += step) {
+                double p = index * minorIncr;
+                MeaRulerTicks::Tick tick;
+
+                tick.pos = static_cast<int>(units->UnconvertCoord(dir, nullptr, p));
+                if (tick.pos < extentMin || tick.pos >= extentMax) {
+                    break;
+                }
+                if (tick.pos >= winMin && tick.pos < winMax) {
+                    tick.exact = units->UnconvertCoord(dir, nullptr, p, tick.pos1, tick.pos2);
+                    tick.major = (index % majorTickCount) == 0;
+                    if (tick.major) {
+                        tick.label = unitsProvider.Format((dir == MeaConvertX) ? MeaX : MeaY, p);
+                    }
+                    ticks.push_back(tick);
+                }
+            }
+        }
+
+        return ticks;
+    }
+
+    void VerifyTicks(MeaRulerTicks& rulerTicks, const MeaUnitsProvider& unitsProvider, MeaConvertDir dir,
+                     double minorIncr, int majorTickCount, int extentMin, int extentMax, int winMin, int winMax) {
+        BOOST_TEST_CONTEXT("window [" << winMin << ", " << winMax << ")") {
+            rulerTicks.Update(dir, nullptr, minorIncr, majorTickCount, extentMin, extentMax);
+
+            MeaRulerTicks::TickIter first, last;
+            rulerTicks.GetTicks(winMin, winMax, first, last);
+
+            std::vector<MeaRulerTicks::Tick> expected = ReferenceTicks(unitsProvider, dir, minorIncr, majorTickCount,
+                                                                       extentMin, extentMax, winMin, winMax);
+            BOOST_TEST(static_cast<size_t>(last - first) == expected.size());
+
+            for (; first != last; ++first) {
+                const MeaRulerTicks::Tick& tick = *first;
+                auto iter = std::find_if(expected.begin(), expected.end(),
+                                         [&tick](const MeaRulerTicks::Tick& t) { return t.pos == tick.pos; });
+                BOOST_TEST_REQUIRE((iter != expected.end()));
+                BOOST_TEST(tick.pos1 == (*iter).pos1);
+                BOOST_TEST(tick.pos2 == (*iter).pos2);
+                BOOST_TEST(tick.exact == (*iter).exact);
+                BOOST_TEST(tick.major == (*iter).major);
+                BOOST_TEST(tick.label == (*iter).label);
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestPixelTicks) {
+    MockScreenProvider screenProvider;
+    MockUnitsProvider unitsProvider(screenProvider);
+    MeaRulerTicks rulerTicks(unitsProvider);
+
+    // Slide the window across the screen and back again, past both edges.
+    for (int winMin = -200; winMin < 1400; winMin += 37) {
+        VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 2.0, 10, 0, 1280, winMin, winMin + 300);
+    }
+    for (int winMin = 1400; winMin > -200; winMin -= 53) {
+        VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 2.0, 10, 0, 1280, winMin, winMin + 300);
+    }
+
+    // Jump around the screen.
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 2.0, 10, 0, 1280, 1000, 1200);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 2.0, 10, 0, 1280, 10, 100);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 2.0, 10, 0, 1280, 0, 1280);
+
+    // Moving the origin shifts every tick.
+    MeaLinearUnits::SetOrigin(POINT { 505, 0 });
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 2.0, 10, 0, 1280, 0, 1280);
+    MeaLinearUnits::SetOrigin(POINT { 0, 0 });
+}
+
+BOOST_AUTO_TEST_CASE(TestInexactTicks) {
+    MockScreenProvider screenProvider;
+    InchUnitsProvider unitsProvider(screenProvider);
+    MeaRulerTicks rulerTicks(unitsProvider);
+
+    for (int winMin = 0; winMin < 1024; winMin += 41) {
+        VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.05, 10, 0, 1024, winMin, winMin + 256);
+    }
+
+    bool haveInexact = false;
+    MeaRulerTicks::TickIter first, last;
+    rulerTicks.GetTicks(0, 1024, first, last);
+    for (; first != last; ++first) {
+        haveInexact = haveInexact || !(*first).exact;
+    }
+    BOOST_TEST(haveInexact);
+}
+
+BOOST_AUTO_TEST_CASE(TestLayoutChanges) {
+    MockScreenProvider screenProvider;
+    InchUnitsProvider unitsProvider(screenProvider);
+    MeaLinearUnits* units = unitsProvider.GetLinearUnits();
+    MeaRulerTicks rulerTicks(unitsProvider);
+
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.1, 10, 0, 1024, 100, 600);
+
+    // Moving the origin and inverting the y-axis must invalidate the layout.
+    units->SetOrigin(POINT { 300, 500 });
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.1, 10, 0, 1024, 100, 600);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertX, 0.1, 10, 0, 1280, 100, 600);
+    units->SetInvertY(true);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.1, 10, 0, 1024, 100, 600);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.1, 10, 0, 1024, 400, 900);
+
+    // Changing the precision must relabel the ticks.
+    MeaUnits::DisplayPrecisions precisions = units->GetDisplayPrecisions();
+    precisions[MeaY] += 2;
+    units->SetDisplayPrecisions(precisions);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.1, 10, 0, 1024, 400, 900);
+    units->RestoreDefaultPrecisions();
+
+    // Changing the tick spacing, major tick count or extent must lay out the ticks again.
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.25, 10, 0, 1024, 400, 900);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.25, 4, 0, 1024, 400, 900);
+    VerifyTicks(rulerTicks, unitsProvider, MeaConvertY, 0.25, 4, 450, 800, 400, 900);
+
+    units->SetInvertY(false);
+    units->SetOrigin(POINT { 0, 0 });
+}
+
+BOOST_AUTO_TEST_CASE(TestEmptyWindow) {
+    MockScreenProvider screenProvider;
+    MockUnitsProvider unitsProvider(screenProvider);
+    MeaRulerTicks rulerTicks(unitsProvider);
+    MeaRulerTicks::TickIter first, last;
+
+    rulerTicks.Update(MeaConvertX, nullptr, 2.0, 10, 0, 1280);
+    rulerTicks.GetTicks(-300, -10, first, last);
+    BOOST_TEST((first == last));
+    rulerTicks.GetTicks(1280, 1500, first, last);
+    BOOST_TEST((first == last));
+    rulerTicks.GetTicks(500, 500, first, last);
+    BOOST_TEST((first == last));
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE TimerServiceTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/TimerService.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+
+namespace {
+    /// Records the expirations of a set of timers.
+    ///
+    class Recorder {
+
+    public:
+        void Record(int id) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_fired.push_back(id);
+            m_times.push_back(steady_clock::now());
+            m_changed.notify_all();
+        }
+
+        bool WaitFor(size_t count, milliseconds timeout) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_changed.wait_for(lock, timeout, [this, count] { return m_fired.size() >= count; });
+        }
+
+        std::vector<int> GetFired() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_fired;
+        }
+
+        std::vector<steady_clock::time_point> GetTimes() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_times;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        std::vector<int> m_fired;
+        std::vector<steady_clock::time_point> m_times;
+    };
+
+    /// Sentinel timer identifier. Timers run in deadline order, so a
+    /// sentinel due after the timers under test shows that they will not
+    /// fire (again) without the test having to sleep.
+    ///
+    constexpr int kSentinel = 0;
+}
+
+
+BOOST_AUTO_TEST_CASE(TestExpire) {
+    MeaTimerService service;
+    Recorder recorder;
+    MeaTimerService::Timer timer([&recorder] { recorder.Record(1); });
+
+    steady_clock::time_point start = steady_clock::now();
+    BOOST_TEST(service.Start(timer, 30));
+    BOOST_TEST(recorder.WaitFor(1, seconds(10)));
+    BOOST_TEST(duration_cast<milliseconds>(recorder.GetTimes()[0] - start).count() >= 30);
+
+    // Zero delay expires promptly.
+    BOOST_TEST(service.Start(timer, 0));
+    BOOST_TEST(recorder.WaitFor(2, seconds(10)));
+    BOOST_TEST(recorder.GetFired().size() == 2);
+
+    service.Stop(timer);
+}
+
+BOOST_AUTO_TEST_CASE(TestStartWhilePending) {
+    MeaTimerService service;
+    Recorder recorder;
+    MeaTimerService::Timer timer([&recorder] { recorder.Record(1); });
+    MeaTimerService::Timer sentinel([&recorder] { recorder.Record(kSentinel); });
+
+    BOOST_TEST(service.Start(timer, 20));
+    BOOST_TEST(!service.Start(timer, 20));
+    BOOST_TEST(!service.Start(timer, 0));
+    BOOST_TEST(service.Start(sentinel, 100));
+
+    BOOST_TEST(recorder.WaitFor(2, seconds(10)));
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { 1, kSentinel }));
+
+    service.Stop(timer);
+    service.Stop(sentinel);
+}
+
+BOOST_AUTO_TEST_CASE(TestStop) {
+    MeaTimerService service;
+    Recorder recorder;
+    MeaTimerService::Timer timer1([&recorder] { recorder.Record(1); });
+    MeaTimerService::Timer timer2([&recorder] { recorder.Record(2); });
+    MeaTimerService::Timer sentinel([&recorder] { recorder.Record(kSentinel); });
+
+    service.Start(timer1, 30);
+    service.Start(timer2, 40);
+    service.Stop(timer1);
+    service.Stop(timer1);
+    service.Start(sentinel, 100);
+
+    BOOST_TEST(recorder.WaitFor(2, seconds(10)));
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { 2, kSentinel }));
+
+    // A stopped timer can be started again.
+    BOOST_TEST(service.Start(timer1, 0));
+    BOOST_TEST(recorder.WaitFor(3, seconds(10)));
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { 2, kSentinel, 1 }));
+
+    service.Stop(timer1);
+    service.Stop(timer2);
+    service.Stop(sentinel);
+}
+
+BOOST_AUTO_TEST_CASE(TestRestart) {
+    MeaTimerService service;
+    Recorder recorder;
+    MeaTimerService::Timer timer([&recorder] { recorder.Record(1); });
+    MeaTimerService::Timer sentinel([&recorder] { recorder.Record(kSentinel); });
+
+    // Restarting a pending timer can shorten its interval...
+    service.Start(timer, 5000);
+    service.Restart(timer, 10);
+    service.Start(sentinel, 1000);
+    BOOST_TEST(recorder.WaitFor(2, seconds(10)));
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { 1, kSentinel }));
+
+    // ...or lengthen it.
+    service.Start(timer, 10);
+    service.Restart(timer, 1000);
+    service.Start(sentinel, 50);
+    BOOST_TEST(recorder.WaitFor(4, seconds(10)));
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { 1, kSentinel, kSentinel, 1 }));
+
+    // A timer that is not pending is simply started.
+    service.Restart(timer, 0);
+    BOOST_TEST(recorder.WaitFor(5, seconds(10)));
+    BOOST_TEST(recorder.GetFired().size() == 5);
+
+    service.Stop(timer);
+    service.Stop(sentinel);
+}
+
+BOOST_AUTO_TEST_CASE(TestOrder) {
+    MeaTimerService service;
+    Recorder recorder;
+    std::vector<std::unique_ptr<MeaTimerService::Timer>> timers;
+
+    // Include intervals longer than the wheel so that timers share slots
+    // with ones due on an earlier turn.
+    const int delays[] = { 600, 20, 340, 80, 276, 150, 40, 532 };
+    std::vector<int> expected;
+    for (int delay : delays) {
+        timers.push_back(std::make_unique<MeaTimerService::Timer>([&recorder, delay] { recorder.Record(delay); }));
+        expected.push_back(delay);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    steady_clock::time_point start = steady_clock::now();
+    for (size_t i = 0; i < timers.size(); i++) {
+        service.Start(*timers[i], delays[i]);
+    }
+
+    BOOST_TEST(recorder.WaitFor(timers.size(), seconds(10)));
+    BOOST_TEST(recorder.GetFired() == expected);
+
+    std::vector<steady_clock::time_point> times = recorder.GetTimes();
+    for (size_t i = 0; i < times.size(); i++) {
+        BOOST_TEST(duration_cast<milliseconds>(times[i] - start).count() >= expected[i]);
+    }
+
+    for (auto& timer : timers) {
+        service.Stop(*timer);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRestartFromCallback) {
+    MeaTimerService service;
+    Recorder recorder;
+    std::atomic<int> count { 0 };
+    MeaTimerService::Timer* timerPtr = nullptr;
+    MeaTimerService::Timer timer([&] {
+        recorder.Record(++count);
+        if (count < 5) {
+            service.Start(*timerPtr, 5);
+        }
+    });
+    timerPtr = &timer;
+
+    MeaTimerService::Timer sentinel([&recorder] { recorder.Record(kSentinel); });
+
+    service.Start(timer, 5);
+    BOOST_TEST(recorder.WaitFor(5, seconds(10)));
+    service.Start(sentinel, 50);
+    BOOST_TEST(recorder.WaitFor(6, seconds(10)));
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { 1, 2, 3, 4, 5, kSentinel }));
+
+    service.Stop(timer);
+    service.Stop(sentinel);
+}
+
+BOOST_AUTO_TEST_CASE(TestStopWaitsForCallback) {
+    MeaTimerService service;
+    std::atomic<bool> inCallback { false };
+    std::atomic<bool> callbackDone { false };
+    MeaTimerService::Timer timer([&] {
+        inCallback = true;
+        std::this_thread::sleep_for(milliseconds(50));
+        callbackDone = true;
+    });
+
+    service.Start(timer, 0);
+    while (!inCallback) {
+        std::this_thread::yield();
+    }
+    service.Stop(timer);
+    BOOST_TEST(callbackDone);
+}
+
+BOOST_AUTO_TEST_CASE(TestShutdown) {
+    MeaTimerService service;
+    Recorder recorder;
+    MeaTimerService::Timer timer([&recorder] { recorder.Record(1); });
+    MeaTimerService::Timer sentinel([&recorder] { recorder.Record(kSentinel); });
+
+    BOOST_TEST(service.Start(sentinel, 0));
+    BOOST_TEST(recorder.WaitFor(1, seconds(10)));
+    BOOST_TEST(service.Start(timer, 60000));
+
+    // Pending timers are discarded and no new timers are started.
+    service.Shutdown();
+    BOOST_TEST(!service.Start(sentinel, 0));
+    service.Restart(sentinel, 0);
+    BOOST_TEST(!service.Start(timer, 0));
+
+    // Stopping a discarded timer returns immediately.
+    service.Stop(timer);
+    service.Stop(sentinel);
+    service.Shutdown();
+    BOOST_TEST((recorder.GetFired() == std::vector<int> { kSentinel }));
+}
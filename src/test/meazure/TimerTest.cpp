@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE TimerTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/utilities/Timer.h>
+#include <memory>
+
+
+BOOST_AUTO_TEST_CASE(TestDestroyAfterShutdown) {
+    CWnd parent;
+
+    // Timers owned by static objects are destroyed after the application
+    // has shut down the timer service, possibly while still pending.
+    auto pending = std::make_unique<MeaTimer>();
+    auto stopped = std::make_unique<MeaTimer>();
+    pending->Create(&parent);
+    stopped->Create(&parent);
+    pending->Start(60000);
+    stopped->Start(60000);
+    stopped->Stop();
+
+    MeaTimer::Shutdown();
+
+    // Starting a timer after shutdown has no effect.
+    stopped->Start(0);
+    stopped->Stop();
+
+    pending.reset();
+    stopped.reset();
+    MeaTimer::Shutdown();
+}
@@ -470,3 +470,207 @@ BOOST_AUTO_TEST_CASE(TestCustomUnits, *bt::tolerance(0.0001)) {
     VerifyToPixels(units, 50, 20, 10000, 3600);
     VerifyFromPixels(units, 0.0050000000000000001, 0.0055555555555555558);
 }
+
+
+//=========================================================================
+
+
+// Exposes the screen resolution lookups for testing.
+//
+class ScreenLookupUnits : public MeaInchUnits {
+
+public:
+    explicit ScreenLookupUnits(const MeaScreenProvider& screenProvider) : MeaInchUnits(screenProvider) {}
+
+    using MeaLinearUnits::FindResFromCoord;
+    using MeaLinearUnits::FindResFromPos;
+};
+
+// Creates the specified number of screens arranged in rows of four. Each screen has a different size and
+// resolution so that screen boundaries do not line up and each resolution identifies its screen.
+//
+std::vector<MockScreenProvider::ScreenInfo> CreateScreens(int numScreens) {
+    std::vector<MockScreenProvider::ScreenInfo> screens;
+
+    for (int i = 0; i < numScreens; i++) {
+        int col = i % 4;
+        int row = i / 4;
+        int left = col * 1920 - 1920;
+        int top = row * 1200 - 600 + col * 37;
+        screens.push_back({ CRect(left, top, left + 1600 + 40 * i, top + 1000 + 20 * i),
+                            MeaFSize(96.0 + 12.0 * i, 90.0 + 10.0 * i) });
+    }
+
+    return screens;
+}
+
+// Finds the screen resolution by testing every screen in turn, which is how the lookup was originally
+// performed.
+//
+const MeaFSize& LinearFindRes(const MeaLinearUnits& units, const MeaScreenProvider& screenProvider,
+                              const MeaFPoint& pos, bool coord) {
+    if (screenProvider.GetNumScreens() != 1) {
+        for (auto iter = screenProvider.GetScreenIter(); !screenProvider.AtEnd(iter); ++iter) {
+            const CRect& srect = screenProvider.GetScreenRect(iter);
+            MeaFPoint tl = coord ? units.ConvertCoord(srect.TopLeft()) : units.ConvertPos(srect.TopLeft());
+            MeaFPoint br = coord ? units.ConvertCoord(srect.BottomRight()) : units.ConvertPos(srect.BottomRight());
+
+            if ((tl.x <= pos.x) && (br.x > pos.x) && (tl.y <= pos.y) && (br.y > pos.y)) {
+                return screenProvider.GetScreenRes(iter);
+            }
+        }
+    }
+
+    return screenProvider.GetScreenRes(screenProvider.GetScreenIter());
+}
+
+void VerifyFindRes(const ScreenLookupUnits& units, const MeaScreenProvider& screenProvider) {
+    std::vector<double> xs;
+    std::vector<double> ys;
+
+    for (auto iter = screenProvider.GetScreenIter(); !screenProvider.AtEnd(iter); ++iter) {
+        const CRect& srect = screenProvider.GetScreenRect(iter);
+        for (const POINT& pt : { srect.TopLeft(), srect.BottomRight(), srect.CenterPoint() }) {
+            MeaFPoint coord = units.ConvertCoord(pt);
+            MeaFPoint pos = units.ConvertPos(pt);
+            xs.insert(xs.end(), { coord.x, coord.x - 0.001, coord.x + 0.001, pos.x, pos.x - 0.001, pos.x + 0.001 });
+            ys.insert(ys.end(), { coord.y, coord.y - 0.001, coord.y + 0.001, pos.y, pos.y - 0.001, pos.y + 0.001 });
+        }
+    }
+    xs.push_back(-1.0e6);
+    xs.push_back(1.0e6);
+    ys.push_back(-1.0e6);
+    ys.push_back(1.0e6);
+
+    for (double x : xs) {
+        for (double y : ys) {
+            MeaFPoint pos(x, y);
+            BOOST_TEST(&units.FindResFromCoord(pos) == &LinearFindRes(units, screenProvider, pos, true));
+            BOOST_TEST(&units.FindResFromPos(pos) == &LinearFindRes(units, screenProvider, pos, false));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFindResMultipleScreens) {
+    for (int numScreens = 1; numScreens <= 16; numScreens++) {
+        BOOST_TEST_CONTEXT("Number of screens: " << numScreens) {
+            MockScreenProvider screenProvider(CreateScreens(numScreens));
+            ScreenLookupUnits units(screenProvider);
+
+            BOOST_TEST(screenProvider.GetNumScreens() == numScreens);
+
+            VerifyFindRes(units, screenProvider);
+
+            // Changing the coordinate system must be reflected in subsequent lookups.
+            units.SetOrigin(POINT { 250, -300 });
+            VerifyFindRes(units, screenProvider);
+
+            units.SetInvertY(true);
+            VerifyFindRes(units, screenProvider);
+
+            units.SetOrigin(POINT { 0, 0 });
+            VerifyFindRes(units, screenProvider);
+
+            units.SetInvertY(false);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestFindResScaleChange) {
+    MockScreenProvider screenProvider(CreateScreens(3));
+    MeaCustomUnits units(screenProvider, &MockScreenProvider::ChangeLabel);
+    units.SetScaleBasis(MeaCustomUnits::InchBasis);
+
+    const CRect& srect = screenProvider.GetScreenRect(std::next(screenProvider.GetScreenIter()));
+    POINT pt = srect.CenterPoint();
+
+    BOOST_TEST(units.UnconvertPos(units.ConvertPos(pt)) == pt);
+
+    // The screen lookup must use the new scale factor once it has been changed.
+    units.SetScaleFactor(4.0);
+    BOOST_TEST(units.UnconvertPos(units.ConvertPos(pt)) == pt);
+}
+
+BOOST_AUTO_TEST_CASE(TestConvertCoordMultipleScreens, *bt::tolerance(0.0001)) {
+    MockScreenProvider screenProvider(CreateScreens(4));
+    MeaInchUnits units(screenProvider);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (auto iter = screenProvider.GetScreenIter(); !screenProvider.AtEnd(iter); ++iter) {
+            const MeaFSize& res = screenProvider.GetScreenRes(iter);
+            POINT pt = screenProvider.GetScreenRect(iter).CenterPoint();
+
+            MeaFPoint coord = units.ConvertCoord(pt);
+            BOOST_TEST(coord.x == pt.x / res.cx);
+            BOOST_TEST(coord.y == pt.y / res.cy);
+
+            // Conversions must reflect an inverted y-axis as soon as it is set.
+            units.SetInvertY(true);
+            coord = units.ConvertCoord(pt);
+            BOOST_TEST(coord.x == pt.x / res.cx);
+            BOOST_TEST(coord.y == (screenProvider.GetVirtualRect().Height() - 1 - pt.y) / res.cy);
+
+            units.SetOrigin(POINT { 10, 20 });
+            coord = units.ConvertCoord(pt);
+            BOOST_TEST(coord.x == (pt.x - 10) / res.cx);
+            BOOST_TEST(coord.y == (20 - pt.y) / res.cy);
+
+            units.SetOrigin(POINT { 0, 0 });
+            units.SetInvertY(false);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestBatchConversions) {
+    MockScreenProvider screenProvider(CreateScreens(8));
+    MeaInchUnits inchUnits(screenProvider);
+    MeaPixelUnits pixelUnits(screenProvider);
+    MeaLinearUnits* unitsList[] = { &inchUnits, &pixelUnits };
+
+    // Walk a diagonal across all screens so that runs start and end on screen boundaries.
+    const CRect& virtualRect = screenProvider.GetVirtualRect();
+    std::vector<POINT> points;
+    for (int i = 0; i < 257; i++) {
+        points.push_back(POINT { virtualRect.left + (virtualRect.Width() - 1) * i / 256,
+                                 virtualRect.top + (virtualRect.Height() - 1) * ((i * 7) % 257) / 256 });
+    }
+    std::vector<MeaFPoint> converted(points.size());
+    std::vector<POINT> unconverted(points.size());
+
+    for (MeaLinearUnits* units : unitsList) {
+        for (int variant = 0; variant < 4; variant++) {
+            units->SetInvertY((variant & 1) != 0);
+            units->SetOrigin((variant & 2) ? POINT { 150, 75 } : POINT { 0, 0 });
+
+            BOOST_TEST_CONTEXT("units " << units->GetUnitsId() << ", variant " << variant) {
+                units->ConvertCoords(points.data(), converted.data(), points.size());
+                units->UnconvertCoords(converted.data(), unconverted.data(), converted.size());
+                for (size_t i = 0; i < points.size(); i++) {
+                    MeaFPoint expected = units->ConvertCoord(points[i]);
+                    BOOST_TEST(converted[i].x == expected.x);
+                    BOOST_TEST(converted[i].y == expected.y);
+                    POINT expectedPt = units->UnconvertCoord(expected);
+                    BOOST_TEST(unconverted[i].x == expectedPt.x);
+                    BOOST_TEST(unconverted[i].y == expectedPt.y);
+                }
+
+                units->ConvertPositions(points.data(), converted.data(), points.size());
+                units->UnconvertPositions(converted.data(), unconverted.data(), converted.size());
+                for (size_t i = 0; i < points.size(); i++) {
+                    MeaFPoint expected = units->ConvertPos(points[i]);
+                    BOOST_TEST(converted[i].x == expected.x);
+                    BOOST_TEST(converted[i].y == expected.y);
+                    POINT expectedPt = units->UnconvertPos(expected);
+                    BOOST_TEST(unconverted[i].x == expectedPt.x);
+                    BOOST_TEST(unconverted[i].y == expectedPt.y);
+                }
+            }
+        }
+        units->SetInvertY(false);
+        units->SetOrigin(POINT { 0, 0 });
+    }
+
+    // An empty batch must not touch the output.
+    inchUnits.ConvertCoords(points.data(), nullptr, 0);
+    inchUnits.UnconvertPositions(converted.data(), nullptr, 0);
+}
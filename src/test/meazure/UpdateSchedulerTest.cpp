@@ -0,0 +1,186 @@
+/*
+ * Copyright 2024 C Thing Software
+ *
+ * This file is part of Meazure.
+ *
+ * Meazure is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Meazure is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with Meazure.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+#define BOOST_TEST_MODULE UpdateSchedulerTest
+#include "GlobalFixture.h"
+#include <boost/test/unit_test.hpp>
+#include <meazure/ui/UpdateScheduler.h>
+#include <vector>
+
+using namespace std::chrono;
+
+typedef MeaUpdateScheduler::Clock Clock;
+
+
+namespace {
+    /// Frame dispatched by the simulated message loop.
+    ///
+    struct Frame {
+        Clock::time_point time;     ///< Time at which the frame was dispatched.
+        LPARAM lParam;              ///< Event dispatched in the frame.
+    };
+
+    /// Feeds a stream of events to the scheduler the way the view does, simulating the frame timer.
+    /// Each event's lParam is its index in the stream.
+    ///
+    /// @param scheduler    [in] Scheduler under test.
+    /// @param start        [in] Time of the first event.
+    /// @param eventTimes   [in] Offset of each event from the start.
+    /// @param frameCost    [in] Time taken to process each frame.
+    ///
+    /// @return Frames dispatched.
+    ///
+    std::vector<Frame> Simulate(MeaUpdateScheduler& scheduler, Clock::time_point start,
+                                const std::vector<Clock::duration>& eventTimes, Clock::duration frameCost) {
+        std::vector<Frame> frames;
+        bool timerArmed = false;
+        Clock::time_point timerDeadline;
+
+        auto dispatch = [&](Clock::time_point now) {
+            WPARAM wParam;
+            LPARAM lParam;
+            if (scheduler.BeginFrame(now, wParam, lParam)) {
+                frames.push_back(Frame { now, lParam });
+                scheduler.EndFrame(now + frameCost);
+            }
+        };
+
+        for (size_t i = 0; i <= eventTimes.size(); i++) {
+            // Fire the frame timer if it expires before the next event.
+            Clock::time_point eventTime = (i < eventTimes.size()) ? start + eventTimes[i] : Clock::time_point::max();
+            if (timerArmed && timerDeadline <= eventTime) {
+                timerArmed = false;
+                dispatch(timerDeadline);
+            }
+            if (i == eventTimes.size()) {
+                break;
+            }
+
+            switch (scheduler.AddEvent(0, static_cast<LPARAM>(i), eventTime)) {
+            case MeaUpdateScheduler::DispatchNow:
+                dispatch(eventTime);
+                break;
+            case MeaUpdateScheduler::ScheduleFrame:
+                BOOST_TEST(!timerArmed);
+                timerArmed = true;
+                timerDeadline = eventTime + scheduler.GetFrameDelay(eventTime);
+                break;
+            case MeaUpdateScheduler::Coalesced:
+                BOOST_TEST(scheduler.HasPending());
+                break;
+            }
+        }
+
+        BOOST_TEST(!scheduler.HasPending());
+        return frames;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(TestHighRateStream) {
+    MeaUpdateScheduler scheduler(microseconds(16667));
+    Clock::time_point start = Clock::now();
+
+    // One second of 1000Hz mouse events.
+    std::vector<Clock::duration> eventTimes;
+    for (int i = 0; i < 1000; i++) {
+        eventTimes.push_back(milliseconds(i));
+    }
+
+    std::vector<Frame> frames = Simulate(scheduler, start, eventTimes, microseconds(500));
+
+    BOOST_TEST(frames.size() >= 59U);
+    BOOST_TEST(frames.size() <= 61U);
+
+    // Frames are never closer together than the frame interval and each one carries the latest event.
+    for (size_t i = 1; i < frames.size(); i++) {
+        BOOST_TEST((frames[i].time - frames[i - 1].time >= microseconds(16667)));
+        BOOST_TEST(frames[i].lParam > frames[i - 1].lParam);
+    }
+    BOOST_TEST(frames.back().lParam == 999);
+
+    const MeaUpdateScheduler::Stats& stats = scheduler.GetStats();
+    BOOST_TEST(stats.eventsReceived == 1000U);
+    BOOST_TEST(stats.frames == frames.size());
+    BOOST_TEST(stats.eventsCoalesced == stats.eventsReceived - stats.frames);
+    BOOST_TEST((stats.lastFrameTime == microseconds(500)));
+    BOOST_TEST((stats.maxFrameTime == microseconds(500)));
+    BOOST_TEST((stats.totalFrameTime == frames.size() * microseconds(500)));
+}
+
+BOOST_AUTO_TEST_CASE(TestLowRateStream) {
+    MeaUpdateScheduler scheduler(milliseconds(16));
+    Clock::time_point start = Clock::now();
+
+    // Events slower than the frame rate are dispatched immediately without coalescing.
+    std::vector<Clock::duration> eventTimes;
+    for (int i = 0; i < 20; i++) {
+        eventTimes.push_back(milliseconds(i * 40));
+    }
+
+    std::vector<Frame> frames = Simulate(scheduler, start, eventTimes, milliseconds(1));
+
+    BOOST_TEST(frames.size() == 20U);
+    for (size_t i = 0; i < frames.size(); i++) {
+        BOOST_TEST((frames[i].time == start + eventTimes[i]));
+        BOOST_TEST(frames[i].lParam == static_cast<LPARAM>(i));
+    }
+    BOOST_TEST(scheduler.GetStats().eventsCoalesced == 0U);
+}
+
+BOOST_AUTO_TEST_CASE(TestBurst) {
+    MeaUpdateScheduler scheduler(milliseconds(16));
+    Clock::time_point start = Clock::now();
+
+    // The first event of a burst is dispatched immediately, the rest are collapsed into one frame.
+    std::vector<Clock::duration> eventTimes { milliseconds(0), milliseconds(1), milliseconds(2), milliseconds(3),
+                                              milliseconds(100) };
+
+    std::vector<Frame> frames = Simulate(scheduler, start, eventTimes, milliseconds(0));
+
+    BOOST_TEST(frames.size() == 3U);
+    BOOST_TEST((frames[0].time == start));
+    BOOST_TEST(frames[0].lParam == 0);
+    BOOST_TEST((frames[1].time == start + milliseconds(16)));
+    BOOST_TEST(frames[1].lParam == 3);
+    BOOST_TEST((frames[2].time == start + milliseconds(100)));
+    BOOST_TEST(frames[2].lParam == 4);
+    BOOST_TEST(scheduler.GetStats().eventsCoalesced == 2U);
+}
+
+BOOST_AUTO_TEST_CASE(TestClear) {
+    MeaUpdateScheduler scheduler(milliseconds(16));
+    Clock::time_point now = Clock::now();
+    WPARAM wParam;
+    LPARAM lParam;
+
+    BOOST_TEST(scheduler.AddEvent(0, 1, now) == MeaUpdateScheduler::DispatchNow);
+    BOOST_TEST(scheduler.BeginFrame(now, wParam, lParam));
+    scheduler.EndFrame(now);
+
+    BOOST_TEST(scheduler.AddEvent(0, 2, now + milliseconds(1)) == MeaUpdateScheduler::ScheduleFrame);
+    scheduler.Clear();
+    BOOST_TEST(!scheduler.HasPending());
+    BOOST_TEST(!scheduler.BeginFrame(now + milliseconds(16), wParam, lParam));
+
+    scheduler.ResetStats();
+    BOOST_TEST(scheduler.GetStats().eventsReceived == 0U);
+    BOOST_TEST(scheduler.GetStats().frames == 0U);
+}
@@ -51,6 +51,16 @@ public:
         return m_getString(section, entry, defaultValue);
     }
 
+    BOOL GetValues(PCTSTR section, MeaRegistryValues& values) override {
+        m_getValuesCount++;
+        return m_getValues(section, values);
+    }
+
+    BOOL WriteValues(PCTSTR section, const MeaRegistryValues& values) override {
+        m_writeValuesCount++;
+        return m_writeValues(section, values);
+    }
+
     PCTSTR GetKeyName() override {
         return _T("cthing");
     }
@@ -70,6 +80,8 @@ public:
         m_writeStringCount = 0;
         m_getIntCount = 0;
         m_getStringCount = 0;
+        m_getValuesCount = 0;
+        m_writeValuesCount = 0;
         m_openKeyCount = 0;
         m_closeKeyCount = 0;
 
@@ -89,6 +101,14 @@ public:
             BOOST_FAIL("GetString callback not provided");
             return _T("");
         };
+        m_getValues = [](PCTSTR, MeaRegistryValues&) {
+            BOOST_FAIL("GetValues callback not provided");
+            return TRUE;
+        };
+        m_writeValues = [](PCTSTR, const MeaRegistryValues&) {
+            BOOST_FAIL("WriteValues callback not provided");
+            return TRUE;
+        };
         m_openKey = [](HKEY, PCTSTR, DWORD, REGSAM, PHKEY) {
             BOOST_FAIL("OpenKey callback not provided");
             return ERROR_SUCCESS;
@@ -110,6 +130,12 @@ public:
         m_getStringNoop = [](PCTSTR, PCTSTR, PCTSTR) {
             return _T("");
         };
+        m_getValuesNoop = [](PCTSTR, MeaRegistryValues&) {
+            return FALSE;
+        };
+        m_writeValuesNoop = [](PCTSTR, const MeaRegistryValues&) {
+            return TRUE;
+        };
         m_openKeyNoop = [](HKEY, PCTSTR, DWORD, REGSAM, PHKEY) {
             return ERROR_SUCCESS;
         };
@@ -123,6 +149,8 @@ public:
     int m_writeStringCount;
     int m_getIntCount;
     int m_getStringCount;
+    int m_getValuesCount;
+    int m_writeValuesCount;
     int m_openKeyCount;
     int m_closeKeyCount;
 
@@ -130,6 +158,8 @@ public:
     std::function<BOOL(PCTSTR, PCTSTR, PCTSTR)> m_writeString;
     std::function<UINT(PCTSTR, PCTSTR, int)> m_getInt;
     std::function<CString(PCTSTR, PCTSTR, PCTSTR)> m_getString;
+    std::function<BOOL(PCTSTR, MeaRegistryValues&)> m_getValues;
+    std::function<BOOL(PCTSTR, const MeaRegistryValues&)> m_writeValues;
     std::function<LSTATUS(HKEY, PCTSTR, DWORD, REGSAM, PHKEY)> m_openKey;
     std::function<LSTATUS(HKEY)> m_closeKey;
 
@@ -137,6 +167,8 @@ public:
     std::function<BOOL(PCTSTR, PCTSTR, PCTSTR)> m_writeStringNoop;
     std::function<UINT(PCTSTR, PCTSTR, int)> m_getIntNoop;
     std::function<CString(PCTSTR, PCTSTR, PCTSTR)> m_getStringNoop;
+    std::function<BOOL(PCTSTR, MeaRegistryValues&)> m_getValuesNoop;
+    std::function<BOOL(PCTSTR, const MeaRegistryValues&)> m_writeValuesNoop;
     std::function<LSTATUS(HKEY, PCTSTR, DWORD, REGSAM, PHKEY)> m_openKeyNoop;
     std::function<LSTATUS(HKEY)> m_closeKeyNoop;
 };
@@ -19,24 +19,47 @@
 
 #include <meazure/ui/ScreenProvider.h>
 #include <meazure/units/Units.h>
+#include <vector>
 
-class MeaScreenProvider::Screen {};
+class MeaScreenProvider::Screen {
+
+public:
+    Screen(const CRect& rect, const MeaFSize& res) : m_rect(rect), m_res(res) {}
+
+    CRect m_rect;
+    MeaFSize m_res;
+};
 
 
 class MockScreenProvider : public MeaScreenProvider {
 
 public:
-    MockScreenProvider() : m_rect(0, 0, 1280, 1024) {
-        m_center = m_rect.CenterPoint();
-        m_res.cx = 96.0;
-        m_res.cy = 96.0;
+    struct ScreenInfo {
+        CRect rect;
+        MeaFSize res;
+    };
+
+    MockScreenProvider() : MockScreenProvider({ ScreenInfo { CRect(0, 0, 1280, 1024), MeaFSize(96.0, 96.0) } }) {}
+
+    MockScreenProvider(const std::vector<ScreenInfo>& screens) {
+        int monitor = 10;
+
+        for (const ScreenInfo& info : screens) {
+            m_screens[reinterpret_cast<HMONITOR>(static_cast<intptr_t>(monitor))] = new Screen(info.rect, info.res);
+            monitor += 10;
 
-        Screen* screen = new Screen();
-        m_screens[reinterpret_cast<HMONITOR>(10)] = screen;
+            if (m_rect.IsRectEmpty()) {
+                m_rect = info.rect;
+            } else {
+                m_rect.UnionRect(&m_rect, &info.rect);
+            }
+        }
+
+        m_center = m_rect.CenterPoint();
     }
 
     virtual int GetNumScreens() const override {
-        return 1;
+        return static_cast<int>(m_screens.size());
     }
 
     virtual ScreenIter GetScreenIter() const override {
@@ -47,12 +70,38 @@ public:
         return m_screens.begin();
     }
 
-    virtual ScreenIter GetScreenIter(const POINT&) const override {
-        return m_screens.begin();
+    virtual ScreenIter GetScreenIter(const POINT& point) const override {
+        ScreenIter nearest = m_screens.begin();
+        long nearestDist = LONG_MAX;
+
+        for (ScreenIter iter = m_screens.begin(); iter != m_screens.end(); ++iter) {
+            const CRect& rect = (*iter).second->m_rect;
+            long dx = 0;
+            long dy = 0;
+
+            if (point.x < rect.left) {
+                dx = rect.left - point.x;
+            } else if (point.x >= rect.right) {
+                dx = point.x - rect.right + 1;
+            }
+            if (point.y < rect.top) {
+                dy = rect.top - point.y;
+            } else if (point.y >= rect.bottom) {
+                dy = point.y - rect.bottom + 1;
+            }
+
+            long dist = dx * dx + dy * dy;
+            if (dist < nearestDist) {
+                nearest = iter;
+                nearestDist = dist;
+            }
+        }
+
+        return nearest;
     }
 
-    virtual ScreenIter GetScreenIter(const RECT&) const override {
-        return m_screens.begin();
+    virtual ScreenIter GetScreenIter(const RECT& rect) const override {
+        return GetScreenIter(CRect(rect).CenterPoint());
     }
 
     virtual bool AtEnd(const ScreenIter& iter) const override {
@@ -71,17 +120,17 @@ public:
         return m_rect;
     }
 
-    virtual const CRect& GetScreenRect(const ScreenIter&) const override {
-        return m_rect;
+    virtual const CRect& GetScreenRect(const ScreenIter& iter) const override {
+        return (*iter).second->m_rect;
     }
 
-    virtual void GetScreenRes(const ScreenIter&, bool& useManualRes, MeaFSize& manualRes) const override {
+    virtual void GetScreenRes(const ScreenIter& iter, bool& useManualRes, MeaFSize& manualRes) const override {
         useManualRes = false;
-        manualRes = m_res;
+        manualRes = (*iter).second->m_res;
     }
 
-    virtual const MeaFSize& GetScreenRes(const ScreenIter&) const override {
-        return m_res;
+    virtual const MeaFSize& GetScreenRes(const ScreenIter& iter) const override {
+        return (*iter).second->m_res;
     }
 
     virtual bool IsManualRes(const ScreenIter&) const override {
@@ -92,8 +141,8 @@ public:
         return true;
     }
 
-    virtual bool IsPrimary(const ScreenIter&) const override {
-        return true;
+    virtual bool IsPrimary(const ScreenIter& iter) const override {
+        return iter == m_screens.begin();
     }
 
     virtual CString GetScreenName(const ScreenIter&) const override {
@@ -132,5 +181,4 @@ private:
     Screens m_screens;
     CRect m_rect;
     CPoint m_center;
-    MeaFSize m_res;
 };
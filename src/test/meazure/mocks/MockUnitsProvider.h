@@ -98,6 +98,18 @@ public:
         return m_linearUnits->UnconvertPos(pos);
     }
 
+    void ConvertCoords(const POINT* coords, MeaFPoint* converted, size_t count) const override {
+        m_linearUnits->ConvertCoords(coords, converted, count);
+    }
+
+    void ConvertPositions(const POINT* positions, MeaFPoint* converted, size_t count) const override {
+        m_linearUnits->ConvertPositions(positions, converted, count);
+    }
+
+    void UnconvertPositions(const MeaFPoint* positions, POINT* converted, size_t count) const override {
+        m_linearUnits->UnconvertPositions(positions, converted, count);
+    }
+
     MeaFSize ConvertRes(const MeaFSize& res) const override {
         return m_linearUnits->ConvertRes(res);
     }